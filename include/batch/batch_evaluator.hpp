@@ -0,0 +1,139 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <unordered_map>
+#include "column.hpp"
+#include "column_loader.hpp"
+#include "../files.hpp"
+#include "../context.hpp"
+#include "../nodes/list_node.hpp"
+
+/// @brief The number of rows that each kernel processes at once.
+constexpr std::size_t BATCH_SIZE = 1024;
+
+/// @brief Holds the operations a batch evaluation is made of.
+/// Unlike the nodes, the operands of an operation always have the same type,
+/// so an integer mixed with a double gets converted first (TO_DOUBLE).
+namespace BatchOp {
+    // a namespace is necessary for the same reasons as NodeType.
+    enum Type {
+        ADD,
+        SUBSTRACT,
+        MULTIPLY,
+        DIVIDE,
+        MODULO,
+        POWER,
+        NEGATE,
+        POSITIVE,
+        TO_DOUBLE
+    };
+}
+
+/// @brief Where the rows of an operand are read from.
+namespace BatchSource {
+    enum Type {
+        COLUMN, // a column bound to a variable
+        CONSTANT, // a literal, broadcast once for the whole evaluation
+        TEMPORARY // the result of a previous step
+    };
+}
+
+/// @brief An operand of a batch operation.
+struct batch_operand_t {
+  Type type; // INT or DOUBLE
+  BatchSource::Type source;
+  unsigned int index; // the index of the column, of the constant or of the temporary
+};
+
+/// @brief An operation applied to a whole batch of rows.
+/// The result is stored in the temporary of the same index as the step.
+struct batch_step_t {
+  BatchOp::Type op;
+  Type type; // the type of the result
+  batch_operand_t left;
+  batch_operand_t right; // unused by the unary operations
+  const CustomNode* node; // for the positions of the errors
+};
+
+/// @brief The rows of a temporary result or of a broadcast constant.
+union alignas(64) batch_chunk_t {
+  std::int64_t integers[BATCH_SIZE];
+  double doubles[BATCH_SIZE];
+};
+
+/// @brief Evaluates a single arithmetic expression over whole columns of inputs.
+/// ```
+/// BatchEvaluator evaluator("price * quantity - 1");
+/// evaluator.bind("price", std::make_shared<Column>(Column::from_doubles({ 1.5, 2.0 })));
+/// evaluator.bind("quantity", std::make_shared<Column>(Column::from_integers({ 4, 3 })));
+/// Column result = evaluator.eval(); // 5, 5
+/// ```
+/// The tree is turned into a list of steps once per evaluation,
+/// then each step is executed as a tight loop over BATCH_SIZE rows at a time,
+/// instead of creating a Value for each row and each node.
+/// The semantics are the same as the Interpreter's (promotion of integers, division by zero, etc.),
+/// but only integers, doubles, variables and arithmetic operations can be evaluated this way.
+class BatchEvaluator final {
+  StoredSource source; // the source code, under a key of its own, for the errors
+  std::unique_ptr<ListNode> tree;
+  const CustomNode* expression;
+  std::unordered_map<std::string, std::shared_ptr<const Column>> bindings;
+  std::shared_ptr<Context> ctx;
+
+  // The plan of the current evaluation
+  batch_operand_t root{}; // holds the result of the expression
+  std::vector<batch_step_t> steps;
+  std::vector<const Column*> columns;
+  std::vector<batch_chunk_t> constants;
+  std::vector<batch_chunk_t> temporaries;
+
+  /// @brief Appends the steps that compute a node.
+  /// @return The operand holding the result of the node.
+  batch_operand_t plan(const CustomNode& node);
+
+  /// @brief Converts an operand to a double if needed.
+  batch_operand_t promote(const batch_operand_t& operand, const CustomNode& node);
+
+  /// @brief Appends a step to the plan.
+  batch_operand_t add_step(BatchOp::Type op, Type type, const batch_operand_t& left, const batch_operand_t& right, const CustomNode& node);
+
+  /// @brief Gets the rows of an operand, starting at the row `begin` of the columns.
+  template <typename T>
+  const T* read(const batch_operand_t& operand, std::size_t begin) const;
+
+  /// @brief Executes a step over `n` rows, starting at the row `begin` of the columns.
+  void execute(unsigned int index, std::size_t begin, std::size_t n);
+
+  public:
+    /// @brief Parses the expression to evaluate.
+    /// @param source A program made of a single expression.
+    /// @throw CustomError if the source code is invalid.
+    /// @throw Exception if the program isn't made of exactly one statement.
+    explicit BatchEvaluator(const std::string& source);
+
+    /// @brief Binds a column to a variable of the expression.
+    /// @param name The name of the variable.
+    /// @param column The values of the variable, one per row.
+    void bind(const std::string& name, std::shared_ptr<const Column> column);
+
+    /// @brief Binds all the columns of a table, each one to the variable of the same name.
+    void bind(const table_t& table);
+
+    /// @brief Evaluates the expression for each row of the bound columns.
+    /// An expression that doesn't refer to any variable is evaluated once.
+    /// @return The result of each row.
+    /// @throw Exception if the columns don't have the same number of rows.
+    /// @throw CustomError if the expression cannot be evaluated (undefined variable, unsupported operation, division by zero, integer overflow).
+    Column eval();
+
+    /// @brief Evaluates the expression for each row of the bound columns,
+    /// and gives the results to `consumer` as soon as a batch is computed,
+    /// so that the results of large inputs never have to be stored all at once.
+    /// @param consumer Receives the results of each batch (at most BATCH_SIZE rows), in order.
+    /// @throw Exception if the columns don't have the same number of rows.
+    /// @throw CustomError if the expression cannot be evaluated (undefined variable, unsupported operation, division by zero, integer overflow).
+    void eval(const std::function<void(const Column&)>& consumer);
+};
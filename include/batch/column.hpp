@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <string>
+#include "../types.hpp"
+
+/// @brief A typed buffer of numbers, all of the same type,
+/// which is either the input bound to a variable or the output of a batch evaluation.
+/// Only integers and doubles can be stored in a column.
+class Column final {
+  Type type;
+  std::vector<std::int64_t> integers;
+  std::vector<double> doubles;
+
+  explicit Column(Type t);
+
+  public:
+    /// @brief Creates an empty column of the given type.
+    /// @param type Either `Type::INT` or `Type::DOUBLE`.
+    /// @throw Exception if the type is neither INT nor DOUBLE.
+    static Column of_type(Type type);
+
+    static Column from_integers(std::vector<std::int64_t> values);
+    static Column from_doubles(std::vector<double> values);
+
+    [[nodiscard]] Type get_type() const { return type; }
+
+    /// @brief Gets the number of rows of the column.
+    [[nodiscard]] std::size_t size() const {
+      return type == Type::INT ? integers.size() : doubles.size();
+    }
+
+    /// @brief Reads the integers of the column (empty if the column holds doubles).
+    [[nodiscard]] const std::vector<std::int64_t>& get_integers() const { return integers; }
+
+    /// @brief Reads the doubles of the column (empty if the column holds integers).
+    [[nodiscard]] const std::vector<double>& get_doubles() const { return doubles; }
+
+    /// @brief Gives direct access to the integers, to fill the column without any copy.
+    std::vector<std::int64_t>& mutable_integers() { return integers; }
+
+    /// @brief Gives direct access to the doubles, to fill the column without any copy.
+    std::vector<double>& mutable_doubles() { return doubles; }
+
+    /// @brief Gets the representation of a row, just like `Value::to_string()` would.
+    /// @param row The index of the row.
+    [[nodiscard]] std::string to_string(std::size_t row) const;
+};
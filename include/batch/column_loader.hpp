@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include "column.hpp"
+
+/// @brief Named columns of the same length, loaded from a file.
+struct table_t {
+  std::vector<std::string> names;
+  std::vector<std::shared_ptr<const Column>> columns;
+  std::size_t rows = 0;
+};
+
+/// @brief Loads numeric columns from a file, so that an expression can be evaluated over them (see BatchEvaluator).
+/// Two formats are supported:
+/// - CSV: a header with the names of the columns, then one row per line.
+///   A column is made of integers if all of its values are 64-bit integers, otherwise it's made of doubles.
+/// - Binary (".bkc"): the columns stored one after the other, as they are in memory:
+///   ```
+///   "BKCOLUMN"                          8 bytes
+///   number of columns                   uint32
+///   number of rows                      uint64
+///   for each column:
+///     type (0 = int64, 1 = float64)     uint8
+///     length of the name                uint16
+///     name                              bytes
+///   padding to a multiple of 8 bytes
+///   for each column: its values, padded to a multiple of 8 bytes
+///   ```
+///   The integers are in the native byte order.
+/// In both cases the file is mapped into memory instead of being read into a buffer.
+class ColumnLoader final {
+  public:
+    /// @brief Loads a file, the format depends on the extension (".bkc" for the binary format, CSV otherwise).
+    /// @param path The path to the file.
+    /// @throw Exception if the file cannot be read or is invalid.
+    static table_t load(const std::string& path);
+
+    /// @brief Loads a CSV file, parsing chunks of rows in parallel.
+    /// @param path The path to the file.
+    /// @param threads The number of threads (0 to use all the cores).
+    /// @throw Exception if the file cannot be read or is invalid.
+    static table_t load_csv(const std::string& path, unsigned int threads = 0);
+
+    /// @brief Loads a binary columnar file.
+    /// @param path The path to the file.
+    /// @throw Exception if the file cannot be read or is invalid.
+    static table_t load_binary(const std::string& path);
+
+    /// @brief Writes columns in the binary columnar format.
+    /// @param path The path to the file.
+    /// @param table The columns to write.
+    /// @throw Exception if the file cannot be written.
+    static void write_binary(const std::string& path, const table_t& table);
+};
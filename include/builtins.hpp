@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include <optional>
+
+/// @brief The functions that the language provides.
+/// They're resolved by the parser, so the engines receive the function itself instead of its name.
+namespace Builtin {
+  enum Type {
+    SUM, // sum(list)
+    MIN, // min(list)
+    MAX, // max(list)
+    MEAN, // mean(list)
+    DOT // dot(list, list)
+  };
+}
+
+/// @brief Gets the name of a built-in function.
+std::string get_builtin_name(Builtin::Type builtin);
+
+/// @brief Gets the number of arguments that a built-in function expects.
+unsigned int get_builtin_arity(Builtin::Type builtin);
+
+/// @brief Gets the built-in function from its name.
+/// @return The function, or nothing if there isn't any function with this name.
+std::optional<Builtin::Type> get_builtin_from_name(const std::string& name);
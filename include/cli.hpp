@@ -1,4 +1,7 @@
 #pragma once
 
+#include "run.hpp"
+
 /// @brief Starts the CLI version of BangerKing.
-void cli();
\ No newline at end of file
+/// @param engine The engine executing each line.
+void cli(Engine::Type engine = Engine::TREE_WALKER);
\ No newline at end of file
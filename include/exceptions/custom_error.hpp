@@ -9,6 +9,9 @@ class CustomError: public std::exception {
     const Position pos_end;
     const std::string error_name;
     const std::string details;
+    /// @brief The source code where the error occurred, read when the error is created,
+    /// so that the error can be printed even after the program that stored it is destroyed (`nullptr` if unknown).
+    const std::shared_ptr<const std::string> source;
 
   public:
     CustomError(
@@ -1,6 +1,35 @@
 #pragma once
 
 #include <map>
+#include <memory>
 #include <string>
 
-extern std::map<std::string, std::shared_ptr<std::string>> READ_FILES;
\ No newline at end of file
+extern std::map<std::string, std::shared_ptr<std::string>> READ_FILES;
+
+/// @brief The source code of a program compiled from C++ (see Program and BatchEvaluator),
+/// stored in READ_FILES under a key of its own, so that the errors of a program show its own source code.
+/// The source code is removed from READ_FILES when the handle is destroyed.
+/// Several threads may store sources and read them (with `find_source`) at the same time.
+class StoredSource final {
+  std::string key;
+
+  public:
+    /// @brief Stores a source code under a new key.
+    /// @param kind Describes the program in the key, "program" gives "<program 1>" for example.
+    /// @param source The source code.
+    StoredSource(const std::string& kind, std::string source);
+
+    StoredSource(const StoredSource&) = delete;
+    StoredSource& operator=(const StoredSource&) = delete;
+    StoredSource(StoredSource&& other) noexcept;
+    StoredSource& operator=(StoredSource&& other) noexcept;
+    ~StoredSource();
+
+    /// @brief Gets the key of the source code in READ_FILES, to give to the Parser as the filename.
+    [[nodiscard]] const std::string& get_key() const;
+};
+
+/// @brief Reads a source code from READ_FILES, safely with respect to StoredSource.
+/// @param key The filename of a position.
+/// @return `nullptr` if there is no source code under this key.
+std::shared_ptr<const std::string> find_source(const std::string& key);
@@ -1,12 +1,15 @@
 #pragma once
 
+#include <array>
 #include <cmath>
+#include <type_traits>
 #include "runtime.hpp"
 #include "context.hpp"
 #include "miscellaneous.hpp"
 #include "nodes/compositer.hpp"
 #include "values/compositer.hpp"
 #include "exceptions/arithmetic_error.hpp"
+#include "exceptions/type_overflow_error.hpp"
 
 class Interpreter final {
   static std::shared_ptr<Context> shared_ctx;
@@ -14,163 +17,364 @@ class Interpreter final {
   public:
     static void set_shared_ctx(const std::shared_ptr<Context>& ctx);
 
-    /// @brief Interprets a node recursively.
+    /// @brief Interprets a node recursively, once.
     /// The very first node to give to the interpreter should be a ListNode,
     /// even though it would work with any other kind of a node.
     /// A program is a list of nodes, so it makes sense to pass a ListNode.
     /// 
     /// So as to improve memory management, the ownership of the nodes
-    /// must be transferred to the visit methods, so as to
-    /// deallocate them automatically when they've been visited.
+    /// must be transferred to this method, so as to
+    /// deallocate each statement as soon as it has been interpreted.
     /// The benefit of doing this is that the memory used by the Parser,
     /// is deallocated progressively while the Interpreter's doing its magic.
+    /// It's meant for one-shot scripts.
     /// @param node The node to interpret
     /// @return The result of the intepretation
-    static std::unique_ptr<RuntimeResult> visit(std::unique_ptr<CustomNode>&& node);
-    
+    static RuntimeResult visit(std::unique_ptr<CustomNode>&& node);
+
+    /// @brief Interprets a node recursively, without modifying it.
+    /// The tree is left intact, so the same parsed program can be executed as many times as needed
+    /// (in different contexts for example).
+    /// @param node The node to interpret
+    /// @return The result of the intepretation
+    static RuntimeResult visit(const CustomNode& node);
+
+    // The following methods hold the semantics of the language
+    // that do not depend on the shape of the tree.
+    // They're public because the virtual machine (include/vm/vm.hpp)
+    // executes the exact same rules on bytecode,
+    // so that both engines always produce the same values and the same errors.
+
+    /// @brief Applies a binary operation (addition, substraction, multiplication, power, division or modulo) between two values.
+    /// A boolean used in a binary operation is considered as an integer (true = 1, false = 0).
+    /// @param op The node type of the operation (NodeType::ADD, NodeType::MULTIPLY, etc.).
+    /// @param left The left operand.
+    /// @param right The right operand.
+    /// @param pos_start The starting position of the operation in the source code.
+    /// @param pos_end The ending position of the operation in the source code.
+    /// @param ctx The context in which the operation happens.
+    /// @return The new value.
+    static std::unique_ptr<Value> interpret_binary_operation(NodeType::Type op, const Value& left, const Value& right, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Calls a built-in function.
+    /// @param builtin The function.
+    /// @param args The arguments, there are as many as the function expects (the parser checked it).
+    /// @param pos_start The starting position of the call.
+    /// @param pos_end The ending position of the call.
+    /// @param ctx The context in which the call happens.
+    /// @return The value returned by the function.
+    /// @throw TypeError if an argument isn't a list.
+    /// @throw RuntimeError if a list isn't made of numbers, if it's empty (`min`, `max` and `mean`),
+    /// or if the lists don't have the same length (`dot`).
+    static std::unique_ptr<Value> interpret_call(Builtin::Type builtin, const std::vector<const Value*>& args, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Creates a dictionary from its keys and its values (`{key: value}`).
+    /// @param keys_and_values The keys and the values, alternately.
+    /// @throw TypeError if a key isn't a string.
+    static std::unique_ptr<Value> make_dictionary(const std::vector<const Value*>& keys_and_values, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Reads an element of a list (`list[index]`), or the value of a key in a dictionary (`dict[key]`).
+    /// @return A copy of the element.
+    /// @throw TypeError if `list` isn't a list nor a dictionary, if the index isn't an integer or if the key isn't a string.
+    /// @throw RuntimeError if the index is out of range or if the key doesn't exist.
+    static std::unique_ptr<Value> interpret_list_access(const Value& list, const Value& index, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Creates a slice of a list (`list[start:end]`), from `start` (included) to `end` (excluded).
+    /// The bounds are clamped to the size of the list, and a slice whose end precedes its start is empty.
+    /// The slice is a view on the elements of the list (see `ListValue::slice`).
+    /// @throw TypeError if `list` isn't a list or if a bound isn't an integer.
+    /// @throw RuntimeError if a bound is negative.
+    static std::unique_ptr<Value> interpret_list_slice(const Value& list, const Value& start, const Value& end, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Modifies an element of a list stored in a variable (`list[index] = element`),
+    /// the variable receiving a new list (see `ListValue::with_element`).
+    /// On a dictionary, it adds an entry or replaces the value of a key (`dict[key] = value`), in place (see `DictionaryValue::set`).
+    /// Call `check_variable_modification` first.
+    /// @return A copy of the new element.
+    /// @throw TypeError if the variable isn't a list nor a dictionary, if the index isn't an integer or if the key isn't a string.
+    /// @throw RuntimeError if the index is out of range.
+    static std::unique_ptr<Value> assign_list_element(const std::string& name, const Value& index, const Value& element, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Applies the negative unary operation (-5) on a value.
+    static std::unique_ptr<Value> interpret_negation(const Value& value, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Applies the positive unary operation (+5) on a value.
+    static std::unique_ptr<Value> interpret_positive(const Value& value, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Makes sure that a variable can be declared, before its initial value gets interpreted.
+    /// @param name The name of the new variable.
+    /// @param type The type of the new variable (`Type::ERROR_TYPE` if the given type name is unknown).
+    /// @param pos_start The starting position of the declaration.
+    /// @param pos_end The ending position of the declaration.
+    /// @param ctx The context in which the variable is declared.
+    /// @throw RuntimeError if the variable already exists in the current context.
+    /// @throw TypeError if the type is unknown.
+    static void check_variable_declaration(const std::string& name, Type type, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Declares a variable in the given context.
+    /// @param name The name of the new variable.
+    /// @param type The type of the new variable.
+    /// @param initial_value Its initial value (it's copied), or `nullptr` if it should receive the default value of its type.
+    /// @param pos_start The starting position of the declaration.
+    /// @param pos_end The ending position of the declaration.
+    /// @param value_start The starting position of the initial value (for the TypeError).
+    /// @param value_end The ending position of the initial value (for the TypeError).
+    /// @param ctx The context in which the variable is declared.
+    /// @return A copy of the value stored in the symbol table.
+    static std::unique_ptr<Value> declare_variable(const std::string& name, Type type, const Value* initial_value, const Position& pos_start, const Position& pos_end, const Position& value_start, const Position& value_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Makes sure that a constant can be defined, before its value gets interpreted.
+    /// @throw RuntimeError if the constant already exists.
+    static void check_constant_definition(const std::string& name, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Defines a constant in the given context.
+    /// The positions of the value are only used if it cannot be cast into the type of the constant.
+    /// @return A copy of the value stored in the symbol table.
+    static std::unique_ptr<Value> define_constant(const std::string& name, Type type, const Value& value, const Position& value_start, const Position& value_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Makes sure that a variable can be modified, before its new value gets interpreted.
+    /// @throw RuntimeError if the variable doesn't exist.
+    /// @throw TypeError if the variable is a constant.
+    static void check_variable_modification(const std::string& name, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Modifies a variable, casting the new value into the type of the variable if necessary.
+    /// The positions of the new value are only used if it cannot be cast into the type of the variable.
+    /// @return A copy of the new value stored in the symbol table.
+    static std::unique_ptr<Value> modify_variable(const std::string& name, const Value& new_value, const Position& value_start, const Position& value_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Reads a variable.
+    /// @return A copy of the value stored in the symbol table.
+    /// @throw RuntimeError if the variable doesn't exist.
+    static std::unique_ptr<Value> access_variable(const std::string& name, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
+
   private:
     // Here the specific visit methods.
     // Each of them will take care of interpreting a specific node.
-    // They also become the owners of the node they're interpreting,
-    // so as to deallocate the memory used by the Parser progressively.
-    // They become the owners because the parameter is a std::unique_ptr.
-
-    static std::unique_ptr<RuntimeResult> visit_IntegerNode(std::unique_ptr<const IntegerNode>&&);
-    static std::unique_ptr<RuntimeResult> visit_DoubleNode(std::unique_ptr<const DoubleNode>&&);
-    static std::unique_ptr<RuntimeResult> visit_ListNode(std::unique_ptr<ListNode>&&);
-    static std::unique_ptr<RuntimeResult> visit_MinusNode(std::unique_ptr<MinusNode>&&);
-    static std::unique_ptr<RuntimeResult> visit_PlusNode(std::unique_ptr<PlusNode>&&);
-    static std::unique_ptr<RuntimeResult> visit_VarAssignmentNode(std::unique_ptr<VarAssignmentNode>&&);
-    static std::unique_ptr<RuntimeResult> visit_DefineConstantNode(std::unique_ptr<DefineConstantNode>&&);
-    static std::unique_ptr<RuntimeResult> visit_VarAccessNode(std::unique_ptr<VarAccessNode>&&);
-    static std::unique_ptr<RuntimeResult> visit_VarModifyNode(std::unique_ptr<VarModifyNode>&&);
-    static std::unique_ptr<RuntimeResult> visit_StringNode(std::unique_ptr<const StringNode>&&);
-    static std::unique_ptr<RuntimeResult> visit_BooleanNode(std::unique_ptr<const BooleanNode>&&);
-    static std::unique_ptr<RuntimeResult> visit_OrNode(std::unique_ptr<OrNode>&&);
-    static std::unique_ptr<RuntimeResult> visit_AndNode(std::unique_ptr<AndNode>&&);
-    static std::unique_ptr<RuntimeResult> visit_NotNode(std::unique_ptr<NotNode>&&);
+    // They only read the nodes, so that a tree can be interpreted several times.
+
+    static RuntimeResult visit_IntegerNode(const IntegerNode&);
+    static RuntimeResult visit_DoubleNode(const DoubleNode&);
+    static RuntimeResult visit_ListNode(const ListNode&);
+    static RuntimeResult visit_DictNode(const DictNode&);
+    static RuntimeResult visit_MinusNode(const MinusNode&);
+    static RuntimeResult visit_PlusNode(const PlusNode&);
+    static RuntimeResult visit_VarAssignmentNode(const VarAssignmentNode&);
+    static RuntimeResult visit_DefineConstantNode(const DefineConstantNode&);
+    static RuntimeResult visit_VarAccessNode(const VarAccessNode&);
+    static RuntimeResult visit_VarModifyNode(const VarModifyNode&);
+    static RuntimeResult visit_StringNode(const StringNode&);
+    static RuntimeResult visit_BooleanNode(const BooleanNode&);
+    static RuntimeResult visit_OrNode(const OrNode&);
+    static RuntimeResult visit_AndNode(const AndNode&);
+    static RuntimeResult visit_NotNode(const NotNode&);
+    static RuntimeResult visit_ConcatNode(const ConcatNode&);
+    static RuntimeResult visit_CallNode(const CallNode&);
+    static RuntimeResult visit_ListAccessNode(const ListAccessNode&);
+    static RuntimeResult visit_ListSliceNode(const ListSliceNode&);
+    static RuntimeResult visit_ListAssignmentNode(const ListAssignmentNode&);
 
     /// @brief Explores a binary operation node (addition, substraction, division, power, multiplication, modulo, etc.)
     /// @param node A binary operation node.
     /// @return The intepretation of this operation as a RuntimeResult.
-    static std::unique_ptr<RuntimeResult> visit_BinaryOperationNode(std::unique_ptr<BinaryOperationNode>&& node);
+    static RuntimeResult visit_BinaryOperationNode(const BinaryOperationNode& node);
 
-    static std::unique_ptr<Value> interpret_addition(std::shared_ptr<const Value>, std::shared_ptr<const Value>, std::unique_ptr<const BinaryOperationNode>);
-    static std::unique_ptr<Value> interpret_substraction(std::shared_ptr<const Value>, std::shared_ptr<const Value>, std::unique_ptr<const BinaryOperationNode>);
-    static std::unique_ptr<Value> interpret_multiplication(std::shared_ptr<const Value>, std::shared_ptr<const Value>, std::unique_ptr<const BinaryOperationNode>);
-    static std::unique_ptr<Value> interpret_power(std::shared_ptr<const Value>, std::shared_ptr<const Value>, std::unique_ptr<const BinaryOperationNode>);
-    static std::unique_ptr<Value> interpret_division(std::shared_ptr<const Value>, std::shared_ptr<const Value>, std::unique_ptr<const BinaryOperationNode>);
-    static std::unique_ptr<Value> interpret_modulo(std::shared_ptr<const Value>, std::shared_ptr<const Value>, std::unique_ptr<const BinaryOperationNode>);
+    /// @brief The signature shared by all the binary operations of the dispatch table.
+    /// The operands are guaranteed to be of the types that the entry was registered for.
+    using binary_operation_t = std::unique_ptr<Value>(*)(const Value&, const Value&, const Position&, const Position&, const std::shared_ptr<Context>&);
+
+    static constexpr int NUMBER_OF_NODE_TYPES = NodeType::VAR_MODIFY + 1;
+    static constexpr int NUMBER_OF_TYPES = Type::ERROR_TYPE + 1;
+
+    /// @brief A table of binary operations indexed by [operation][type of left operand][type of right operand].
+    using binary_operations_table_t = std::array<std::array<std::array<binary_operation_t, NUMBER_OF_TYPES>, NUMBER_OF_TYPES>, NUMBER_OF_NODE_TYPES>;
+
+    /// @brief All the binary operations of the language, built at compile time from the templates below.
+    /// Every combination that isn't supported throws an illegal operation,
+    /// so a binary operation costs a single indirect call, without any dynamic cast.
+    static const binary_operations_table_t binary_operations;
+
+    /// @brief Builds the table of binary operations (see `binary_operations`).
+    static constexpr binary_operations_table_t make_binary_operations_table();
 
     // helper methods:
 
-    /// @brief Populates a value with its starting and ending position, and its context.
-    /// @param value The value to populate.
-    /// @param pos_start The starting position to give to the given value.
-    /// @param pos_end The ending position to give to the given value.
-    /// @param ctx The reference of the context to give to the given value.
-    static void populate(Value& value, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
-
-    /// @brief Populates a value with its starting and ending position, deduced from the given node, and its context.
-    /// The "node" parameter is marked as "&&", it's because it must take the ownership of the given node,
-    /// meaning that when calling this function, std::move must be used on the second parameter.
-    /// @param value The value to populate.
-    /// @param node The node that created this value, and whose position must be passed to the given value.
-    /// @param ctx The reference of the context to give to the given value.
-    static void populate(Value& value, std::unique_ptr<const CustomNode>&& node, const std::shared_ptr<Context>& ctx);
-    
     /// @brief Throws a `RuntimeError` for an illegal operation (like "5 + a_function" for example).
     /// @param node The node that created this issue.
     /// @param ctx The context in which this issue happened.
-    static void illegal_operation(std::unique_ptr<const CustomNode>&& node, const std::shared_ptr<Context>& ctx);
+    static void illegal_operation(const CustomNode& node, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Throws a `RuntimeError` for an illegal operation (like "5 + a_function" for example).
+    /// @param pos_start The starting position of the operation.
+    /// @param pos_end The ending position of the operation.
+    /// @param ctx The context in which this issue happened.
+    static void illegal_operation(const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Throws a `TypeOverflowError` for an operation whose result is too big even for a big integer.
+    /// @param pos_start The starting position of the operation.
+    /// @param pos_end The ending position of the operation.
+    /// @param ctx The context in which this issue happened.
+    [[noreturn]] static void integer_overflow(const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Throws a `TypeOverflowError` for a repetition whose result would be longer than `StringValue::MAX_LENGTH`.
+    /// @param pos_start The starting position of the operation.
+    /// @param pos_end The ending position of the operation.
+    /// @param ctx The context in which this issue happened.
+    [[noreturn]] static void string_overflow(const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Makes sure that a value is a list, in order to read its elements.
+    /// @throw TypeError if it isn't a list.
+    static const ListValue& expect_list(const Value& value, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Reads an index (or a bound of a slice), which must be a positive integer.
+    /// @throw TypeError if it isn't an integer.
+    /// @throw RuntimeError if it's negative.
+    static std::size_t read_index(const Value& index, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Reads a key of a dictionary, which must be a string.
+    /// @throw TypeError if it isn't a string.
+    static std::string_view read_key(const Value& key, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Computes a built-in function element by element, through the binary operations,
+    /// when the kernels of ListOperations cannot (a list holding a big integer).
+    /// `min` and `max` compare two elements with the sign of their difference.
+    /// @param other The second list of `dot`, the same as `list` for the other functions.
+    /// @return `nullptr` if one of the elements isn't a number.
+    static std::unique_ptr<Value> fold_call(Builtin::Type builtin, const ListValue& list, const ListValue& other, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Reads the index of an element of a list.
+    /// @throw TypeError if it isn't an integer.
+    /// @throw RuntimeError if it's out of range.
+    static std::size_t read_element_index(const ListValue& list, const Value& index, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
 
     /// @brief Throws a `TypeError` for trying to assign an incompatible type to a variable.
     /// @param value The value whose type differs from the `expected_type` (or is not castable into the `expected_type`).
     /// @param expected_type The type of the variable.
+    /// @param value_start The starting position of the expression that produced the value.
+    /// @param value_end The ending position of the expression that produced the value.
     /// @param ctx The context in which the error occured.
-    static void type_error(const std::shared_ptr<Value>& value, const Type& expected_type, const std::shared_ptr<Context>& ctx);
+    static void type_error(const Value& value, const Type& expected_type, const Position& value_start, const Position& value_end, const std::shared_ptr<Context>& ctx);
 
-    /// @brief Populates a value with the positions of the given node and the `shared_ctx`,
-    /// and registers a successfull action in the provided RuntimeResult instance.
-    /// @param res The RuntimeResult created by a visit method.
-    /// @param value The value to populate with positions & context.
-    /// @param node The node that the Interpreter is visiting and that produced the given value.
-    static void make_success(const std::unique_ptr<RuntimeResult>& res, std::unique_ptr<Value>&& value, std::unique_ptr<const CustomNode>&& node);
-
-    /// @brief Applies a binary mathematical operation between `left` and `right` during the interpretation of `node`.
+    /// @brief Applies a binary mathematical operation between `left` and `right`.
     /// The operation to apply is given as a lambda function via the `operation` argument.
-    /// This method will populate the new value with the positions of the provided `node` and the `shared_ctx`.
+    /// The positions and the context are only used to raise an error.
     /// @tparam A The exact type of the left member.
     /// @tparam B The exact type of the right member.
     /// @tparam Op The lambda function that's automatically deduced when calling this function. No need to specify it explicitely.
-    /// @param left The left member of the operation.
-    /// @param right The right member of the operation.
-    /// @param node The binary operation node that the Interpreter is currently interpreting.
+    /// @param left The left member of the operation, an instance of `A`.
+    /// @param right The right member of the operation, an instance of `B`.
+    /// @param pos_start The starting position of the operation.
+    /// @param pos_end The ending position of the operation.
+    /// @param ctx The context in which the operation happens.
     /// @param operation The lambda actually executing the operation and returning a new Value.
     /// @param is_division_or_modulo If the operation is a division or a modulo and an error occured during the operation, maybe it's a divison-by-zero error (ArithmeticError).
     /// @return An instance of `Value` from the operation.
     template <typename A, typename B, typename Op>
-    static std::unique_ptr<Value> make_operation(std::shared_ptr<const Value>& left, std::shared_ptr<const Value>& right, std::unique_ptr<const BinaryOperationNode> node, Op operation, bool is_division_or_modulo = false) {
-      const A* a = dynamic_cast<const A*>(left.get());
-      const B* b = dynamic_cast<const B*>(right.get());
-      auto r = operation(*a, *b);
+    static std::unique_ptr<Value> make_operation(const Value& left, const Value& right, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx, Op operation, bool is_division_or_modulo = false) {
+      // The dispatch table guarantees the types of the operands
+      const A& a = static_cast<const A&>(left);
+      const B& b = static_cast<const B&>(right);
+      auto r = operation(a, b);
       if (r == nullptr) {
         // It's possible in some cases that during the operation
         // it fails and needs to throw a RuntimeError.
         // It happens in this example: string * int (if int is negative).
-        if (is_division_or_modulo) {
-          if (
-            (instanceof<IntegerValue>(right) && cast_const_value<IntegerValue>(right)->get_actual_value() == 0) ||
-            (instanceof<DoubleValue>(right) && cast_const_value<DoubleValue>(right)->get_actual_value() == 0.0)
-          ) {
-            throw ArithmeticError(
-              node->getStartingPosition(), node->getEndingPosition(),
-              "Division by zero isn't possible",
-              shared_ctx
-            );
-          }
+        bool is_zero = false;
+        if constexpr (std::is_same_v<B, IntegerValue> || std::is_same_v<B, DoubleValue>) {
+          is_zero = b.get_actual_value() == 0;
+        } else if constexpr (std::is_same_v<B, BigIntValue>) {
+          is_zero = b.get_actual_value().is_zero();
+        }
+        if (is_division_or_modulo && is_zero) {
+          throw ArithmeticError(
+            pos_start, pos_end,
+            "Division by zero isn't possible",
+            ctx
+          );
+        }
+        // A power of two integers can also fail because its result is way too big.
+        if constexpr ((std::is_same_v<A, IntegerValue> || std::is_same_v<A, BigIntValue>) && (std::is_same_v<B, IntegerValue> || std::is_same_v<B, BigIntValue>)) {
+          integer_overflow(pos_start, pos_end, ctx);
         }
-        illegal_operation(move(node), shared_ctx);
+        // A repetition of a string fails if it's negative, or if the result would be too long.
+        if constexpr (std::is_same_v<A, StringValue> && std::is_same_v<B, IntegerValue>) {
+          if (b.get_actual_value() > 0) string_overflow(pos_start, pos_end, ctx);
+        } else if constexpr (std::is_same_v<A, StringValue> && std::is_same_v<B, BigIntValue>) {
+          if (!b.get_actual_value().is_negative()) string_overflow(pos_start, pos_end, ctx);
+        }
+        illegal_operation(pos_start, pos_end, ctx);
         return nullptr; // will never get reached
       }
-      populate(*r, move(node), shared_ctx);
       return std::unique_ptr<Value>(r);
     }
 
     /// @brief Applies an addition between `left` and `right`.
     template <typename A, typename B>
-    static std::unique_ptr<Value> make_addition(std::shared_ptr<const Value>& left, std::shared_ptr<const Value>& right, std::unique_ptr<const BinaryOperationNode> node) {
-      return make_operation<A, B>(left, right, move(node), [](const A& a, const B& b) { return a + b; });
+    static std::unique_ptr<Value> make_addition(const Value& left, const Value& right, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx) {
+      return make_operation<A, B>(left, right, pos_start, pos_end, ctx, [](const A& a, const B& b) { return a + b; });
     }
 
     /// @brief Applies a substraction between `left` and `right`.
     template <typename A, typename B>
-    static std::unique_ptr<Value> make_substraction(std::shared_ptr<const Value> left, std::shared_ptr<const Value> right, std::unique_ptr<const BinaryOperationNode> node) {
-      return make_operation<A, B>(left, right, move(node), [](const A& a, const B& b) { return a - b; });
+    static std::unique_ptr<Value> make_substraction(const Value& left, const Value& right, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx) {
+      return make_operation<A, B>(left, right, pos_start, pos_end, ctx, [](const A& a, const B& b) { return a - b; });
     }
 
     /// @brief Applies a multiplication between `left` and `right`.
     template <typename A, typename B>
-    static std::unique_ptr<Value> make_multiplication(std::shared_ptr<const Value> left, std::shared_ptr<const Value> right, std::unique_ptr<const BinaryOperationNode> node) {
-      return make_operation<A, B>(left, right, move(node), [](const A& a, const B& b) { return a * b; });
+    static std::unique_ptr<Value> make_multiplication(const Value& left, const Value& right, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx) {
+      return make_operation<A, B>(left, right, pos_start, pos_end, ctx, [](const A& a, const B& b) { return a * b; });
+    }
+
+    /// @brief Applies a multiplication between `right` and `left` (int * string is the same as string * int).
+    template <typename A, typename B>
+    static std::unique_ptr<Value> make_inverted_multiplication(const Value& left, const Value& right, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx) {
+      return make_multiplication<B, A>(right, left, pos_start, pos_end, ctx);
     }
 
     /// @brief Applies a power operation between `left` and `right`.
     /// @tparam R Since the result type cannot be deduced, it must be specified when calling this method.
     template <typename A, typename B, typename R>
-    static std::unique_ptr<Value> make_power(std::shared_ptr<const Value> left, std::shared_ptr<const Value> right, std::unique_ptr<const BinaryOperationNode> node) {
-      return make_operation<A, B>(left, right, move(node), [](const A& a, const B& b) { return new R(std::pow(a.get_actual_value(), b.get_actual_value())); });
+    static std::unique_ptr<Value> make_power(const Value& left, const Value& right, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx) {
+      return make_operation<A, B>(left, right, pos_start, pos_end, ctx, [](const A& a, const B& b) { return new R(std::pow(a.get_actual_value(), b.get_actual_value())); });
+    }
+
+    /// @brief Applies an exact power operation between two integers.
+    template <typename A, typename B>
+    static std::unique_ptr<Value> make_integer_power(const Value& left, const Value& right, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx) {
+      return make_operation<A, B>(left, right, pos_start, pos_end, ctx, [](const A& a, const B& b) { return a.pow(b); });
     }
 
     /// @brief Applies a division between `left` and `right`.
     template <typename A, typename B>
-    static std::unique_ptr<Value> make_division(std::shared_ptr<const Value> left, std::shared_ptr<const Value> right, std::unique_ptr<const BinaryOperationNode> node) {
-      return make_operation<A, B>(left, right, move(node), [](const A& a, const B& b) { return a / b; }, true);
+    static std::unique_ptr<Value> make_division(const Value& left, const Value& right, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx) {
+      return make_operation<A, B>(left, right, pos_start, pos_end, ctx, [](const A& a, const B& b) { return a / b; }, true);
     }
 
     /// @brief Applies a modulo between `left` and `right`.
     template <typename A, typename B>
-    static std::unique_ptr<Value> make_modulo(std::shared_ptr<const Value> left, std::shared_ptr<const Value> right, std::unique_ptr<const BinaryOperationNode> node) {
-      return make_operation<A, B>(left, right, move(node), [](const A& a, const B& b) { return a % b; }, true);
+    static std::unique_ptr<Value> make_modulo(const Value& left, const Value& right, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx) {
+      return make_operation<A, B>(left, right, pos_start, pos_end, ctx, [](const A& a, const B& b) { return a % b; }, true);
     }
+
+    /// @brief Concatenates a string (`left`) with any value (`right`).
+    static std::unique_ptr<Value> make_concatenation(const Value& left, const Value& right, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Concatenates any value (`left`) with a string (`right`).
+    static std::unique_ptr<Value> make_concatenation_rtl(const Value& left, const Value& right, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Adds two lists of the same length, element by element (`[1, 2] + [3, 4]` = `[4, 6]`).
+    /// The lists of numbers go through the kernels of `ListOperations`,
+    /// the other elements are added one by one, just like in a binary operation.
+    /// @throw RuntimeError if the lists don't have the same length.
+    static std::unique_ptr<Value> make_list_addition(const Value& left, const Value& right, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Multiplies each element of a list (`left`) by a number (`right`).
+    static std::unique_ptr<Value> make_list_multiplication(const Value& left, const Value& right, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief Multiplies each element of a list (`right`) by a number (`left`).
+    static std::unique_ptr<Value> make_inverted_list_multiplication(const Value& left, const Value& right, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
+
+    /// @brief The default entry of the table of binary operations.
+    /// @throw RuntimeError
+    static std::unique_ptr<Value> make_illegal_operation(const Value& left, const Value& right, const Position& pos_start, const Position& pos_end, const std::shared_ptr<Context>& ctx);
 };
@@ -35,6 +35,9 @@ extern const char SIMPLE_QUOTE;
 /// @brief A simple backslash (\).
 extern const char BACKSLASH;
 
+/// @brief A dollar sign ($), which inserts a variable in a string with double quotes.
+extern const char DOLLAR;
+
 // met leur référence dans le header pour que tous les fichiers y aient accès (sinon ils renvoient "undefined symbol")
 // et tu les implémentes (tu donnes une valeur) dans le fichier d'mplementation (lexer.cpp)
 
@@ -83,7 +86,8 @@ class Lexer final {
 
     /// @brief Creates an instance of Lexer for a single line to analyze.
     /// @param input The single line to analyze from the CLI.
-    static std::unique_ptr<Lexer> readCLI(const std::string& input);
+    /// @param filename The key of the source code in READ_FILES, used by the positions.
+    static std::unique_ptr<Lexer> readCLI(const std::string& input, const std::string& filename = "<stdin>");
 
     /// @brief Initializes the Lexer for the analysis of a file.
     /// @param source_code The shared pointer towards the source code that the Lexer is going to progressively build up in READ_FILES.
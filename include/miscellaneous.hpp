@@ -83,7 +83,7 @@ std::shared_ptr<T> cast_value(std::shared_ptr<Value>& base) {
 /// @param base The instance of Value in a shared pointer.
 /// @return The cast from Value to `T`
 template <typename T>
-std::shared_ptr<const T> cast_const_value(std::shared_ptr<const Value>& base) {
+std::shared_ptr<const T> cast_const_value(const std::shared_ptr<const Value>& base) {
   if (auto c = std::dynamic_pointer_cast<const T>(base)) {
     return c;
   } else {
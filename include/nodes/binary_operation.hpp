@@ -22,5 +22,12 @@ class BinaryOperationNode: public CustomNode {
 
     std::unique_ptr<CustomNode> retrieve_a();
     std::unique_ptr<CustomNode> retrieve_b();
+
+    /// @brief Reads the left member without transferring ownership.
+    [[nodiscard]] const CustomNode& get_a() const;
+
+    /// @brief Reads the right member without transferring ownership.
+    [[nodiscard]] const CustomNode& get_b() const;
+
     [[nodiscard]] std::string to_string() const override = 0; // pure inherited virtual method
 };
\ No newline at end of file
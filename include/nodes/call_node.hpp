@@ -0,0 +1,29 @@
+#pragma once
+
+#include "list_node.hpp"
+#include "../builtins.hpp"
+
+/// @brief The call to a built-in function, like `sum(numbers)`.
+class CallNode final: public CustomNode {
+  const Builtin::Type builtin;
+  list_of_nodes_ptr arg_nodes;
+
+  public:
+    /// @brief Creates the call to a built-in function.
+    /// @param builtin The function.
+    /// @param args The arguments, whose number has already been checked by the parser.
+    /// @param start The beginning of the function's name.
+    /// @param end The end of the closing parenthesis.
+    CallNode(Builtin::Type builtin, list_of_nodes_ptr args, const Position& start, const Position& end);
+
+    ~CallNode() override = default;
+
+    [[nodiscard]] Builtin::Type get_builtin() const;
+
+    list_of_nodes_ptr retrieve_args();
+
+    /// @brief Reads the arguments of this call without transferring ownership.
+    [[nodiscard]] const std::list<std::unique_ptr<CustomNode>>& get_args() const;
+
+    [[nodiscard]] std::string to_string() const override;
+};
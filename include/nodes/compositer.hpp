@@ -9,6 +9,12 @@
 #include "add_node.hpp"
 #include "divide_node.hpp"
 #include "list_node.hpp"
+#include "list_access_node.hpp"
+#include "list_slice_node.hpp"
+#include "list_assignment_node.hpp"
+#include "dict_node.hpp"
+#include "concat_node.hpp"
+#include "call_node.hpp"
 #include "minus_node.hpp"
 #include "modulo_node.hpp"
 #include "multiply_node.hpp"
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "list_node.hpp"
+
+/// @brief A chain of concatenations whose first part is a string literal,
+/// like `"a" + x + "b" + y`, or a string with double quotes that inserts variables (`"I'm $age years old"`).
+/// The parser folds such a chain of additions into this single node,
+/// so that the engines produce the final string at once,
+/// instead of creating (and copying) an intermediate string for each `+`.
+class ConcatNode final: public CustomNode {
+  list_of_nodes_ptr part_nodes;
+
+  public:
+    /// @brief Creates the concatenation of the given parts, the first of them being a StringNode.
+    /// The positions are the ones of the first and the last part.
+    explicit ConcatNode(list_of_nodes_ptr parts);
+
+    /// @brief Creates the concatenation of the given parts, with the positions of the string they come from.
+    ConcatNode(list_of_nodes_ptr parts, const Position& start, const Position& end);
+
+    ~ConcatNode() override = default;
+
+    list_of_nodes_ptr retrieve_parts();
+
+    /// @brief Reads the parts of this concatenation without transferring ownership.
+    [[nodiscard]] const std::list<std::unique_ptr<CustomNode>>& get_parts() const;
+
+    [[nodiscard]] std::string to_string() const override;
+};
@@ -28,6 +28,9 @@ class DefineConstantNode final: public CustomNode {
     /// @return The pointer to the node holding the value of this new constant.
     std::unique_ptr<CustomNode> retrieve_value_node();
 
+    /// @brief Reads the node holding the value of this new constant, without transferring ownership.
+    [[nodiscard]] const CustomNode& get_value_node() const;
+
     /// @brief Gets the name of the constant.
     /// @return The name of the constant.
     [[nodiscard]] std::string get_var_name() const;
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "list_node.hpp"
+
+/// @brief A dictionary literal, like `{'a': 1, 'b': 2}`.
+class DictNode final: public CustomNode {
+  list_of_nodes_ptr entry_nodes;
+
+  public:
+    /// @brief Creates a dictionary literal.
+    /// @param entries The keys and the values, alternately (`key, value, key, value...`).
+    /// @param start The opening brace.
+    /// @param end The closing brace.
+    DictNode(list_of_nodes_ptr entries, const Position& start, const Position& end);
+
+    ~DictNode() override = default;
+
+    list_of_nodes_ptr retrieve_entries();
+
+    /// @brief Reads the keys and the values (alternately) without transferring ownership.
+    [[nodiscard]] const std::list<std::unique_ptr<CustomNode>>& get_entries() const;
+
+    [[nodiscard]] unsigned int get_number_of_entries() const;
+    [[nodiscard]] std::string to_string() const override;
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "custom_node.hpp"
+
+/// @brief The access to an element of a list (`list[index]`).
+class ListAccessNode final: public CustomNode {
+  std::unique_ptr<CustomNode> list_node;
+  std::unique_ptr<CustomNode> index_node;
+
+  public:
+    /// @brief Creates the access to an element.
+    /// The positions go from the beginning of the list to the closing square bracket.
+    ListAccessNode(
+      std::unique_ptr<CustomNode> list,
+      std::unique_ptr<CustomNode> index,
+      const Position& pos_end
+    );
+
+    ~ListAccessNode() override = default;
+
+    std::unique_ptr<CustomNode> retrieve_list();
+    std::unique_ptr<CustomNode> retrieve_index();
+
+    /// @brief Reads the list without transferring ownership.
+    [[nodiscard]] const CustomNode& get_list() const;
+
+    /// @brief Reads the index without transferring ownership.
+    [[nodiscard]] const CustomNode& get_index() const;
+
+    [[nodiscard]] std::string to_string() const override;
+};
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "custom_node.hpp"
+
+/// @brief The modification of an element of a list stored in a variable (`list[index] = value`).
+/// The variable receives a new list (see `ListValue::with_element`).
+class ListAssignmentNode final: public CustomNode {
+  const std::string var_name;
+  std::unique_ptr<CustomNode> index_node;
+  std::unique_ptr<CustomNode> value_node;
+
+  public:
+    ListAssignmentNode(
+      std::string var_name,
+      std::unique_ptr<CustomNode> index,
+      std::unique_ptr<CustomNode> value,
+      const Position& pos_start
+    );
+
+    ~ListAssignmentNode() override = default;
+
+    std::unique_ptr<CustomNode> retrieve_index_node();
+    std::unique_ptr<CustomNode> retrieve_value_node();
+
+    /// @brief Reads the index of the element without transferring ownership.
+    [[nodiscard]] const CustomNode& get_index_node() const;
+
+    /// @brief Reads the node holding the new value of the element, without transferring ownership.
+    [[nodiscard]] const CustomNode& get_value_node() const;
+
+    [[nodiscard]] std::string get_var_name() const;
+    [[nodiscard]] std::string to_string() const override;
+};
\ No newline at end of file
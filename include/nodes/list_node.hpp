@@ -9,8 +9,8 @@ using list_of_nodes_ptr = std::unique_ptr<std::list<std::unique_ptr<CustomNode>>
 /// @brief A list of nodes. It can also contain the whole program, as it is just a list of nodes too.
 class ListNode final: public CustomNode {
   // Note that the CustomNode instances inside of this list
-  // cannot be constant, because during interpretation
-  // the nodes get progressively deallocated hence
+  // cannot be constant, because a one-shot interpretation (or a compilation)
+  // progressively deallocates the nodes, hence
   // modifying some nodes that would contain smart pointers to others.
   list_of_nodes_ptr element_nodes;
 
@@ -26,6 +26,10 @@ class ListNode final: public CustomNode {
     ~ListNode() override = default;
 
     list_of_nodes_ptr get_element_nodes();
+
+    /// @brief Reads the nodes of this list without transferring ownership.
+    [[nodiscard]] const std::list<std::unique_ptr<CustomNode>>& get_elements() const;
+
     [[nodiscard]] int get_number_of_nodes() const;
     [[nodiscard]] std::string to_string() const override;
 };
@@ -0,0 +1,37 @@
+#pragma once
+
+#include "custom_node.hpp"
+
+/// @brief A slice of a list (`list[start:end]`), from `start` (included) to `end` (excluded).
+class ListSliceNode final: public CustomNode {
+  std::unique_ptr<CustomNode> list_node;
+  std::unique_ptr<CustomNode> start_node;
+  std::unique_ptr<CustomNode> end_node;
+
+  public:
+    /// @brief Creates a slice.
+    /// The positions go from the beginning of the list to the closing square bracket.
+    ListSliceNode(
+      std::unique_ptr<CustomNode> list,
+      std::unique_ptr<CustomNode> start,
+      std::unique_ptr<CustomNode> end,
+      const Position& pos_end
+    );
+
+    ~ListSliceNode() override = default;
+
+    std::unique_ptr<CustomNode> retrieve_list();
+    std::unique_ptr<CustomNode> retrieve_start();
+    std::unique_ptr<CustomNode> retrieve_end();
+
+    /// @brief Reads the list without transferring ownership.
+    [[nodiscard]] const CustomNode& get_list() const;
+
+    /// @brief Reads the index of the first element without transferring ownership.
+    [[nodiscard]] const CustomNode& get_start() const;
+
+    /// @brief Reads the index following the last element without transferring ownership.
+    [[nodiscard]] const CustomNode& get_end() const;
+
+    [[nodiscard]] std::string to_string() const override;
+};
\ No newline at end of file
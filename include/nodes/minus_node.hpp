@@ -20,5 +20,8 @@ class MinusNode final: public CustomNode {
     /// @return The ownership of the node it holds.
     std::unique_ptr<CustomNode> retrieve_node();
 
+    /// @brief Reads the node it holds without transferring ownership.
+    [[nodiscard]] const CustomNode& get_node() const;
+
     [[nodiscard]] std::string to_string() const override;
 };
\ No newline at end of file
@@ -16,11 +16,17 @@ namespace NodeType {
         ADD, // 5 + 5
         AND, // 5 && 5
         BOOLEAN, // true, false
+        CALL, // sum(a) (a call to a built-in function)
+        CONCAT, // "a" + b + "c" (a chain of additions whose first operand is a string literal)
         DEFINE_CONSTANT, // define PI as int = 3.14
+        DICT, // {'a': 5}
         DIVIDE, // 5 / 5
         DOUBLE, // 5.0
         INTEGER, // 5
         LIST, // [5]
+        LIST_ACCESS, // a[0]
+        LIST_ASSIGNMENT, // a[0] = 5
+        LIST_SLICE, // a[1:3]
         NEGATIVE, // -5
         MODULO, // 5 % 5
         MULTIPLY, // 5 * 5
@@ -16,5 +16,8 @@ class NotNode final: public CustomNode {
     /// @brief Transfers the node it's negating
     std::unique_ptr<CustomNode> retrieve_node();
 
+    /// @brief Reads the node it holds without transferring ownership.
+    [[nodiscard]] const CustomNode& get_node() const;
+
     [[nodiscard]] std::string to_string() const override;
 };
\ No newline at end of file
@@ -28,6 +28,10 @@ class VarAssignmentNode final: public CustomNode {
     /// @return The pointer to the node holding the initial value of this new variable.
     std::unique_ptr<CustomNode> retrieve_value_node();
 
+    /// @brief Reads the node holding the initial value of this new variable, without transferring ownership.
+    /// @return `nullptr` if the variable doesn't have an initial value.
+    [[nodiscard]] const CustomNode* get_value_node() const;
+
     /// @brief Gets the name of the variable.
     /// @return The name of the variable.
     [[nodiscard]] std::string get_var_name() const;
@@ -17,6 +17,10 @@ class VarModifyNode final: public CustomNode {
     ~VarModifyNode() override = default;
 
     std::unique_ptr<CustomNode> retrieve_value_node();
+
+    /// @brief Reads the node holding the new value of the variable, without transferring ownership.
+    [[nodiscard]] const CustomNode& get_value_node() const;
+
     [[nodiscard]] std::string get_var_name() const;
     [[nodiscard]] std::string to_string() const override;
 };
\ No newline at end of file
@@ -34,6 +34,13 @@ class Parser final {
   /// @brief Skips all the newlines until reaching a different token.
   void ignore_newlines();
 
+  /// @brief Parses expressions separated by commas (the elements of a list, the arguments of a call)
+  /// until the closing token, which is left for the caller to read.
+  /// @param closing_type The type of the closing token.
+  /// @param closing_char The closing token, for the error message.
+  /// @param pos The position at which the tokens are required.
+  std::unique_ptr<std::list<std::unique_ptr<CustomNode>>> comma_separated_exprs(TokenType closing_type, char closing_char, const Position& pos);
+
   /// @brief Reads the next token and store it into `current_token`.
   /// Use `get_tok()` to get this token.
   void advance();
@@ -46,8 +53,9 @@ class Parser final {
 
     /// @brief Initializes the lexer so that it reads a line from the CLI.
     /// @param input The line to parse.
+    /// @param filename The key of the source code in READ_FILES, used by the positions.
     /// @return An instance of Parser.
-    static Parser initCLI(const std::string& input);
+    static Parser initCLI(const std::string& input, const std::string& filename = "<stdin>");
 
     /// @brief Initializes the lexer so that it opens a file and starts reading from it.
     /// @param source_code The pointer towards the value from the key-value pair stored in READ_FILES for the given file.
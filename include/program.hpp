@@ -0,0 +1,86 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include "files.hpp"
+#include "context.hpp"
+#include "vm/register_vm.hpp"
+
+/// @brief What the copies of a Program share: the code, compiled once.
+struct compiled_program_t {
+  /// @brief The source code, under a key of its own, for the errors.
+  StoredSource source;
+
+  RegisterChunk chunk;
+
+  /// @brief The slot of each variable the program refers to (its index in `chunk.names`).
+  std::unordered_map<std::string, unsigned int> slots;
+
+  /// @brief Whether the program declares, defines or modifies the variable of a slot (or one of its elements).
+  /// Such a variable cannot be bound from C++.
+  std::vector<bool> assigned;
+};
+
+/// @brief A program compiled once, whose variables can be bound from C++ before each evaluation.
+/// It's meant to embed BangerKing as an expression language:
+/// ```
+/// Program prog = bk::compile("age >= 18");
+/// prog.bind("age", 19);
+/// auto v = prog.eval();
+/// ```
+/// The variables are resolved into slots at compile time,
+/// so binding a variable and reading it during the evaluation don't go through a symbol table.
+/// A bound variable is read-only from the point of view of the program.
+///
+/// A Program must not be evaluated by several threads at the same time,
+/// but its copies can: they share the compiled code, and each copy has its own bindings and context.
+class Program final {
+  std::shared_ptr<const compiled_program_t> compiled;
+  inputs_t inputs;
+  std::shared_ptr<Context> ctx;
+
+  public:
+    /// @brief Compiles the source code of a program.
+    /// @param source The source code.
+    /// @throw CustomError if the source code is invalid.
+    explicit Program(const std::string& source);
+
+    /// @brief Copies the bindings of another program, and shares its compiled code.
+    Program(const Program& other);
+    Program& operator=(const Program& other);
+    Program(Program&&) noexcept = default;
+    Program& operator=(Program&&) noexcept = default;
+    ~Program() = default;
+
+    /// @brief Binds a value to a variable of the program.
+    /// Binding a variable that the program never refers to does nothing.
+    /// @param name The name of the variable.
+    /// @param value The new value of the variable.
+    /// @throw Exception if the program itself declares or modifies this variable.
+    void bind(const std::string& name, std::unique_ptr<Value> value);
+    void bind(const std::string& name, int value);
+    void bind(const std::string& name, std::int64_t value);
+    void bind(const std::string& name, double value);
+    void bind(const std::string& name, bool value);
+    void bind(const std::string& name, const std::string& value);
+    void bind(const std::string& name, const char* value);
+
+    /// @brief Removes all the bindings.
+    void unbind_all();
+
+    /// @brief Evaluates the program with the current bindings.
+    /// The variables declared by a previous evaluation are forgotten.
+    /// @return The value of the last statement of the program (`nullptr` if the program is empty).
+    /// @throw CustomError if an error occurs during the evaluation.
+    std::shared_ptr<const Value> eval();
+};
+
+namespace bk {
+  /// @brief Compiles a program, to be evaluated as many times as needed.
+  /// @param source The source code of the program.
+  /// @return The compiled program.
+  Program compile(const std::string& source);
+}
@@ -8,23 +8,43 @@ class Context;
 
 class RuntimeResult;
 
+/// @brief The different ways of executing a program.
+namespace Engine {
+    // a namespace is necessary for the same reasons as NodeType
+    enum Type {
+        TREE_WALKER, // the Interpreter, visiting the nodes of the tree recursively (default)
+        VM, // the tree is compiled into bytecode and executed by the VirtualMachine
+        REGISTER_VM // the tree is compiled into three-address bytecode and executed by the RegisterVirtualMachine
+    };
+}
+
+/// @brief Gets the engine from its name, as given on the command line (--engine=vm).
+/// @param name "tree", "vm" or "regvm".
+/// @param engine Where to store the engine.
+/// @return `false` if the name doesn't match any engine.
+bool get_engine_from_name(const std::string& name, Engine::Type& engine);
+
 /// @brief Runs a line as BurgerKing code.
 /// Use this method for the CLI.
 /// Do not use it to read a file because it's less performant.
 /// To read a file, use the overload of this method.
 /// @param input The input string to read, parse and interpret.
 /// @param ctx The context to use for the interpretation of this line.
+/// @param engine The engine executing the line.
 /// @return The runtime result generated by the Interpreter.
 std::unique_ptr<const RuntimeResult> runLine(
     const std::string& input,
-    const std::shared_ptr<Context>& ctx
+    const std::shared_ptr<Context>& ctx,
+    Engine::Type engine = Engine::TREE_WALKER
 );
 
 /// @brief Runs a file and build up the source code progresively to store it in READ_FILES.
 /// @param path The path towards the file to execute.
 /// @param ctx The context to use for the interpretation of this file.
+/// @param engine The engine executing the file.
 /// @return The runtime result generated by the Interpreter.
 std::unique_ptr<const RuntimeResult> runFile(
     const std::string& path,
-    const std::shared_ptr<Context>& ctx
+    const std::shared_ptr<Context>& ctx,
+    Engine::Type engine = Engine::TREE_WALKER
 );
\ No newline at end of file
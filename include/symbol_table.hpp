@@ -1,6 +1,8 @@
 #pragma once
 
-#include <map>
+#include <vector>
+#include <optional>
+#include <string_view>
 #include "values/value.hpp"
 
 class SymbolTableEntry final {
@@ -16,6 +18,12 @@ class SymbolTableEntry final {
     /// @brief Gets a copy of the value this entry is holding.
     [[nodiscard]] Value* get_copy() const;
 
+    /// @brief Reads the value this entry is holding, without copying it.
+    [[nodiscard]] const Value& get_value() const;
+
+    /// @brief Reads the value this entry is holding, so as to modify it in place.
+    [[nodiscard]] Value& get_mutable_value();
+
     /// @brief Is the stored value a constant?
     [[nodiscard]] bool is_constant() const;
 
@@ -24,9 +32,32 @@ class SymbolTableEntry final {
     void overwrite_value(std::unique_ptr<Value> new_value);
 };
 
+/// @brief The variables of a context, in a flat hash table with open addressing (linear probing).
+/// The entries are stored inline in the slots, next to the name and the hash of their variable,
+/// so a lookup hashes the name once, for the whole chain of contexts, and probes contiguous slots.
+/// A removal shifts the following entries of the probe sequence back, so the table needs no tombstones.
 class SymbolTable final: public std::enable_shared_from_this<SymbolTable> {
+  struct slot_t {
+    std::string name;
+    std::size_t hash = 0;
+    std::optional<SymbolTableEntry> entry; // empty for an empty slot
+  };
+
   std::shared_ptr<SymbolTable> parent;
-  std::map<std::string, std::unique_ptr<SymbolTableEntry>> symbols;
+  std::vector<slot_t> slots; // their number is a power of two, or zero
+  std::size_t number_of_symbols = 0;
+
+  /// @brief Gets the slot holding a variable, or the empty slot ending its probe sequence.
+  /// There must be at least one slot.
+  [[nodiscard]] std::size_t probe(std::string_view name, std::size_t hash) const;
+
+  /// @brief Finds a variable in this context only.
+  /// @return `nullptr` if the variable doesn't exist in this context.
+  [[nodiscard]] SymbolTableEntry* find_locally(std::string_view name, std::size_t hash);
+  [[nodiscard]] const SymbolTableEntry* find_locally(std::string_view name, std::size_t hash) const;
+
+  /// @brief Doubles the number of slots (at least 8), and places the entries again, without hashing their names.
+  void grow();
 
   public:
     explicit SymbolTable(std::shared_ptr<SymbolTable> p = nullptr);
@@ -43,6 +74,12 @@ class SymbolTable final: public std::enable_shared_from_this<SymbolTable> {
     /// @return `true` if the given variable exists.
     bool exists_globally(const std::string& var_name) const;
 
+    /// @brief Finds a variable in this context, or any parent context.
+    /// @param name The name of the variable.
+    /// @return The entry of the variable, or `nullptr` if it doesn't exist.
+    [[nodiscard]] SymbolTableEntry* find(const std::string& name);
+    [[nodiscard]] const SymbolTableEntry* find(const std::string& name) const;
+
     /// @brief Checks if this symbol table has a parent context.
     /// @return `true` if there is a parent context.
     bool has_parent() const;
@@ -84,4 +121,6 @@ class SymbolTable final: public std::enable_shared_from_this<SymbolTable> {
 
     /// @brief Clears the current context of all its variables.
     void clear();
+
+    static std::size_t hash(std::string_view name);
 };
\ No newline at end of file
@@ -40,10 +40,21 @@ enum TokenType {
 
 extern const std::vector<std::string> KEYWORDS;
 
+/// @brief A variable inserted in a string with double quotes (`"I'm $age years old"`).
+struct interpolation_t {
+  /// @brief The index of the dollar sign in the value of the string.
+  std::size_t offset;
+  /// @brief The name of the variable (without the dollar sign).
+  std::string name;
+  Position pos_start;
+  Position pos_end;
+};
+
 class Token {
   const TokenType type;
   const std::string value;
   const bool allow_concatenation;
+  const std::vector<interpolation_t> interpolations;
   const Position pos_start;
   const Position pos_end;
 
@@ -53,7 +64,8 @@ class Token {
       std::string v,
       const Position& start,
       const Position* end = nullptr,
-      bool concatenation = false
+      bool concatenation = false,
+      std::vector<interpolation_t> variables = {}
     );
 
     /// @brief Checks if a the type and the value of a token correspond.
@@ -102,6 +114,10 @@ class Token {
     /// @return `true` if `allow_concatenation` is `true`, `false` otherwise.
     [[nodiscard]] bool canConcatenate() const;
 
+    /// @brief Gets the variables inserted in a string with double quotes, in order.
+    /// The value of the string still contains them (`$age`).
+    [[nodiscard]] const std::vector<interpolation_t>& getInterpolations() const;
+
     /// @brief Creates a deep copy of this instance, a clone.
     /// @return A new instance of Token with the same data.
     [[nodiscard]] Token copy() const;
@@ -8,6 +8,8 @@ enum Type {
   STRING,
   BOOLEAN,
   LIST,
+  BIGINT, // an `int` that doesn't fit in 64 bits (see BigIntValue)
+  DICT,
   ERROR_TYPE // the type that is returned whenever the dev is trying to give an unknown native type to a variable
 };
 
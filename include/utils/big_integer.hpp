@@ -0,0 +1,74 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <compare>
+#include <string_view>
+
+/// @brief An arbitrary-precision integer, stored as a sign and a magnitude.
+/// The magnitude is made of 64-bit limbs, the least significant first, without any leading zero limb
+/// (so zero doesn't have any limb, and it's never negative).
+class BigInteger final {
+  public:
+    using limbs_t = std::vector<std::uint64_t>;
+
+    /// @brief Below this number of limbs (for the smallest operand),
+    /// a multiplication uses the schoolbook algorithm instead of Karatsuba's.
+    static constexpr std::size_t KARATSUBA_THRESHOLD = 32;
+
+    /// @brief Below this number of limbs, the decimal conversion divides by 10^19 repeatedly
+    /// instead of splitting the number in two halves.
+    static constexpr std::size_t DECIMAL_THRESHOLD = 16;
+
+  private:
+    bool negative = false;
+    limbs_t limbs;
+
+    BigInteger(bool negative, limbs_t limbs);
+
+  public:
+    BigInteger() = default;
+    explicit BigInteger(std::int64_t value);
+
+    /// @brief Parses a decimal number.
+    /// @param digits The digits, optionally preceded by a minus sign.
+    /// @throw Exception if the text isn't a decimal number.
+    static BigInteger from_string(std::string_view digits);
+
+    [[nodiscard]] bool is_zero() const { return limbs.empty(); }
+    [[nodiscard]] bool is_negative() const { return negative; }
+    [[nodiscard]] bool is_odd() const { return !limbs.empty() && (limbs.front() & 1) != 0; }
+
+    /// @brief Gets the number of bits of the magnitude (0 for zero).
+    [[nodiscard]] std::size_t bit_length() const;
+
+    [[nodiscard]] bool fits_in_int64() const;
+
+    /// @brief Converts the number into a native integer, it must fit in 64 bits (see `fits_in_int64`).
+    [[nodiscard]] std::int64_t to_int64() const;
+
+    /// @brief Converts the number into the closest double (or an infinity if it's too big).
+    [[nodiscard]] double to_double() const;
+
+    /// @brief Gets the decimal representation of the number.
+    /// Big numbers are split in two halves recursively (by powers of 10^19),
+    /// so that the conversion benefits from the fast multiplications.
+    [[nodiscard]] std::string to_string() const;
+
+    [[nodiscard]] std::strong_ordering operator<=>(const BigInteger& other) const;
+    [[nodiscard]] bool operator==(const BigInteger& other) const = default;
+
+    [[nodiscard]] BigInteger operator-() const;
+    friend BigInteger operator+(const BigInteger& a, const BigInteger& b);
+    friend BigInteger operator-(const BigInteger& a, const BigInteger& b);
+    friend BigInteger operator*(const BigInteger& a, const BigInteger& b);
+
+    /// @brief Divides two numbers, just like C++ does with native integers:
+    /// the quotient is rounded towards zero, and the remainder has the sign of the dividend.
+    /// @throw Exception if the divisor is zero.
+    static void divide(const BigInteger& a, const BigInteger& b, BigInteger& quotient, BigInteger& remainder);
+
+    /// @brief Raises the number to a power, by squaring.
+    [[nodiscard]] BigInteger pow(std::uint64_t exponent) const;
+};
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <cstdint>
+
+/// @brief Raises an integer to a non-negative power, exactly, by squaring, checking each multiplication.
+/// @param base The integer to raise.
+/// @param exponent The power, it must not be negative.
+/// @param result Receives the power, if it fits in 64 bits.
+/// @return `false` if the result doesn't fit in 64 bits.
+bool checked_power(std::int64_t base, std::int64_t exponent, std::int64_t& result);
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+/// @brief A read-only memory mapping of an entire file.
+/// The content is loaded lazily by the OS, page by page,
+/// instead of being copied into a buffer before being read.
+class MappedFile final {
+  const char* data = nullptr;
+  std::size_t length = 0;
+
+  public:
+    /// @brief Maps a file into memory.
+    /// @param path The path to the file.
+    /// @throw Exception if the file cannot be opened or mapped.
+    explicit MappedFile(const std::string& path);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /// @brief Gets the content of the file (empty if the file is empty).
+    [[nodiscard]] std::string_view content() const { return { data, length }; }
+};
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <span>
+#include <array>
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+/// @brief An immutable vector whose copies share their nodes (a plain radix trie, of fixed width).
+/// The elements are stored in leaves of `BRANCHING` elements, below branches of `BRANCHING` children,
+/// and the bits of an index give the child to follow at each level, so reading an element goes through log32(n) nodes.
+/// Replacing an element creates a new vector that only copies the nodes on the path to the element,
+/// all the other nodes being shared with the original vector.
+/// Copying a vector takes a constant time.
+template <typename T>
+class PersistentVector final {
+  public:
+    static constexpr unsigned int BITS = 5;
+    static constexpr std::size_t BRANCHING = std::size_t(1) << BITS;
+
+  private:
+    static constexpr std::size_t MASK = BRANCHING - 1;
+
+    // The type of a node depends on its depth, so the children aren't typed.
+    struct leaf_t { std::array<T, BRANCHING> elements{}; };
+    struct branch_t { std::array<std::shared_ptr<const void>, BRANCHING> children; };
+
+    std::shared_ptr<const void> root; // `nullptr` for an empty vector
+    std::size_t count = 0;
+    unsigned int shift = 0; // `BITS` times the number of branches between the root and the leaves
+
+    /// @brief Gets the leaf holding the element at `index`.
+    [[nodiscard]] const leaf_t& leaf_of(std::size_t index) const {
+      const void* node = root.get();
+      for (unsigned int level = shift; level > 0; level -= BITS) {
+        node = static_cast<const branch_t*>(node)->children[(index >> level) & MASK].get();
+      }
+      return *static_cast<const leaf_t*>(node);
+    }
+
+    /// @brief Copies the path from `node` to the element at `index`, and replaces the element in the copied leaf.
+    /// @param node The node at the given level.
+    /// @param level `BITS` times the number of branches below `node`.
+    static std::shared_ptr<const void> replace(const std::shared_ptr<const void>& node, unsigned int level, std::size_t index, T element) {
+      if (level == 0) {
+        const std::shared_ptr<leaf_t> leaf = std::make_shared<leaf_t>(*static_cast<const leaf_t*>(node.get()));
+        leaf->elements[index & MASK] = std::move(element);
+        return leaf;
+      }
+      const std::shared_ptr<branch_t> branch = std::make_shared<branch_t>(*static_cast<const branch_t*>(node.get()));
+      std::shared_ptr<const void>& child = branch->children[(index >> level) & MASK];
+      child = replace(child, level - BITS, index, std::move(element));
+      return branch;
+    }
+
+  public:
+    PersistentVector() = default;
+
+    /// @brief Builds a vector from contiguous elements, from the leaves up to the root.
+    explicit PersistentVector(std::span<const T> elements): count(elements.size()) {
+      if (elements.empty()) return;
+      std::vector<std::shared_ptr<const void>> level;
+      level.reserve((count + MASK) / BRANCHING);
+      for (std::size_t i = 0; i < count; i += BRANCHING) {
+        const std::shared_ptr<leaf_t> leaf = std::make_shared<leaf_t>();
+        std::copy_n(elements.begin() + i, std::min(BRANCHING, count - i), leaf->elements.begin());
+        level.push_back(leaf);
+      }
+      while (level.size() > 1) {
+        std::vector<std::shared_ptr<const void>> parents;
+        parents.reserve((level.size() + MASK) / BRANCHING);
+        for (std::size_t i = 0; i < level.size(); i += BRANCHING) {
+          const std::shared_ptr<branch_t> branch = std::make_shared<branch_t>();
+          std::move(level.begin() + i, level.begin() + std::min(i + BRANCHING, level.size()), branch->children.begin());
+          parents.push_back(branch);
+        }
+        level = std::move(parents);
+        shift += BITS;
+      }
+      root = std::move(level.front());
+    }
+
+    [[nodiscard]] std::size_t size() const { return count; }
+    [[nodiscard]] bool empty() const { return count == 0; }
+
+    /// @brief Reads an element, it must exist.
+    [[nodiscard]] const T& operator[](std::size_t index) const { return leaf_of(index).elements[index & MASK]; }
+
+    /// @brief Creates a copy of this vector with a different element.
+    /// @param index The index of the element to replace, it must be smaller than the size of the vector.
+    [[nodiscard]] PersistentVector set(std::size_t index, T element) const {
+      PersistentVector result(*this);
+      result.root = replace(root, shift, index, std::move(element));
+      return result;
+    }
+
+    /// @brief Copies the elements, in order, at the end of `output`.
+    void append_to(std::vector<T>& output) const {
+      output.reserve(output.size() + count);
+      for (std::size_t i = 0; i < count; i += BRANCHING) {
+        const leaf_t& leaf = leaf_of(i);
+        output.insert(output.end(), leaf.elements.begin(), leaf.elements.begin() + std::min(BRANCHING, count - i));
+      }
+    }
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "value.hpp"
+#include "../utils/big_integer.hpp"
+
+/// @brief An integer that doesn't fit in 64 bits.
+/// The integers are promoted to this type when an operation overflows,
+/// and the results are demoted to an IntegerValue as soon as they fit in 64 bits again,
+/// so a BigIntValue always holds an integer outside of the range of `std::int64_t`
+/// (except for the temporary values that the interpreter creates to combine the two types).
+/// For the language, it's the same type as `int`.
+class BigIntValue final: public Value {
+  public:
+    explicit BigIntValue(BigInteger v);
+
+    /// @brief Gets the actual C++ value that this class contains.
+    /// The number is shared by all the copies of this value, so it's never copied when it's read.
+    /// @return The integer that this value holds.
+    [[nodiscard]] const BigInteger& get_actual_value() const { return get_heap_data<BigInteger>(); }
+
+    /// @brief Creates the value of an integer of any size.
+    /// @return An IntegerValue if the integer fits in 64 bits, a BigIntValue otherwise.
+    static Value* make(BigInteger v);
+
+    [[nodiscard]] bool is_truthy() const override;
+    [[nodiscard]] std::string to_string() const override;
+    [[nodiscard]] BigIntValue* copy() const override;
+
+    /// @brief Transforms this value into another type.
+    /// These transformations are possible, from the BigIntValue:
+    /// - Type::INT => the same value, since it's also an `int` for the language
+    /// - Type::DOUBLE => the closest double
+    [[nodiscard]] std::unique_ptr<Value> cast(Type output_type) const override;
+
+    Value* operator+(const BigIntValue& other) const;
+    Value* operator-(const BigIntValue& other) const;
+    Value* operator*(const BigIntValue& other) const;
+    Value* operator/(const BigIntValue& other) const; // `nullptr` for a division by zero
+    Value* operator%(const BigIntValue& other) const; // `nullptr` for a division by zero
+
+    /// @brief Raises this integer to the power of `other`.
+    /// A negative exponent gives a truncated integer, just like the native integers do.
+    /// @return `nullptr` if the result would have more than `MAX_POWER_BITS` bits.
+    [[nodiscard]] Value* pow(const BigIntValue& other) const;
+
+    /// @brief The biggest number of bits that a power is allowed to produce (about 5 million digits).
+    static constexpr std::size_t MAX_POWER_BITS = 1 << 24;
+};
@@ -9,7 +9,7 @@ class BooleanValue final: public Value {
 
     /// @brief Gets the actual C++ value that this class contains.
     /// @return The bool that this value holds.
-    [[nodiscard]] bool get_actual_value() const;
+    [[nodiscard]] bool get_actual_value() const { return payload.boolean; }
 
     /// @brief Gets the default C++ value that this class should give to variables without initial value.
     /// @return The default value for a double (false).
@@ -2,7 +2,9 @@
 
 #include "value.hpp"
 #include "integer.hpp"
+#include "bigint.hpp"
 #include "double.hpp"
 #include "list.hpp"
+#include "dictionary.hpp"
 #include "string.hpp"
 #include "boolean.hpp"
\ No newline at end of file
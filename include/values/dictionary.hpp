@@ -0,0 +1,104 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <string_view>
+#include "value.hpp"
+
+/// @brief An entry of a dictionary. Its key caches its hash.
+struct dictionary_entry_t {
+  std::string key;
+  std::size_t hash;
+  std::shared_ptr<const Value> value;
+};
+
+/// @brief The heap storage of a dictionary: a Swiss table.
+/// The entries are stored in the order of their insertion, in a vector,
+/// and the table only holds their indices, in slots grouped by `GROUP_SIZE`.
+/// Each slot has a control byte, `EMPTY` or the 7 lowest bits of the hash of its key,
+/// so a lookup compares the control bytes of a whole group at once (with SSE2)
+/// and only compares the keys whose control byte matches.
+/// The hash of a key is computed once, so growing the table never hashes the keys again.
+struct dictionary_storage_t final: public heap_storage_t {
+  static constexpr std::size_t GROUP_SIZE = 16;
+  static constexpr std::int8_t EMPTY = INT8_MIN;
+
+  dictionary_storage_t() = default;
+
+  /// @brief Copies the entries and the table of another storage (copy-on-write).
+  dictionary_storage_t(const dictionary_storage_t& other);
+
+  [[nodiscard]] std::size_t size() const { return entries.size(); }
+
+  /// @brief Reads the entries, in the order of their insertion.
+  [[nodiscard]] std::span<const dictionary_entry_t> get_entries() const { return entries; }
+
+  /// @brief Finds the entry of a key.
+  /// @param hash The hash of the key (see `hash`).
+  /// @return `nullptr` if the key doesn't exist.
+  [[nodiscard]] const dictionary_entry_t* find(std::string_view key, std::size_t hash) const;
+
+  /// @brief Adds an entry, or replaces the value of an existing key (that keeps its position).
+  void insert(std::string key, std::size_t hash, std::shared_ptr<const Value> value);
+
+  static std::size_t hash(std::string_view key);
+
+  private:
+    std::vector<dictionary_entry_t> entries;
+    std::vector<std::int8_t> control; // the control byte of each slot
+    std::vector<std::uint32_t> slots; // the index of the entry of each slot
+
+    /// @brief Doubles the number of slots (at least one group), and places the entries again.
+    void grow();
+
+    /// @brief Gets the first empty slot of the probe sequence of a hash.
+    [[nodiscard]] std::size_t find_empty_slot(std::size_t hash) const;
+};
+
+/// @brief A dictionary, whose keys are strings.
+/// Its entries are stored in a storage that all the copies share (see `dictionary_storage_t`),
+/// so copying a dictionary takes a constant time,
+/// and modifying an entry copies the entries first, unless this dictionary is the only one holding them (copy-on-write).
+class DictionaryValue final: public Value {
+  /// @brief Creates a dictionary from a storage, taking its reference.
+  explicit DictionaryValue(dictionary_storage_t* storage);
+
+  [[nodiscard]] const dictionary_storage_t& get_storage() const { return *static_cast<const dictionary_storage_t*>(payload.heap); }
+
+  public:
+    /// @brief Creates an empty dictionary.
+    DictionaryValue();
+
+    /// @brief Creates a dictionary from its entries.
+    /// If a key is repeated, its last value is kept, at the position of its first occurrence.
+    explicit DictionaryValue(std::vector<std::pair<std::string, std::shared_ptr<const Value>>> entries);
+
+    [[nodiscard]] std::string to_string() const override;
+    [[nodiscard]] bool is_truthy() const override;
+    [[nodiscard]] DictionaryValue* copy() const override;
+
+    [[nodiscard]] std::size_t size() const { return get_storage().size(); }
+
+    /// @brief Reads the entries, in the order of their insertion.
+    [[nodiscard]] std::span<const dictionary_entry_t> get_entries() const { return get_storage().get_entries(); }
+
+    /// @brief Reads the value of a key, without copying it.
+    /// @return `nullptr` if the key doesn't exist.
+    [[nodiscard]] const Value* get(std::string_view key) const;
+
+    /// @brief Creates a copy of this dictionary with a new entry, or with a different value for an existing key.
+    [[nodiscard]] DictionaryValue* with_entry(std::string_view key, const Value& value) const;
+
+    /// @brief Adds an entry, or replaces the value of an existing key.
+    /// The entries are modified in place if no other dictionary shares them, otherwise they're copied first.
+    void set(std::string_view key, const Value& value);
+
+    /// @brief Transforms this value into another type.
+    /// Transforming into the same type will produce an error.
+    /// These transformations are possible, from the DictionaryValue:
+    /// - Type::INT => returns an integer with the number of entries.
+    [[nodiscard]] std::unique_ptr<Value> cast(Type output_type) const override;
+};
@@ -12,7 +12,7 @@ class DoubleValue final: public Value {
 
     /// @brief Gets the actual C++ value that this class contains.
     /// @return The number that this value holds.
-    [[nodiscard]] double get_actual_value() const;
+    [[nodiscard]] double get_actual_value() const { return payload.floating_point; }
 
     /// @brief Gets the default C++ value that this class should give to variables without initial value.
     /// @return The default value for a double (0.0).
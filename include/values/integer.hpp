@@ -7,16 +7,16 @@ class DoubleValue;
 
 class IntegerValue final: public Value {
   public:
-    explicit IntegerValue(int v);
+    explicit IntegerValue(std::int64_t v);
     IntegerValue();
 
     /// @brief Gets the actual C++ value that this class contains.
     /// @return The integer that this value holds.
-    [[nodiscard]] int get_actual_value() const;
+    [[nodiscard]] std::int64_t get_actual_value() const { return payload.integer; }
 
     /// @brief Gets the default C++ value that this class should give to variables without initial value.
     /// @return The default value for an integer (0).
-    static int get_default_value();
+    static std::int64_t get_default_value();
     
     [[nodiscard]] bool is_truthy() const override;
     [[nodiscard]] std::string to_string() const override;
@@ -26,25 +26,34 @@ class IntegerValue final: public Value {
     /// Transforming into the same type will produce an error.
     /// These transformations are possible, from the IntegerValue:
     /// - Type::DOUBLE => the actual_value but cast into a `double`
+    /// - Type::BIGINT => the same value, since a big integer is also an `int` for the language
     [[nodiscard]] std::unique_ptr<Value> cast(Type output_type) const override;
 
+    // The operations between two integers return a BigIntValue if the result overflows.
+
     // Additions
-    IntegerValue* operator+(const IntegerValue& other) const;
+    Value*        operator+(const IntegerValue& other) const;
     DoubleValue*  operator+(const DoubleValue& other) const;
 
     // Substractions
-    IntegerValue* operator-(const IntegerValue& other) const;
+    Value*        operator-(const IntegerValue& other) const;
     DoubleValue*  operator-(const DoubleValue& other) const;
 
     // Multiplications
-    IntegerValue* operator*(const IntegerValue& other) const;
+    Value*        operator*(const IntegerValue& other) const;
     DoubleValue*  operator*(const DoubleValue& other) const;
 
     // Divisions
-    IntegerValue* operator/(const IntegerValue& other) const;
+    Value*        operator/(const IntegerValue& other) const; // `nullptr` for a division by zero
     DoubleValue*  operator/(const DoubleValue& other) const;
 
     // Modulos
     IntegerValue* operator%(const IntegerValue& other) const;
     DoubleValue*  operator%(const DoubleValue& other) const;
+
+    /// @brief Raises this integer to the power of `other`, exactly, by squaring.
+    /// The result is promoted to a big integer if it doesn't fit in 64 bits.
+    /// A negative exponent gives the truncated result of `std::pow`.
+    /// @return `nullptr` if the result would be too big (see `BigIntValue::MAX_POWER_BITS`).
+    [[nodiscard]] Value* pow(const IntegerValue& other) const;
 };
@@ -1,26 +1,201 @@
 #pragma once
 
-#include <list>
+#include <mutex>
+#include <span>
+#include <vector>
+#include <variant>
+#include <cstdint>
 #include "value.hpp"
+#include "../utils/persistent_vector.hpp"
 
-using list_of_values_ptr = std::list<std::shared_ptr<const Value>>;
+using list_of_values_ptr = std::vector<std::shared_ptr<const Value>>;
 
+/// @brief The elements of a list (or of a slice), read without copying their handles.
+using list_of_values_view = std::span<const std::shared_ptr<const Value>>;
+
+namespace ListKind {
+  /// @brief How the elements of a list are stored.
+  enum Kind {
+    VALUES, // a handle per element (mixed or small lists)
+    INTEGERS, // native 64-bit integers
+    DOUBLES, // native doubles
+    BOOLEANS // one byte per boolean
+  };
+}
+
+/// @brief The heap storage of a list, its elements being contiguous.
+/// A list whose elements all have the same numeric (or boolean) type is stored unboxed,
+/// so that a large list of numbers takes 8 bytes per element (instead of a Value and a handle per element).
+/// Only the vector of its kind is filled.
+/// A slice (`list[a:b]`) doesn't have any element: it's a window on the elements of another storage,
+/// so slicing a list never copies it.
+/// A list whose elements were modified (`list[i] = x`) is persistent: its elements are in a trie
+/// that shares most of its nodes with the list it was modified from,
+/// and they're only gathered in the vector of their kind the first time they're read contiguously.
+struct list_storage_t final: public heap_storage_t {
+  /// @brief The trie of a persistent list, of the type of its kind, `std::monostate` for the other lists.
+  using trie_t = std::variant<
+    std::monostate,
+    PersistentVector<std::int64_t>,
+    PersistentVector<double>,
+    PersistentVector<std::uint8_t>,
+    PersistentVector<std::shared_ptr<const Value>>
+  >;
+
+  const ListKind::Kind kind;
+  const trie_t trie;
+
+  /// @brief The storage whose elements a slice shares, `nullptr` if this storage owns its elements.
+  /// The slice holds a reference to it, and it's never a slice itself
+  /// (a slice of a slice shares the elements of the same storage).
+  const list_storage_t* const parent = nullptr;
+  const std::size_t offset = 0; // the index of the first element of a slice in its parent
+  const std::size_t length = 0; // the number of elements of a slice or of a persistent list
+
+  /// @brief Stores the values, unboxed if they're homogeneous and if there are at least `UNBOXING_THRESHOLD` of them.
+  explicit list_storage_t(list_of_values_ptr elements);
+  explicit list_storage_t(std::vector<std::int64_t> elements);
+  explicit list_storage_t(std::vector<double> elements);
+  explicit list_storage_t(std::vector<std::uint8_t> elements);
+
+  /// @brief Creates a slice of `length` elements of `parent`, from `offset`.
+  /// It takes one reference of the parent, which must own its elements.
+  list_storage_t(const list_storage_t* parent, std::size_t offset, std::size_t length);
+
+  /// @brief Creates a persistent list.
+  /// @param kind The kind of the list, matching the type of the elements.
+  template <typename T>
+  list_storage_t(ListKind::Kind kind, PersistentVector<T> elements): kind(kind), trie(std::move(elements)), length(std::get<PersistentVector<T>>(trie).size()) {}
+
+  ~list_storage_t() override;
+
+  [[nodiscard]] bool is_slice() const { return parent != nullptr; }
+  [[nodiscard]] bool is_persistent() const { return trie.index() != 0; }
+
+  /// @brief Gets the trie of a persistent list, `T` being the type of its elements.
+  template <typename T>
+  [[nodiscard]] const PersistentVector<T>& get_trie() const { return std::get<PersistentVector<T>>(trie); }
+
+  /// @brief From this number of elements, a homogeneous list is stored unboxed.
+  /// The small lists keep their handles: unboxing them would save little memory,
+  /// and reading their elements would box them again.
+  static constexpr std::size_t UNBOXING_THRESHOLD = 16;
+
+  [[nodiscard]] std::size_t size() const;
+
+  /// @brief Reads the contiguous elements, gathering the elements of a persistent list the first time they're read.
+  /// Several threads may read the same list.
+  [[nodiscard]] std::span<const std::int64_t> get_integers() const { return window(owner().integers); }
+  [[nodiscard]] std::span<const double> get_doubles() const { return window(owner().doubles); }
+  [[nodiscard]] std::span<const std::uint8_t> get_booleans() const { return window(owner().booleans); }
+
+  /// @brief Gets a handle per element, boxing the unboxed elements the first time they're read.
+  /// A slice of handles reads the ones of its parent, a slice of unboxed elements only boxes its own elements.
+  /// Several threads may read the same list.
+  [[nodiscard]] list_of_values_view boxed() const {
+    if (kind == ListKind::VALUES) {
+      return window(owner().values);
+    }
+    std::call_once(boxing, &list_storage_t::box, this);
+    return values;
+  }
+
+  private:
+    // Only the vector of the kind of the list is filled (`values` being the boxed elements of an unboxed list)
+    mutable std::vector<std::int64_t> integers;
+    mutable std::vector<double> doubles;
+    mutable std::vector<std::uint8_t> booleans;
+    mutable list_of_values_ptr values;
+    mutable std::once_flag boxing;
+    mutable std::once_flag flattening;
+
+    void box() const;
+    void flatten() const;
+
+    /// @brief Gets the storage holding the contiguous elements, flattening it if it's persistent.
+    [[nodiscard]] const list_storage_t& owner() const {
+      const list_storage_t& storage = parent != nullptr ? *parent : *this;
+      if (storage.is_persistent()) {
+        std::call_once(storage.flattening, &list_storage_t::flatten, &storage);
+      }
+      return storage;
+    }
+
+    /// @brief Restricts the elements of the parent to the ones of a slice.
+    template <typename T>
+    [[nodiscard]] std::span<const T> window(const std::vector<T>& elements) const {
+      if (parent == nullptr || elements.empty()) return elements;
+      return std::span<const T>(elements).subspan(offset, length);
+    }
+};
+
+/// @brief An immutable list.
+/// Its elements are stored in a storage that all the copies share (see `list_storage_t`), so copying a list takes a constant time.
+/// Modifying an element produces a new list, that only copies the path to the element in a trie (see `PersistentVector`).
 class ListValue final: public Value {
-  list_of_values_ptr elements;
+  /// @brief Creates a list from a storage, taking its reference.
+  explicit ListValue(list_storage_t* storage);
+
+  [[nodiscard]] const list_storage_t& get_storage() const { return *static_cast<const list_storage_t*>(payload.heap); }
 
   public:
     explicit ListValue(list_of_values_ptr elts);
 
-    ~ListValue() override = default;
+    /// @brief Creates an unboxed list of integers, whatever its length.
+    static ListValue* from_integers(std::vector<std::int64_t> elements);
+
+    /// @brief Creates an unboxed list of doubles, whatever its length.
+    static ListValue* from_doubles(std::vector<double> elements);
 
     [[nodiscard]] std::string to_string() const override;
     [[nodiscard]] bool is_truthy() const override;
     [[nodiscard]] ListValue* copy() const override;
-    [[nodiscard]] list_of_values_ptr get_elements() const;
+
+    [[nodiscard]] ListKind::Kind get_kind() const { return get_storage().kind; }
+    [[nodiscard]] std::size_t size() const { return get_storage().size(); }
+
+    /// @brief Whether this list is a slice of another list, sharing its elements.
+    [[nodiscard]] bool is_slice() const { return get_storage().is_slice(); }
+
+    /// @brief Whether the elements of this list are in a trie, because an element was modified.
+    [[nodiscard]] bool is_persistent() const { return get_storage().is_persistent(); }
+
+    /// @brief Reads the elements of a list of integers (empty for another kind of list).
+    [[nodiscard]] std::span<const std::int64_t> get_integers() const { return get_storage().get_integers(); }
+
+    /// @brief Reads the elements of a list of doubles (empty for another kind of list).
+    [[nodiscard]] std::span<const double> get_doubles() const { return get_storage().get_doubles(); }
+
+    /// @brief Reads the elements of a list of booleans (empty for another kind of list).
+    [[nodiscard]] std::span<const std::uint8_t> get_booleans() const { return get_storage().get_booleans(); }
+
+    /// @brief Gets the elements of the list.
+    /// The elements are shared by all the copies of this value.
+    /// An unboxed list boxes its elements the first time they're read this way.
+    [[nodiscard]] list_of_values_view get_elements() const { return get_storage().boxed(); }
+
+    /// @brief Gets a copy of an element, without boxing the other ones (nor gathering the elements of a persistent list).
+    /// @param index The index of the element, it must be smaller than the size of the list.
+    [[nodiscard]] Value* get_element(std::size_t index) const;
+
+    /// @brief Creates a slice of this list, from `start` (included) to `end` (excluded).
+    /// It's a view on the elements of this list, so it takes a constant time whatever its length,
+    /// but it keeps all the elements of the list alive.
+    /// @param start The index of the first element, `start` <= `end`.
+    /// @param end The index following the last element, `end` <= size.
+    [[nodiscard]] ListValue* slice(std::size_t start, std::size_t end) const;
+
+    /// @brief Creates a copy of this list with a different element.
+    /// A large list becomes persistent, so that the next modifications only copy O(log n) elements
+    /// (the first one copies the elements into a trie, which also detaches a slice from its parent).
+    /// A list of up to `PersistentVector::BRANCHING` elements is copied instead.
+    /// @param index The index of the element to replace, it must be smaller than the size of the list.
+    /// @param element The new element.
+    [[nodiscard]] ListValue* with_element(std::size_t index, const Value& element) const;
 
     /// @brief Transforms this value into another type.
     /// Transforming into the same type will produce an error.
     /// These transformations are possible, from the ListValue:
     /// - Type::INT => returns an integer with the length of the list.
     [[nodiscard]] std::unique_ptr<Value> cast(Type output_type) const override;
-};
\ No newline at end of file
+};
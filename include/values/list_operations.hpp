@@ -0,0 +1,47 @@
+#pragma once
+
+#include "list.hpp"
+
+/// @brief The bulk operations on the lists of numbers:
+/// the reductions behind the builtins (`sum`, `min`, `max`, `mean` and `dot`)
+/// and the element-wise arithmetic (`list + list`, `list * number`).
+/// They run over the unboxed elements, a list of handles or of booleans being converted first.
+/// On x86-64, the kernels use AVX2 when the processor supports it, and scalar loops otherwise.
+/// The promotions are the same as in a binary operation:
+/// a boolean is an integer, an integer combined with a double becomes a double,
+/// and a sum or a dot product of integers that overflows becomes a big integer.
+class ListOperations final {
+  public:
+    /// @brief Adds the elements of a list (0 for an empty list).
+    /// @return `nullptr` if the list isn't only made of numbers.
+    static Value* sum(const ListValue& list);
+
+    /// @brief Gets the smallest element of a list.
+    /// @return `nullptr` if the list is empty or isn't only made of numbers.
+    static Value* min(const ListValue& list);
+
+    /// @brief Gets the biggest element of a list.
+    /// @return `nullptr` if the list is empty or isn't only made of numbers.
+    static Value* max(const ListValue& list);
+
+    /// @brief Gets the average of the elements of a list, as a double.
+    /// @return `nullptr` if the list is empty or isn't only made of numbers.
+    static Value* mean(const ListValue& list);
+
+    /// @brief Computes the dot product of two lists of the same length.
+    /// @return `nullptr` if the lists don't have the same length or aren't only made of numbers.
+    static Value* dot(const ListValue& a, const ListValue& b);
+
+    /// @brief Adds two lists of numbers of the same length, element by element.
+    /// @return `nullptr` if the kernels cannot produce the result:
+    /// the lists don't have the same length, one of them isn't only made of numbers,
+    /// or an addition of integers overflows (see `Interpreter::interpret_list_operation`).
+    static ListValue* add(const ListValue& a, const ListValue& b);
+
+    /// @brief Multiplies each element of a list of numbers by a number.
+    /// @return `nullptr` if the kernels cannot produce the result, for the same reasons as `add`.
+    static ListValue* multiply(const ListValue& list, const Value& factor);
+
+    /// @brief Whether the kernels use AVX2 on this processor.
+    static bool uses_avx2();
+};
@@ -1,17 +1,104 @@
 #pragma once
 
+#include <mutex>
+#include <vector>
+#include <string_view>
 #include "value.hpp"
 
 class IntegerValue;
+class BigIntValue;
 
+/// @brief The maximum length of a string produced by a repetition (`"ab" * 1000`), 1 GiB by default.
+/// It can be changed at compile time (`-DBK_MAX_STRING_LENGTH=...`).
+#ifndef BK_MAX_STRING_LENGTH
+#define BK_MAX_STRING_LENGTH (std::size_t(1) << 30)
+#endif
+
+/// @brief The heap storage of a string that doesn't fit in a value.
+/// It's either flat (the characters themselves),
+/// or a rope: the concatenation of two other storages,
+/// whose characters are only gathered the first time they're read.
+/// This way, appending a piece to a long string doesn't copy the string.
+struct string_storage_t final: public heap_storage_t {
+  /// @brief The concatenated strings, `nullptr` for a flat string,
+  /// and for a rope once its characters are gathered (so that they aren't kept twice).
+  /// The storage holds a reference to each of them.
+  mutable string_storage_t* left = nullptr;
+  mutable string_storage_t* right = nullptr;
+
+  const std::size_t length;
+
+  explicit string_storage_t(std::string characters);
+
+  /// @brief Creates a rope. It takes one reference of each of the concatenated storages.
+  string_storage_t(string_storage_t* left, string_storage_t* right);
+
+  ~string_storage_t() override;
+
+  /// @brief Whether the storage was created as a rope, even if its characters have been gathered since.
+  [[nodiscard]] bool is_rope() const { return rope; }
+
+  /// @brief Gets the characters of the string, gathering the characters of a rope if it's the first time they're read.
+  /// Several threads may read the same rope.
+  [[nodiscard]] std::string_view view() const {
+    if (rope) {
+      std::call_once(flattening, &string_storage_t::flatten, this);
+    }
+    return characters;
+  }
+
+  private:
+    const bool rope;
+    mutable std::once_flag flattening;
+    mutable std::string characters;
+
+    void flatten() const;
+};
+
+/// @brief An immutable string.
+/// The small strings (up to `INLINE_CAPACITY` characters) are stored directly in the value,
+/// the other ones are stored in a heap storage that all the copies share (see `string_storage_t`),
+/// so copying a string never copies its characters.
 class StringValue final: public Value {
+  /// @brief Creates a string from a storage, taking one of its references.
+  explicit StringValue(string_storage_t* storage);
+
+  [[nodiscard]] const string_storage_t& get_storage() const { return *static_cast<const string_storage_t*>(payload.heap); }
+
+  /// @brief Gets a new reference to the heap storage of this string,
+  /// creating one if the string is stored in the value.
+  [[nodiscard]] string_storage_t* share_storage() const;
+
   public:
-    explicit StringValue(const std::string& v);
+    explicit StringValue(std::string v);
     StringValue();
 
+    /// @brief The maximum length of a string stored without any heap allocation.
+    static constexpr std::size_t INLINE_CAPACITY = sizeof(payload_t::characters);
+
+    /// @brief From this length, a concatenation produces a rope instead of copying both strings.
+    static constexpr std::size_t ROPE_THRESHOLD = 256;
+
+    /// @brief The maximum length of a string produced by a repetition (see `BK_MAX_STRING_LENGTH`).
+    static constexpr std::size_t MAX_LENGTH = BK_MAX_STRING_LENGTH;
+
     /// @brief Gets the actual C++ value that this class contains.
-    /// @return The integer that this value holds.
-    [[nodiscard]] std::string get_actual_value() const;
+    /// The characters are never copied when they're read, but a rope is flattened the first time.
+    /// @return A view of the string that this value holds, valid as long as this value (or a copy of it) exists.
+    [[nodiscard]] std::string_view get_actual_value() const {
+      if (inline_length != NOT_INLINE) {
+        return { payload.characters, inline_length };
+      }
+      return get_storage().view();
+    }
+
+    /// @brief Gets the length of the string, without flattening it.
+    [[nodiscard]] std::size_t length() const {
+      return inline_length != NOT_INLINE ? inline_length : get_storage().length;
+    }
+
+    /// @brief Whether this string is a rope, whose characters are gathered the first time they're read.
+    [[nodiscard]] bool is_rope() const { return inline_length == NOT_INLINE && get_storage().is_rope(); }
 
     /// @brief Gets the default C++ value that this class should give to variables without initial value.
     /// @return The default value for a string (an empty string).
@@ -34,8 +121,24 @@ class StringValue final: public Value {
     // A concatenation will be possible with any type of value.
     StringValue* operator+(const Value& other) const;
 
+    /// @brief Concatenates two strings.
+    /// The result is a rope if it's longer than `ROPE_THRESHOLD`, a flat string otherwise.
+    static StringValue* concatenate(const StringValue& left, const StringValue& right);
+
+    /// @brief Concatenates several values at once (see ConcatNode), into a single flat string allocated once.
+    /// Just like in a binary operation, a boolean is considered as an integer.
+    /// @param parts The values to concatenate, the first one being a string.
+    static StringValue* concatenate(const std::vector<const Value*>& parts);
+
     // Multiplications
-    StringValue* operator*(const IntegerValue& other) const; // repeats the string `other` times
+    /// @brief Repeats the string `other` times.
+    /// The pattern is copied once, then the filled prefix is copied onto the rest, doubling its length each time.
+    /// @return `nullptr` if `other` is negative, or if the result would be longer than `MAX_LENGTH`.
+    StringValue* operator*(const IntegerValue& other) const;
+
+    /// @brief Repeats the string `other` times, a count beyond 64 bits only fitting in `MAX_LENGTH` if the string is empty.
+    /// @return `nullptr` if `other` is negative, or if the result would be longer than `MAX_LENGTH`.
+    StringValue* operator*(const BigIntValue& other) const;
 
     /// @brief Makes concatenation possible when a value, which is not a string, is the left operand of an addition involving a string.
     /// @param left The first operand (any other type of value than a string).
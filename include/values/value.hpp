@@ -1,32 +1,82 @@
 #pragma once
 
-#include <any>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include "value_pool.hpp"
 #include "../exceptions/undefined_behavior.hpp"
-#include "../position.hpp"
 #include "../types.hpp"
-#include "../context.hpp"
 
-// Reference of "std::any"
-// https://en.cppreference.com/w/cpp/utility/any
+/// @brief The storage of the values that don't fit in 64 bits (strings, lists, dictionaries and big integers).
+/// It's immutable, so it can be shared by all the copies of a value,
+/// and it's deallocated when the last of these copies is destroyed.
+struct heap_storage_t {
+  mutable std::atomic<unsigned int> references = 1;
+  virtual ~heap_storage_t() = default;
+};
+
+/// @brief The heap storage of a specific C++ type.
+template <typename T>
+struct heap_t final: public heap_storage_t {
+  const T data;
+  explicit heap_t(T data): data(std::move(data)) {}
+};
+
+/// @brief The actual value in C++.
+/// It's a tagged union whose tag is the type of the Value:
+/// the numbers, the booleans and the small strings are stored directly (without any heap allocation),
+/// the other types are stored in a shared heap storage.
+union payload_t {
+  std::int64_t integer;
+  double floating_point;
+  bool boolean;
+  char characters[sizeof(std::int64_t)];
+  const heap_storage_t* heap;
+};
 
 class Value {
   protected:
+    // A value doesn't hold its position in the source code nor its context,
+    // because they're only needed when an error is raised,
+    // and the engines can retrieve them from the node or the instruction that produced the value.
     const Type type;
-    std::shared_ptr<Context> context = nullptr; // TODO: is having the context in the Value that necessary?
-    Position pos_start;
-    Position pos_end;
-    std::any actual_value = nullptr;
 
-    /// @brief Gets the actual value in C++.
-    /// @return The reference to this value of type "any".
-    [[nodiscard]] const std::any* get_model() const;
+    /// @brief The length of a small string whose characters are stored directly in the payload,
+    /// or `NOT_INLINE` if the payload doesn't hold characters.
+    /// It fits in the padding that follows `type`, so it doesn't make the values any bigger.
+    std::uint8_t inline_length = NOT_INLINE;
+
+    payload_t payload;
+
+    static constexpr std::uint8_t NOT_INLINE = UINT8_MAX;
+
+    /// @brief Whether the payload of this value is stored on the heap.
+    [[nodiscard]] bool has_heap_storage() const {
+      return inline_length == NOT_INLINE && (type == STRING || type == LIST || type == DICT || type == BIGINT);
+    }
+
+    /// @brief Gets the data of the heap storage.
+    /// @tparam T The C++ type of the data (it must match the type of the value).
+    template <typename T>
+    [[nodiscard]] const T& get_heap_data() const { return static_cast<const heap_t<T>*>(payload.heap)->data; }
 
   public:
     /// @brief Creates an instance of a computed value from the program.
     /// @param t The type of this value, from the `Type` enum.
     explicit Value(const Type& t);
 
-    virtual ~Value() = default;
+    /// @brief Copies a value. The heap storage isn't copied, it's shared.
+    Value(const Value& other);
+
+    virtual ~Value();
+
+    /// @brief Allocates all the values (whatever their derived class) from the ValuePool.
+    /// @param size The size of the derived class.
+    static void* operator new(std::size_t size) { return ValuePool::allocate(size); }
+
+    /// @brief Gives the memory of a value back to the ValuePool.
+    /// Because the destructor is virtual, `size` is the size of the derived class.
+    static void operator delete(void* ptr, std::size_t size) { ValuePool::deallocate(ptr, size); }
 
     // Making it a pure virtual method is important,
     // because we want the derived classes to call their own implementation
@@ -35,32 +85,10 @@ class Value {
     // meaning that creating an instance of "Value" isn't possible
     [[nodiscard]] virtual Value* copy() const = 0;
 
-    /// @brief Sets the position of this value in the program.
-    /// @param start The starting position of this value.
-    /// @param end The ending position of this value.
-    void set_pos(const Position& start, const Position& end);
-
-    /// @brief Sets the context in which this value was created
-    /// @param ctx The context that created this value.
-    void set_ctx(const std::shared_ptr<Context>& ctx);
-
-    /// @brief Gets the shared_ptr of the context in which this value was created.
-    /// The context is not meant to be modified this way, so a const qualifier is applied to the context.
-    /// @return The constant shared pointer to the context in which this value was created.
-    std::shared_ptr<Context> get_ctx();
-
     /// @brief Gets the name of the type associated with this value.
     /// @return The name of the type.
     [[nodiscard]] Type get_type() const;
 
-    /// @brief Gets the starting position of this value.
-    /// @return The pointer to the starting position of this value.
-    [[nodiscard]] const Position* get_pos_start() const;
-
-    /// @brief Gets the ending position of this value.
-    /// @return The pointer to the ending position of this value.
-    [[nodiscard]] const Position* get_pos_end() const;
-
     /// @brief Indicates how this particular value can evaluate to true if used in a condition.
     /// @return `true` if the value can evaluate to `true` if used in a condition.
     [[nodiscard]] virtual bool is_truthy() const { return false; }
@@ -69,9 +97,6 @@ class Value {
     /// @throw UndefinedBehaviorException if "to_string()" is called on an instance of "Value"
     /// @return The string representation of this value.
     [[nodiscard]] virtual std::string to_string() const {
-      if (!actual_value.has_value()) {
-        return "null";
-      }
       throw UndefinedBehaviorException("Cannot print a value of type '" + get_type_name(get_type()) + "'");
     }
 
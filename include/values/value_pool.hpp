@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+
+// Every arithmetic operation creates a new Value and destroys its operands,
+// so going through the global allocator each time is costly.
+// The values are allocated from slabs instead: each slab is dedicated to a size class,
+// and the freed blocks are kept in a free list to be reused by the next value of the same size.
+// Define BK_NO_VALUE_POOL to use the global allocator instead (useful with sanitizers).
+
+/// @brief Statistics about the pool of the current thread.
+struct pool_stats_t {
+  /// @brief The number of values allocated by this thread that are still alive (wherever they're destroyed).
+  std::ptrdiff_t live_objects = 0;
+
+  /// @brief The number of slabs owned by this thread.
+  std::size_t slabs = 0;
+
+  /// @brief The number of allocations that reused a freed block.
+  std::size_t hits = 0;
+
+  /// @brief The number of allocations that had to carve a new block out of a slab.
+  std::size_t misses = 0;
+
+  /// @brief The proportion of allocations that reused a freed block.
+  /// @return A number between 0 and 1 (0 if nothing was allocated).
+  [[nodiscard]] double hit_rate() const {
+    return hits + misses == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(hits + misses);
+  }
+};
+
+/// @brief A thread-local allocator for the instances of Value.
+/// The pool of a thread allocates and frees its own blocks without any lock.
+/// A value may be destroyed by another thread than the one that created it:
+/// its block is then given back to the pool that owns its slab (found from the address of the block),
+/// through an atomic list that the owner empties when its own free list is empty.
+/// The slabs of a thread are released once the thread has ended and all its values have been destroyed,
+/// by whichever thread destroys the last one.
+class ValuePool final {
+  public:
+    /// @brief The size of a slab, in bytes. The slabs are aligned on their size.
+    static constexpr std::size_t SLAB_SIZE = 64 * 1024;
+
+    /// @brief The difference in bytes between two consecutive size classes.
+    static constexpr std::size_t GRANULARITY = 8;
+
+    /// @brief The number of size classes. Bigger objects go through the global allocator.
+    static constexpr std::size_t NUMBER_OF_SIZE_CLASSES = 8;
+
+    /// @brief The biggest size (in bytes) served by the pool.
+    static constexpr std::size_t MAX_SIZE = GRANULARITY * NUMBER_OF_SIZE_CLASSES;
+
+    /// @brief Allocates a block of memory for a value.
+    /// @param size The size of the value, in bytes.
+    /// @return A pointer to the block, aligned on 8 bytes.
+    static void* allocate(std::size_t size);
+
+    /// @brief Gives a block back to the pool.
+    /// @param ptr The block returned by `allocate`.
+    /// @param size The size that was given to `allocate`.
+    static void deallocate(void* ptr, std::size_t size) noexcept;
+
+    /// @brief Gets the statistics of the pool of the current thread.
+    static pool_stats_t get_stats();
+};
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include "../position.hpp"
+#include "../types.hpp"
+#include "../values/value.hpp"
+
+/// @brief Holds all the instructions the virtual machine is able to execute.
+/// The VM is stack-based: the operands are popped from the stack
+/// and the result of each instruction is pushed back onto it.
+namespace OpCode {
+    // a namespace is necessary for the same reasons as NodeType
+    enum Type {
+        PUSH_CONST, // pushes constants[arg]
+        LOAD, // pushes a copy of the variable named names[arg]
+        CHECK_DECLARE, // makes sure declarations[arg] can happen, before its initial value gets evaluated
+        DECLARE, // declares declarations[arg] (pops the initial value if there is one), pushes a copy of the stored value
+        CHECK_DEFINE, // makes sure declarations[arg] (a constant) can be defined, before its value gets evaluated
+        DEFINE, // pops the value and defines the constant declarations[arg], pushes a copy of the stored value
+        CHECK_STORE, // makes sure names[arg] can be modified, before its new value gets evaluated
+        STORE, // pops the value and modifies names[arg], pushes a copy of the stored value
+        ADD, // pops b, pops a, pushes a + b
+        SUBSTRACT, // pops b, pops a, pushes a - b
+        MULTIPLY, // pops b, pops a, pushes a * b
+        DIVIDE, // pops b, pops a, pushes a / b
+        MODULO, // pops b, pops a, pushes a % b
+        POWER, // pops b, pops a, pushes a ** b
+        CONCAT, // pops b, pops a (statically known to be a string), pushes a + b
+        JOIN, // pops arg values (the first one being a string) and pushes their concatenation
+        CALL, // pops the arguments of the built-in function arg (see Builtin::Type) and pushes its result
+        INDEX, // pops the index, pops the list, pushes a copy of the element
+        SLICE, // pops the end, pops the start, pops the list, pushes the slice
+        STORE_ELEMENT, // pops the element, pops the index and modifies the element of the list names[arg], pushes a copy of the element
+        NEGATE, // -a
+        POSITIVE, // +a
+        NOT, // not a
+        AND_JUMP, // if the top is falsy, replaces it with `false` and jumps to arg, otherwise pops it
+        OR_JUMP, // if the top is truthy, leaves it in place and jumps to arg, otherwise pops it
+        TO_BOOLEAN, // replaces the top with a boolean telling whether it's truthy (right operand of "and")
+        COPY, // replaces the top with a copy of itself (right operand of "or")
+        MAKE_LIST, // pops arg values and pushes a list made of them (in the order they were pushed)
+        MAKE_DICT, // pops arg keys and values (alternately) and pushes a dictionary made of them
+        LITERAL_OVERFLOW, // throws a TypeOverflowError for a literal that cannot be stored (arg is the type of the literal)
+        HALT // stops the execution, the result is on top of the stack
+    };
+}
+
+/// @brief Gets the name of an instruction, mostly for debugging purposes.
+/// @param op The opcode.
+/// @return Its name in uppercase.
+std::string get_opcode_name(OpCode::Type op);
+
+/// @brief A single instruction of the bytecode.
+/// The meaning of the argument depends on the opcode (an index in the constants, a jump target, etc.).
+struct instruction_t {
+  OpCode::Type op;
+  unsigned int arg;
+};
+
+/// @brief The positions in the source code of the node that produced an instruction.
+/// The virtual machine needs them to raise errors.
+struct span_t {
+  Position start;
+  Position end;
+};
+
+/// @brief Everything that's needed to declare a variable or define a constant,
+/// because an instruction can only hold a single argument.
+struct declaration_t {
+  unsigned int name; // the index of the name in `Chunk::names`
+  Type type;
+  bool has_value; // only false for "store a as int" (the variable receives the default value of its type)
+};
+
+/// @brief The tables shared by the different kinds of bytecode (stack-based and register-based).
+/// The positions are kept in a side table (`spans[i]` is the span of the instruction `i`)
+/// so that the hot loop of a VM only touches small instructions.
+class BaseChunk {
+  public:
+    std::vector<span_t> spans;
+    std::vector<std::shared_ptr<const Value>> constants;
+    std::vector<std::string> names;
+    std::vector<declaration_t> declarations;
+
+    /// @brief The span of the value given to a declaration, a definition or a modification of a variable,
+    /// keyed by the index of the instruction (DECLARE, DEFINE or STORE).
+    /// The values don't hold their positions, so they're only read when a TypeError is raised.
+    std::unordered_map<unsigned int, span_t> value_spans;
+
+    /// @brief Adds a value to the table of constants.
+    /// @param value The constant.
+    /// @return Its index in the table.
+    unsigned int add_constant(std::shared_ptr<const Value> value);
+
+    /// @brief Gets the index of a name, adding it to the table if it's not there yet.
+    /// A variable always gets the same index in a chunk, no matter how many times it's used.
+    /// @param name The name of a variable.
+    /// @return Its index in the table.
+    unsigned int resolve_name(const std::string& name);
+
+    /// @brief Adds a declaration to the table of declarations.
+    /// @return Its index in the table.
+    unsigned int add_declaration(const declaration_t& declaration);
+};
+
+/// @brief The result of the compilation of a program into bytecode for the stack-based VirtualMachine.
+class Chunk final: public BaseChunk {
+  public:
+    std::vector<instruction_t> code;
+
+    /// @brief Appends an instruction at the end of the chunk.
+    /// @param op The opcode of the instruction.
+    /// @param arg The argument of the instruction.
+    /// @param pos_start The starting position of the node that produced this instruction.
+    /// @param pos_end The ending position of the node that produced this instruction.
+    /// @return The index of the new instruction (useful to patch jumps).
+    unsigned int emit(OpCode::Type op, unsigned int arg, const Position& pos_start, const Position& pos_end);
+
+    /// @brief Gets a human-readable list of the instructions, one per line.
+    std::string disassemble() const;
+};
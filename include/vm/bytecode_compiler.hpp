@@ -0,0 +1,50 @@
+#pragma once
+
+#include "bytecode.hpp"
+#include "../nodes/compositer.hpp"
+
+/// @brief Turns the tree given by the Parser into bytecode for the virtual machine (include/vm/vm.hpp).
+/// Not to be confused with the Compiler (include/compiler.hpp) which generates ARMv7 assembly.
+/// Just like the Interpreter, it becomes the owner of the nodes
+/// and deallocates them progressively.
+class BytecodeCompiler final {
+  Chunk chunk;
+
+  BytecodeCompiler() = default;
+
+  /// @brief Emits the instructions of a node, recursively.
+  /// When the instructions of a node have been executed,
+  /// exactly one more value is on the stack: the value of the node.
+  /// @param node The node to compile.
+  void emit(std::unique_ptr<CustomNode>&& node);
+
+  void emit_ListNode(std::unique_ptr<ListNode>&&);
+  void emit_DictNode(std::unique_ptr<DictNode>&&);
+  void emit_IntegerNode(std::unique_ptr<const IntegerNode>&&);
+  void emit_DoubleNode(std::unique_ptr<const DoubleNode>&&);
+  void emit_StringNode(std::unique_ptr<const StringNode>&&);
+  void emit_BooleanNode(std::unique_ptr<const BooleanNode>&&);
+  void emit_MinusNode(std::unique_ptr<MinusNode>&&);
+  void emit_PlusNode(std::unique_ptr<PlusNode>&&);
+  void emit_NotNode(std::unique_ptr<NotNode>&&);
+  void emit_AndNode(std::unique_ptr<AndNode>&&);
+  void emit_OrNode(std::unique_ptr<OrNode>&&);
+  void emit_VarAssignmentNode(std::unique_ptr<VarAssignmentNode>&&);
+  void emit_DefineConstantNode(std::unique_ptr<DefineConstantNode>&&);
+  void emit_VarAccessNode(std::unique_ptr<VarAccessNode>&&);
+  void emit_VarModifyNode(std::unique_ptr<VarModifyNode>&&);
+  void emit_BinaryOperationNode(std::unique_ptr<BinaryOperationNode>&&);
+  void emit_ConcatNode(std::unique_ptr<ConcatNode>&&);
+  void emit_CallNode(std::unique_ptr<CallNode>&&);
+  void emit_ListAccessNode(std::unique_ptr<ListAccessNode>&&);
+  void emit_ListSliceNode(std::unique_ptr<ListSliceNode>&&);
+  void emit_ListAssignmentNode(std::unique_ptr<ListAssignmentNode>&&);
+
+  public:
+    /// @brief Compiles a program into bytecode.
+    /// The chunk doesn't depend on any context,
+    /// so it can be executed several times, in different contexts.
+    /// @param tree The program given by the Parser.
+    /// @return The chunk ready to be executed by the VirtualMachine.
+    static Chunk compile(std::unique_ptr<ListNode>&& tree);
+};
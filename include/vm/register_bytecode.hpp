@@ -0,0 +1,84 @@
+#pragma once
+
+#include "bytecode.hpp"
+
+/// @brief Holds all the instructions the register-based virtual machine is able to execute.
+/// Each instruction names its destination register (`a`) and its sources (`b` and `c`).
+/// A source is either a register or a constant (see `RK_CONSTANT`),
+/// so literals never need to be loaded before being used.
+namespace RegOpCode {
+    // a namespace is necessary for the same reasons as NodeType.
+    // The order matters: it's the order of the dispatch table of the RegisterVirtualMachine.
+    enum Type {
+        MOVE, // R(a) = RK(b)
+        LOAD, // R(a) = copy of the variable names[b]
+        CHECK_DECLARE, // makes sure declarations[b] can happen, before its initial value gets evaluated
+        DECLARE, // declares declarations[b] with RK(c) as initial value (if it has one), R(a) = copy of the stored value
+        CHECK_DEFINE, // makes sure declarations[b] (a constant) can be defined, before its value gets evaluated
+        DEFINE, // defines declarations[b] with RK(c), R(a) = copy of the stored value
+        CHECK_STORE, // makes sure names[b] can be modified, before its new value gets evaluated
+        STORE, // modifies names[b] with RK(c), R(a) = copy of the stored value
+        ADD, // R(a) = RK(b) + RK(c)
+        SUBSTRACT, // R(a) = RK(b) - RK(c)
+        MULTIPLY, // R(a) = RK(b) * RK(c)
+        DIVIDE, // R(a) = RK(b) / RK(c)
+        MODULO, // R(a) = RK(b) % RK(c)
+        POWER, // R(a) = RK(b) ** RK(c)
+        CONCAT, // R(a) = RK(b) + RK(c), with RK(b) statically known to be a string
+        JOIN, // R(a) = concatenation of the `c` registers starting at R(b) (the first one being a string)
+        CALL, // R(a) = the built-in function c (see Builtin::Type) called with its arguments, in the registers starting at R(b)
+        INDEX, // R(a) = RK(b)[RK(c)]
+        SLICE, // R(a) = R(b)[R(b+1):R(b+2)]
+        STORE_ELEMENT, // names[b][R(c)] = R(c+1), R(a) = a copy of the element (preceded by CHECK_STORE)
+        NEGATE, // R(a) = -RK(b)
+        POSITIVE, // R(a) = +RK(b)
+        NOT, // R(a) = not RK(b)
+        AND_JUMP, // if R(a) is falsy, R(a) = false and jumps to b
+        OR_JUMP, // if R(a) is truthy, leaves it in place and jumps to b
+        TO_BOOLEAN, // R(a) = whether RK(b) is truthy (right operand of "and")
+        COPY, // R(a) = copy of RK(b) (right operand of "or")
+        MAKE_LIST, // R(a) = list of the `c` registers starting at R(b)
+        MAKE_DICT, // R(a) = a dictionary made of the `c` keys and values (alternately) in the registers starting at R(b)
+        LITERAL_OVERFLOW, // throws a TypeOverflowError for a literal that cannot be stored (b is the type of the literal)
+        HALT // stops the execution, the result is in R(a)
+    };
+}
+
+/// @brief Gets the name of a register instruction, mostly for debugging purposes.
+std::string get_opcode_name(RegOpCode::Type op);
+
+/// @brief If this bit is set on a source operand, then the operand is an index in the table of constants.
+/// Otherwise it's the index of a register.
+constexpr unsigned int RK_CONSTANT = 1u << 31;
+
+/// @brief A three-address instruction: a destination and two sources.
+/// The meaning of each operand depends on the opcode.
+struct three_address_t {
+  RegOpCode::Type op;
+  unsigned int a;
+  unsigned int b;
+  unsigned int c;
+};
+
+/// @brief The result of the compilation of a program into bytecode for the RegisterVirtualMachine.
+class RegisterChunk final: public BaseChunk {
+  public:
+    std::vector<three_address_t> code;
+
+    /// @brief The number of registers the program needs.
+    unsigned int number_of_registers = 0;
+
+    /// @brief Appends an instruction at the end of the chunk.
+    /// @param op The opcode of the instruction.
+    /// @param a The first operand (usually the destination register).
+    /// @param b The second operand.
+    /// @param c The third operand.
+    /// @param pos_start The starting position of the node that produced this instruction.
+    /// @param pos_end The ending position of the node that produced this instruction.
+    /// @return The index of the new instruction (useful to patch jumps).
+    unsigned int emit(RegOpCode::Type op, unsigned int a, unsigned int b, unsigned int c, const Position& pos_start, const Position& pos_end);
+
+    /// @brief Gets a human-readable list of the instructions, one per line.
+    /// The registers are written "r0", "r1", etc. and the constants "k0", "k1", etc.
+    std::string disassemble() const;
+};
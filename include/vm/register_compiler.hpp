@@ -0,0 +1,58 @@
+#pragma once
+
+#include <optional>
+#include "register_bytecode.hpp"
+#include "../nodes/compositer.hpp"
+
+/// @brief Turns the tree given by the Parser into three-address bytecode for the RegisterVirtualMachine.
+/// The registers are virtual (there is no limit to their number),
+/// and they're allocated like a stack: a temporary register is released
+/// as soon as the instruction that needed it has been emitted.
+/// The literals are not loaded into registers, the instructions read them directly from the table of constants.
+class RegisterCompiler final {
+  RegisterChunk chunk;
+  unsigned int free_register = 0;
+
+  RegisterCompiler() = default;
+
+  /// @brief Reserves the next free register.
+  /// @return The index of the register.
+  unsigned int allocate_register();
+
+  /// @brief Emits the instructions of a node so that its value ends up in the `target` register.
+  /// @param node The node to compile.
+  /// @param target The destination register.
+  void emit_into(std::unique_ptr<CustomNode>&& node, unsigned int target);
+
+  /// @brief Emits the instructions of a node that's used as a source operand.
+  /// A literal doesn't produce any instruction: its constant is used directly.
+  /// @param node The node to compile.
+  /// @return The source operand (see RK_CONSTANT).
+  unsigned int emit_operand(std::unique_ptr<CustomNode>&& node);
+
+  /// @brief Adds the value of a literal to the table of constants.
+  /// @param node An IntegerNode, a DoubleNode, a StringNode or a BooleanNode.
+  /// @return The source operand of the constant, or `nullopt` if the literal cannot be stored (the error must be thrown at runtime).
+  std::optional<unsigned int> make_constant(const CustomNode& node);
+
+  void emit_ListNode(std::unique_ptr<ListNode>&&, unsigned int target);
+  void emit_DictNode(std::unique_ptr<DictNode>&&, unsigned int target);
+  void emit_ConcatNode(std::unique_ptr<ConcatNode>&&, unsigned int target);
+  void emit_CallNode(std::unique_ptr<CallNode>&&, unsigned int target);
+  void emit_ListAccessNode(std::unique_ptr<ListAccessNode>&&, unsigned int target);
+  void emit_ListSliceNode(std::unique_ptr<ListSliceNode>&&, unsigned int target);
+  void emit_ListAssignmentNode(std::unique_ptr<ListAssignmentNode>&&, unsigned int target);
+  void emit_UnaryNode(RegOpCode::Type op, std::unique_ptr<CustomNode>&& operand, const Position& pos_start, const Position& pos_end, unsigned int target);
+  void emit_AndNode(std::unique_ptr<AndNode>&&, unsigned int target);
+  void emit_OrNode(std::unique_ptr<OrNode>&&, unsigned int target);
+  void emit_VarAssignmentNode(std::unique_ptr<VarAssignmentNode>&&, unsigned int target);
+  void emit_DefineConstantNode(std::unique_ptr<DefineConstantNode>&&, unsigned int target);
+  void emit_VarModifyNode(std::unique_ptr<VarModifyNode>&&, unsigned int target);
+  void emit_BinaryOperationNode(std::unique_ptr<BinaryOperationNode>&&, unsigned int target);
+
+  public:
+    /// @brief Compiles a program into three-address bytecode.
+    /// @param tree The program given by the Parser.
+    /// @return The chunk ready to be executed by the RegisterVirtualMachine.
+    static RegisterChunk compile(std::unique_ptr<ListNode>&& tree);
+};
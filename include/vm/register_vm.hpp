@@ -0,0 +1,51 @@
+#pragma once
+
+#include <vector>
+#include "register_bytecode.hpp"
+#include "../runtime.hpp"
+#include "../context.hpp"
+
+// GCC and Clang support "labels as values",
+// which allows the VM to jump directly from one instruction to the next one
+// through a table of addresses (computed goto),
+// instead of going back to a single switch for every instruction.
+// Define BK_NO_COMPUTED_GOTO to force the portable switch.
+#if defined(__GNUC__) && !defined(BK_NO_COMPUTED_GOTO)
+#define BK_COMPUTED_GOTO
+#endif
+
+/// @brief The values of the variables bound from C++, indexed like the names of a chunk
+/// (`nullptr` if the variable isn't bound).
+using inputs_t = std::vector<std::shared_ptr<const Value>>;
+
+/// @brief Executes the three-address bytecode generated by the RegisterCompiler.
+/// Just like the stack-based VirtualMachine, the semantics are shared with the Interpreter.
+class RegisterVirtualMachine final {
+  const RegisterChunk& chunk;
+  const std::shared_ptr<Context>& ctx;
+  const inputs_t* inputs;
+  std::vector<std::shared_ptr<const Value>> registers;
+
+  RegisterVirtualMachine(const RegisterChunk& chunk, const std::shared_ptr<Context>& ctx, const inputs_t* inputs);
+
+  /// @brief Executes the instructions until HALT.
+  /// @return The value of the register given to HALT.
+  std::shared_ptr<const Value> execute();
+
+  /// @brief Reads a source operand, which is either a register or a constant, without taking it.
+  [[nodiscard]] const std::shared_ptr<const Value>& read(unsigned int operand) const {
+    return (operand & RK_CONSTANT) ? chunk.constants[operand & ~RK_CONSTANT] : registers[operand];
+  }
+
+  /// @brief Takes a source operand.
+  /// A temporary register is only read once, so its value is moved out of the register.
+  std::shared_ptr<const Value> take(unsigned int operand);
+
+  public:
+    /// @brief Executes a chunk of three-address bytecode in the given context.
+    /// @param chunk The chunk to execute.
+    /// @param ctx The context in which the chunk is executed.
+    /// @param inputs The variables bound from C++, which are read without going through the symbol table.
+    /// @return The result of the execution (a list containing the value of each statement of the program).
+    static RuntimeResult run(const RegisterChunk& chunk, const std::shared_ptr<Context>& ctx, const inputs_t* inputs = nullptr);
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+#include "bytecode.hpp"
+#include "../runtime.hpp"
+#include "../context.hpp"
+
+/// @brief Executes the bytecode generated by the BytecodeCompiler.
+/// It's an alternative to the Interpreter (the tree walker):
+/// the tree is compiled once into a flat array of instructions,
+/// which avoids the recursion, the dynamic casts and the allocation of a RuntimeResult per node.
+/// The semantics of the language are shared with the Interpreter
+/// (see the public methods of include/interpreter.hpp),
+/// so both engines produce the same values and throw the same errors.
+class VirtualMachine final {
+  const Chunk& chunk;
+  const std::shared_ptr<Context>& ctx;
+  std::vector<std::shared_ptr<const Value>> stack;
+
+  VirtualMachine(const Chunk& chunk, const std::shared_ptr<Context>& ctx);
+
+  /// @brief Executes the instructions until HALT.
+  /// @return The value that's on top of the stack at the end of the execution.
+  std::shared_ptr<const Value> execute();
+
+  /// @brief Pops the value on top of the stack.
+  std::shared_ptr<const Value> pop();
+
+  public:
+    /// @brief Executes a chunk of bytecode in the given context.
+    /// Unlike the Interpreter, it doesn't rely on a static context,
+    /// so several chunks can be executed at the same time in different contexts.
+    /// @param chunk The chunk to execute.
+    /// @param ctx The context in which the chunk is executed.
+    /// @return The result of the execution (a list containing the value of each statement of the program).
+    static RuntimeResult run(const Chunk& chunk, const std::shared_ptr<Context>& ctx);
+};
@@ -0,0 +1,334 @@
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+#include "../../include/batch/batch_evaluator.hpp"
+#include "../../include/parser.hpp"
+#include "../../include/utils/checked_power.hpp"
+#include "../../include/nodes/compositer.hpp"
+#include "../../include/exceptions/exception.hpp"
+#include "../../include/exceptions/runtime_error.hpp"
+#include "../../include/exceptions/type_error.hpp"
+#include "../../include/exceptions/arithmetic_error.hpp"
+#include "../../include/exceptions/type_overflow_error.hpp"
+using namespace std;
+
+// The kernels are plain loops over restricted pointers,
+// which the compiler is able to vectorize for the targeted instruction set.
+
+template <typename T, typename Op>
+static void binary_kernel(const T* __restrict a, const T* __restrict b, T* __restrict out, size_t n, Op op) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = op(a[i], b[i]);
+  }
+}
+
+template <typename T, typename R, typename Op>
+static void unary_kernel(const T* __restrict a, R* __restrict out, size_t n, Op op) {
+  for (size_t i = 0; i < n; ++i) {
+    out[i] = op(a[i]);
+  }
+}
+
+/// @brief Applies a checked integer operation to each row.
+/// The overflows are accumulated instead of breaking out of the loop, so that it stays a straight loop.
+/// @return Whether any of the operations overflowed.
+template <typename Op>
+static bool checked_kernel(const int64_t* __restrict a, const int64_t* __restrict b, int64_t* __restrict out, size_t n, Op op) {
+  bool overflow = false;
+  for (size_t i = 0; i < n; ++i) {
+    overflow |= op(a[i], b[i], &out[i]);
+  }
+  return overflow;
+}
+
+/// @brief Checks whether any row satisfies a predicate, without branching inside of the loop.
+template <typename T, typename Predicate>
+static bool any_of_rows(const T* __restrict a, const T* __restrict b, size_t n, Predicate predicate) {
+  bool found = false;
+  for (size_t i = 0; i < n; ++i) {
+    found |= predicate(a[i], b[i]);
+  }
+  return found;
+}
+
+template <typename T>
+static T* rows_of(batch_chunk_t& chunk) {
+  if constexpr (is_same_v<T, int64_t>) return chunk.integers; else return chunk.doubles;
+}
+
+template <typename T>
+static const T* rows_of(const batch_chunk_t& chunk) {
+  if constexpr (is_same_v<T, int64_t>) return chunk.integers; else return chunk.doubles;
+}
+
+template <typename T>
+static const T* rows_of(const Column& column) {
+  if constexpr (is_same_v<T, int64_t>) return column.get_integers().data(); else return column.get_doubles().data();
+}
+
+static void division_by_zero(const batch_step_t& step, const shared_ptr<Context>& ctx) {
+  throw ArithmeticError(
+    step.node->getStartingPosition(), step.node->getEndingPosition(),
+    "Division by zero isn't possible",
+    ctx
+  );
+}
+
+static void integer_overflow(const batch_step_t& step, const shared_ptr<Context>& ctx) {
+  throw TypeOverflowError(
+    step.node->getStartingPosition(), step.node->getEndingPosition(),
+    "The result of this operation is too big to be stored as an integer",
+    ctx
+  );
+}
+
+/// @brief Raises an integer to a power, like IntegerValue::pow, except that an overflow is reported instead of being promoted.
+/// @return Whether the power overflowed.
+static bool power_overflows(int64_t x, int64_t y, int64_t* r) {
+  if (y < 0) {
+    // truncated like the Interpreter, but 0 ** -n is infinite
+    const double power = std::pow(x, y);
+    *r = std::isfinite(power) ? static_cast<int64_t>(power) : 0;
+    return !std::isfinite(power);
+  }
+  return !checked_power(x, y, *r);
+}
+
+/// @brief Applies an arithmetic operation to rows of integers.
+static void apply_to_integers(const batch_step_t& step, const int64_t* a, const int64_t* b, int64_t* out, size_t n, const shared_ptr<Context>& ctx) {
+  bool overflow = false;
+  switch (step.op) {
+    case BatchOp::ADD: overflow = checked_kernel(a, b, out, n, [](int64_t x, int64_t y, int64_t* r) { return __builtin_add_overflow(x, y, r); }); break;
+    case BatchOp::SUBSTRACT: overflow = checked_kernel(a, b, out, n, [](int64_t x, int64_t y, int64_t* r) { return __builtin_sub_overflow(x, y, r); }); break;
+    case BatchOp::MULTIPLY: overflow = checked_kernel(a, b, out, n, [](int64_t x, int64_t y, int64_t* r) { return __builtin_mul_overflow(x, y, r); }); break;
+    case BatchOp::DIVIDE:
+      if (any_of_rows(b, b, n, [](int64_t y, int64_t) { return y == 0; })) division_by_zero(step, ctx);
+      overflow = any_of_rows(a, b, n, [](int64_t x, int64_t y) { return x == INT64_MIN && y == -1; });
+      if (!overflow) binary_kernel(a, b, out, n, [](int64_t x, int64_t y) { return x / y; });
+      break;
+    case BatchOp::MODULO:
+      if (any_of_rows(b, b, n, [](int64_t y, int64_t) { return y == 0; })) division_by_zero(step, ctx);
+      // the smallest integer % -1 traps on some CPUs
+      binary_kernel(a, b, out, n, [](int64_t x, int64_t y) { return y == -1 ? 0 : x % y; });
+      break;
+    case BatchOp::POWER: overflow = checked_kernel(a, b, out, n, power_overflows); break;
+    case BatchOp::NEGATE:
+      overflow = any_of_rows(a, a, n, [](int64_t x, int64_t) { return x == INT64_MIN; });
+      if (!overflow) unary_kernel(a, out, n, [](int64_t x) { return -x; });
+      break;
+    case BatchOp::POSITIVE:
+      overflow = any_of_rows(a, a, n, [](int64_t x, int64_t) { return x == INT64_MIN; });
+      if (!overflow) unary_kernel(a, out, n, [](int64_t x) { return x < 0 ? -x : x; });
+      break;
+    default: break;
+  }
+  if (overflow) integer_overflow(step, ctx);
+}
+
+/// @brief Applies an arithmetic operation to rows of doubles.
+static void apply_to_doubles(const batch_step_t& step, const double* a, const double* b, double* out, size_t n, const shared_ptr<Context>& ctx) {
+  switch (step.op) {
+    case BatchOp::ADD: binary_kernel(a, b, out, n, [](double x, double y) { return x + y; }); break;
+    case BatchOp::SUBSTRACT: binary_kernel(a, b, out, n, [](double x, double y) { return x - y; }); break;
+    case BatchOp::MULTIPLY: binary_kernel(a, b, out, n, [](double x, double y) { return x * y; }); break;
+    case BatchOp::DIVIDE:
+      if (any_of_rows(b, b, n, [](double y, double) { return y == 0.0; })) division_by_zero(step, ctx);
+      binary_kernel(a, b, out, n, [](double x, double y) { return x / y; });
+      break;
+    case BatchOp::MODULO:
+      if (any_of_rows(b, b, n, [](double y, double) { return y == 0.0; })) division_by_zero(step, ctx);
+      binary_kernel(a, b, out, n, [](double x, double y) { return std::fmod(x, y); });
+      break;
+    case BatchOp::POWER: binary_kernel(a, b, out, n, [](double x, double y) { return std::pow(x, y); }); break;
+    case BatchOp::NEGATE: unary_kernel(a, out, n, [](double x) { return -1 * x; }); break;
+    case BatchOp::POSITIVE: unary_kernel(a, out, n, [](double x) { return std::abs(x); }); break;
+    default: break;
+  }
+}
+
+BatchEvaluator::BatchEvaluator(const string& code): source("batch", code) {
+  if (code.empty()) {
+    throw Exception("Batch error", "A batch evaluation expects an expression.");
+  }
+  tree = Parser::initCLI(code, source.get_key()).parse();
+  if (tree->get_number_of_nodes() != 1) {
+    throw Exception("Batch error", "A batch evaluation expects a single expression.");
+  }
+  expression = tree->get_elements().front().get();
+  ctx = make_shared<Context>("<batch>");
+}
+
+void BatchEvaluator::bind(const string& name, shared_ptr<const Column> column) {
+  bindings[name] = move(column);
+}
+
+void BatchEvaluator::bind(const table_t& table) {
+  for (size_t i = 0; i < table.names.size(); ++i) {
+    bind(table.names[i], table.columns[i]);
+  }
+}
+
+batch_operand_t BatchEvaluator::add_step(BatchOp::Type op, Type type, const batch_operand_t& left, const batch_operand_t& right, const CustomNode& node) {
+  const auto index = static_cast<unsigned int>(steps.size());
+  steps.push_back(batch_step_t{ op, type, left, right, &node });
+  return batch_operand_t{ type, BatchSource::TEMPORARY, index };
+}
+
+batch_operand_t BatchEvaluator::promote(const batch_operand_t& operand, const CustomNode& node) {
+  if (operand.type == Type::DOUBLE) return operand;
+  return add_step(BatchOp::TO_DOUBLE, Type::DOUBLE, operand, operand, node);
+}
+
+batch_operand_t BatchEvaluator::plan(const CustomNode& node) {
+  switch (node.getNodeType()) {
+    case NodeType::INTEGER: {
+      // same limits as the Interpreter
+      int64_t value;
+      try {
+        value = stoll(static_cast<const IntegerNode&>(node).get_token().getStringValue());
+      } catch (std::out_of_range&) {
+        throw TypeOverflowError(node.getStartingPosition(), node.getEndingPosition(), "Cannot store such a big integer", ctx);
+      }
+      batch_chunk_t& constant = constants.emplace_back();
+      fill_n(constant.integers, BATCH_SIZE, value);
+      return batch_operand_t{ Type::INT, BatchSource::CONSTANT, static_cast<unsigned int>(constants.size() - 1) };
+    }
+    case NodeType::DOUBLE: {
+      double value;
+      try {
+        value = stod(static_cast<const DoubleNode&>(node).get_token().getStringValue());
+      } catch (std::out_of_range&) {
+        throw TypeOverflowError(node.getStartingPosition(), node.getEndingPosition(), "Cannot store such a big double", ctx);
+      }
+      batch_chunk_t& constant = constants.emplace_back();
+      fill_n(constant.doubles, BATCH_SIZE, value);
+      return batch_operand_t{ Type::DOUBLE, BatchSource::CONSTANT, static_cast<unsigned int>(constants.size() - 1) };
+    }
+    case NodeType::VAR_ACCESS: {
+      const string name = static_cast<const VarAccessNode&>(node).get_var_name();
+      const auto binding = bindings.find(name);
+      if (binding == bindings.end() || binding->second == nullptr) {
+        throw RuntimeError(
+          node.getStartingPosition(), node.getEndingPosition(),
+          "Undefined variable '" + name + "'.",
+          ctx
+        );
+      }
+      const Column* column = binding->second.get();
+      auto index = static_cast<unsigned int>(find(columns.begin(), columns.end(), column) - columns.begin());
+      if (index == columns.size()) {
+        columns.push_back(column);
+      }
+      return batch_operand_t{ column->get_type(), BatchSource::COLUMN, index };
+    }
+    case NodeType::NEGATIVE: {
+      const batch_operand_t operand = plan(static_cast<const MinusNode&>(node).get_node());
+      return add_step(BatchOp::NEGATE, operand.type, operand, operand, node);
+    }
+    case NodeType::POSITIVE: {
+      const batch_operand_t operand = plan(static_cast<const PlusNode&>(node).get_node());
+      return add_step(BatchOp::POSITIVE, operand.type, operand, operand, node);
+    }
+    case NodeType::ADD:
+    case NodeType::SUBSTRACT:
+    case NodeType::MULTIPLY:
+    case NodeType::DIVIDE:
+    case NodeType::MODULO:
+    case NodeType::POWER: {
+      const auto& operation = static_cast<const BinaryOperationNode&>(node);
+      batch_operand_t left = plan(operation.get_a());
+      batch_operand_t right = plan(operation.get_b());
+      if (left.type != right.type) {
+        left = promote(left, node);
+        right = promote(right, node);
+      }
+      BatchOp::Type op;
+      switch (node.getNodeType()) {
+        case NodeType::ADD: op = BatchOp::ADD; break;
+        case NodeType::SUBSTRACT: op = BatchOp::SUBSTRACT; break;
+        case NodeType::MULTIPLY: op = BatchOp::MULTIPLY; break;
+        case NodeType::DIVIDE: op = BatchOp::DIVIDE; break;
+        case NodeType::MODULO: op = BatchOp::MODULO; break;
+        default: op = BatchOp::POWER; break;
+      }
+      return add_step(op, left.type, left, right, node);
+    }
+    default:
+      throw TypeError(
+        node.getStartingPosition(), node.getEndingPosition(),
+        "This expression cannot be evaluated in a batch, only arithmetic operations on numbers are supported.",
+        ctx
+      );
+  }
+}
+
+template <typename T>
+const T* BatchEvaluator::read(const batch_operand_t& operand, size_t begin) const {
+  switch (operand.source) {
+    case BatchSource::COLUMN: return rows_of<T>(*columns[operand.index]) + begin;
+    case BatchSource::CONSTANT: return rows_of<T>(constants[operand.index]);
+    default: return rows_of<T>(temporaries[operand.index]);
+  }
+}
+
+void BatchEvaluator::execute(unsigned int index, size_t begin, size_t n) {
+  const batch_step_t& step = steps[index];
+  batch_chunk_t& result = temporaries[index];
+  if (step.op == BatchOp::TO_DOUBLE) {
+    unary_kernel(read<int64_t>(step.left, begin), result.doubles, n, [](int64_t x) { return static_cast<double>(x); });
+  } else if (step.type == Type::INT) {
+    apply_to_integers(step, read<int64_t>(step.left, begin), read<int64_t>(step.right, begin), result.integers, n, ctx);
+  } else {
+    apply_to_doubles(step, read<double>(step.left, begin), read<double>(step.right, begin), result.doubles, n, ctx);
+  }
+}
+
+void BatchEvaluator::eval(const function<void(const Column&)>& consumer) {
+  steps.clear();
+  columns.clear();
+  constants.clear();
+  root = plan(*expression);
+  temporaries.resize(steps.size());
+
+  size_t rows = 1;
+  if (!columns.empty()) {
+    rows = columns.front()->size();
+    for (const Column* column : columns) {
+      if (column->size() != rows) {
+        throw Exception("Batch error", "The columns given to a batch evaluation must have the same number of rows.");
+      }
+    }
+  }
+
+  // the same column is given to the consumer for each batch, so its capacity gets reused
+  Column batch = Column::of_type(root.type);
+  for (size_t begin = 0; begin < rows; begin += BATCH_SIZE) {
+    const size_t n = min(BATCH_SIZE, rows - begin);
+    for (unsigned int i = 0; i < steps.size(); ++i) {
+      execute(i, begin, n);
+    }
+    if (root.type == Type::INT) {
+      const int64_t* values = read<int64_t>(root, begin);
+      batch.mutable_integers().assign(values, values + n);
+    } else {
+      const double* values = read<double>(root, begin);
+      batch.mutable_doubles().assign(values, values + n);
+    }
+    consumer(batch);
+  }
+}
+
+Column BatchEvaluator::eval() {
+  unique_ptr<Column> output;
+  eval([&output](const Column& batch) {
+    if (output == nullptr) {
+      output = make_unique<Column>(batch);
+    } else if (batch.get_type() == Type::INT) {
+      output->mutable_integers().insert(output->mutable_integers().end(), batch.get_integers().begin(), batch.get_integers().end());
+    } else {
+      output->mutable_doubles().insert(output->mutable_doubles().end(), batch.get_doubles().begin(), batch.get_doubles().end());
+    }
+  });
+  // Without any row, the consumer is never called, but the type of the result is still known from the plan
+  return output == nullptr ? Column::of_type(root.type) : move(*output);
+}
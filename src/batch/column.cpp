@@ -0,0 +1,29 @@
+#include "../../include/batch/column.hpp"
+#include "../../include/utils/double_to_string.hpp"
+#include "../../include/exceptions/exception.hpp"
+using namespace std;
+
+Column::Column(Type t): type(t) {}
+
+Column Column::of_type(Type type) {
+  if (type != Type::INT && type != Type::DOUBLE) {
+    throw Exception("Batch error", "A column can only hold integers or doubles, not " + get_type_name(type) + ".");
+  }
+  return Column(type);
+}
+
+Column Column::from_integers(vector<int64_t> values) {
+  Column column(Type::INT);
+  column.integers = move(values);
+  return column;
+}
+
+Column Column::from_doubles(vector<double> values) {
+  Column column(Type::DOUBLE);
+  column.doubles = move(values);
+  return column;
+}
+
+string Column::to_string(size_t row) const {
+  return type == Type::INT ? std::to_string(integers[row]) : double_to_string(doubles[row]);
+}
@@ -0,0 +1,312 @@
+#include <thread>
+#include <cstring>
+#include <cstdint>
+#include <fstream>
+#include <charconv>
+#include <algorithm>
+#include "../../include/batch/column_loader.hpp"
+#include "../../include/utils/mapped_file.hpp"
+#include "../../include/exceptions/exception.hpp"
+using namespace std;
+
+static constexpr char BINARY_MAGIC[8] = { 'B', 'K', 'C', 'O', 'L', 'U', 'M', 'N' };
+static constexpr string_view BINARY_EXTENSION = ".bkc";
+
+/// @brief Below this amount of bytes, a chunk of the CSV file isn't worth its own thread.
+static constexpr size_t MINIMUM_CHUNK_SIZE = 64 * 1024;
+
+/// @brief The values of a column parsed by a single thread.
+/// The values are stored as integers until a value that isn't an integer is found,
+/// then all of them are converted to doubles.
+struct csv_values_t {
+  std::vector<std::int64_t> integers;
+  std::vector<double> doubles;
+  bool integral = true;
+
+  void push_integer(std::int64_t value) {
+    if (integral) integers.push_back(value); else doubles.push_back(static_cast<double>(value));
+  }
+
+  void push_double(double value) {
+    if (integral) {
+      doubles.assign(integers.begin(), integers.end());
+      integers.clear();
+      integral = false;
+    }
+    doubles.push_back(value);
+  }
+};
+
+/// @brief The values parsed by a single thread.
+struct csv_chunk_t {
+  std::vector<csv_values_t> columns;
+  std::size_t rows = 0;
+  std::string error; // empty if the chunk is valid
+};
+
+static string_view trim(string_view text) {
+  const size_t first = text.find_first_not_of(" \t\r");
+  if (first == string_view::npos) return {};
+  const size_t last = text.find_last_not_of(" \t\r");
+  return text.substr(first, last - first + 1);
+}
+
+static size_t align_to_8(size_t offset) {
+  return (offset + 7) & ~static_cast<size_t>(7);
+}
+
+/// @brief Parses a number of a CSV file.
+/// @param field The trimmed text of the number.
+/// @param values Where the number is stored.
+/// @return `false` if the field isn't a number.
+static bool parse_number(string_view field, csv_values_t& values) {
+  const char* first = field.data();
+  const char* last = first + field.size();
+  if (first != last && *first == '+') ++first; // from_chars doesn't accept an explicit sign
+  if (first == last) return false;
+  int64_t integer;
+  const auto [end_of_integer, integer_error] = from_chars(first, last, integer);
+  if (integer_error == errc{} && end_of_integer == last) {
+    values.push_integer(integer);
+    return true;
+  }
+  double floating_point;
+  const auto [end_of_double, double_error] = from_chars(first, last, floating_point);
+  if (double_error == errc{} && end_of_double == last) {
+    values.push_double(floating_point);
+    return true;
+  }
+  return false;
+}
+
+/// @brief Parses complete lines of a CSV file (without the header).
+static void parse_csv_chunk(string_view text, const vector<string>& names, csv_chunk_t& chunk) {
+  const size_t number_of_columns = names.size();
+  chunk.columns.resize(number_of_columns);
+  size_t position = 0;
+  while (position < text.size()) {
+    size_t end_of_line = text.find('\n', position);
+    if (end_of_line == string_view::npos) end_of_line = text.size();
+    const string_view line = text.substr(position, end_of_line - position);
+    position = end_of_line + 1;
+    if (trim(line).empty()) continue;
+
+    size_t column = 0;
+    size_t start = 0;
+    while (true) {
+      const size_t comma = line.find(',', start);
+      const string_view field = trim(line.substr(start, comma == string_view::npos ? string_view::npos : comma - start));
+      if (column >= number_of_columns) {
+        chunk.error = "there are more values than columns";
+        return;
+      }
+      if (!parse_number(field, chunk.columns[column])) {
+        chunk.error = "'" + string(field) + "' isn't a number (column '" + names[column] + "')";
+        return;
+      }
+      ++column;
+      if (comma == string_view::npos) break;
+      start = comma + 1;
+    }
+    if (column != number_of_columns) {
+      chunk.error = "there are fewer values than columns";
+      return;
+    }
+    ++chunk.rows;
+  }
+}
+
+table_t ColumnLoader::load(const string& path) {
+  if (path.ends_with(BINARY_EXTENSION)) {
+    return load_binary(path);
+  }
+  return load_csv(path);
+}
+
+table_t ColumnLoader::load_csv(const string& path, unsigned int threads) {
+  const MappedFile file(path);
+  const string_view content = file.content();
+  if (trim(content).empty()) {
+    throw Exception("Loading error", "The file " + path + " is empty.");
+  }
+
+  const size_t end_of_header = min(content.find('\n'), content.size());
+  table_t table;
+  const string_view header = content.substr(0, end_of_header);
+  size_t start = 0;
+  while (true) {
+    const size_t comma = header.find(',', start);
+    const string_view name = trim(header.substr(start, comma == string_view::npos ? string_view::npos : comma - start));
+    if (name.empty()) {
+      throw Exception("Loading error", "The header of " + path + " contains an empty column name.");
+    }
+    table.names.emplace_back(name);
+    if (comma == string_view::npos) break;
+    start = comma + 1;
+  }
+
+  const string_view data = content.substr(min(end_of_header + 1, content.size()));
+  if (threads == 0) threads = max(1u, thread::hardware_concurrency());
+  threads = static_cast<unsigned int>(min<size_t>(threads, max<size_t>(1, data.size() / MINIMUM_CHUNK_SIZE)));
+
+  // Each chunk ends right after a line break, so that no line is split between two threads
+  vector<string_view> texts;
+  size_t begin = 0;
+  for (unsigned int i = 1; i <= threads && begin < data.size(); ++i) {
+    size_t end = i == threads ? data.size() : max(begin, data.size() * i / threads);
+    end = min(data.find('\n', end), data.size());
+    if (end < data.size()) ++end;
+    texts.push_back(data.substr(begin, end - begin));
+    begin = end;
+  }
+
+  vector<csv_chunk_t> chunks(texts.size());
+  vector<thread> workers;
+  for (size_t i = 1; i < texts.size(); ++i) {
+    workers.emplace_back(parse_csv_chunk, texts[i], cref(table.names), ref(chunks[i]));
+  }
+  if (!texts.empty()) parse_csv_chunk(texts[0], table.names, chunks[0]);
+  for (thread& worker : workers) {
+    worker.join();
+  }
+
+  for (const csv_chunk_t& chunk : chunks) {
+    if (!chunk.error.empty()) {
+      throw Exception("Loading error", "Invalid row " + to_string(table.rows + chunk.rows + 1) + " in " + path + ": " + chunk.error + ".");
+    }
+    table.rows += chunk.rows;
+  }
+
+  for (size_t column = 0; column < table.names.size(); ++column) {
+    const bool integral = all_of(chunks.begin(), chunks.end(), [column](const csv_chunk_t& chunk) { return chunk.columns[column].integral; });
+    Column result = Column::of_type(integral ? Type::INT : Type::DOUBLE);
+    if (integral) {
+      vector<int64_t>& integers = result.mutable_integers();
+      integers.reserve(table.rows);
+      for (const csv_chunk_t& chunk : chunks) {
+        integers.insert(integers.end(), chunk.columns[column].integers.begin(), chunk.columns[column].integers.end());
+      }
+    } else {
+      vector<double>& doubles = result.mutable_doubles();
+      doubles.reserve(table.rows);
+      for (const csv_chunk_t& chunk : chunks) {
+        const csv_values_t& values = chunk.columns[column];
+        if (values.integral) {
+          doubles.insert(doubles.end(), values.integers.begin(), values.integers.end());
+        } else {
+          doubles.insert(doubles.end(), values.doubles.begin(), values.doubles.end());
+        }
+      }
+    }
+    table.columns.push_back(make_shared<const Column>(move(result)));
+  }
+
+  return table;
+}
+
+table_t ColumnLoader::load_binary(const string& path) {
+  const MappedFile file(path);
+  const string_view content = file.content();
+  const auto invalid = [&path]() {
+    return Exception("Loading error", path + " isn't a valid binary columnar file.");
+  };
+
+  size_t offset = 0;
+  // Reads a number that may not be aligned in the file
+  const auto read = [&](auto& destination) {
+    if (offset + sizeof(destination) > content.size()) throw invalid();
+    memcpy(&destination, content.data() + offset, sizeof(destination));
+    offset += sizeof(destination);
+  };
+
+  char magic[sizeof(BINARY_MAGIC)];
+  read(magic);
+  if (memcmp(magic, BINARY_MAGIC, sizeof(BINARY_MAGIC)) != 0) throw invalid();
+  uint32_t number_of_columns;
+  uint64_t rows;
+  read(number_of_columns);
+  read(rows);
+
+  table_t table;
+  table.rows = rows;
+  vector<Type> types;
+  for (uint32_t i = 0; i < number_of_columns; ++i) {
+    uint8_t type;
+    uint16_t length;
+    read(type);
+    read(length);
+    if (type > 1 || offset + length > content.size()) throw invalid();
+    types.push_back(type == 0 ? Type::INT : Type::DOUBLE);
+    table.names.emplace_back(content.substr(offset, length));
+    offset += length;
+  }
+
+  for (const Type type : types) {
+    offset = align_to_8(offset);
+    Column column = Column::of_type(type);
+    const size_t element_size = type == Type::INT ? sizeof(int64_t) : sizeof(double);
+    // The number of rows is checked before being multiplied, so that a huge one cannot overflow the size
+    if (offset > content.size() || rows > (content.size() - offset) / element_size) throw invalid();
+    const size_t size = rows * element_size;
+    if (type == Type::INT) {
+      column.mutable_integers().resize(rows);
+      memcpy(column.mutable_integers().data(), content.data() + offset, size);
+    } else {
+      column.mutable_doubles().resize(rows);
+      memcpy(column.mutable_doubles().data(), content.data() + offset, size);
+    }
+    offset += size;
+    table.columns.push_back(make_shared<const Column>(move(column)));
+  }
+
+  return table;
+}
+
+void ColumnLoader::write_binary(const string& path, const table_t& table) {
+  ofstream file(path, ios::binary);
+  if (!file.is_open()) {
+    throw Exception("File error", "Cannot write into " + path + ".");
+  }
+
+  size_t offset = 0;
+  const auto write = [&](const void* data, size_t size) {
+    file.write(static_cast<const char*>(data), static_cast<streamsize>(size));
+    offset += size;
+  };
+  const auto pad = [&]() {
+    static constexpr char zeros[8] = {};
+    write(zeros, align_to_8(offset) - offset);
+  };
+
+  const auto number_of_columns = static_cast<uint32_t>(table.columns.size());
+  const auto rows = static_cast<uint64_t>(table.rows);
+  write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+  write(&number_of_columns, sizeof(number_of_columns));
+  write(&rows, sizeof(rows));
+  for (size_t i = 0; i < table.columns.size(); ++i) {
+    if (table.columns[i]->size() != table.rows) {
+      throw Exception("File error", "The column '" + table.names[i] + "' doesn't have " + to_string(table.rows) + " rows.");
+    }
+    if (table.names[i].size() > UINT16_MAX) {
+      throw Exception("File error", "The name of the column '" + table.names[i].substr(0, 20) + "...' is longer than " + to_string(UINT16_MAX) + " bytes.");
+    }
+    const uint8_t type = table.columns[i]->get_type() == Type::INT ? 0 : 1;
+    const auto length = static_cast<uint16_t>(table.names[i].size());
+    write(&type, sizeof(type));
+    write(&length, sizeof(length));
+    write(table.names[i].data(), length);
+  }
+
+  for (const auto& column : table.columns) {
+    pad();
+    if (column->get_type() == Type::INT) {
+      write(column->get_integers().data(), column->size() * sizeof(int64_t));
+    } else {
+      write(column->get_doubles().data(), column->size() * sizeof(double));
+    }
+  }
+
+  if (!file) {
+    throw Exception("File error", "Cannot write into " + path + ".");
+  }
+}
@@ -0,0 +1,27 @@
+#include "../include/builtins.hpp"
+using namespace std;
+
+string get_builtin_name(Builtin::Type builtin) {
+  switch (builtin) {
+    case Builtin::SUM: return "sum";
+    case Builtin::MIN: return "min";
+    case Builtin::MAX: return "max";
+    case Builtin::MEAN: return "mean";
+    case Builtin::DOT: return "dot";
+    default:
+      return "Unknown function";
+  }
+}
+
+unsigned int get_builtin_arity(Builtin::Type builtin) {
+  return builtin == Builtin::DOT ? 2 : 1;
+}
+
+optional<Builtin::Type> get_builtin_from_name(const string& name) {
+  if (name == "sum") return Builtin::SUM;
+  if (name == "min") return Builtin::MIN;
+  if (name == "max") return Builtin::MAX;
+  if (name == "mean") return Builtin::MEAN;
+  if (name == "dot") return Builtin::DOT;
+  return nullopt;
+}
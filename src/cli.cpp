@@ -7,7 +7,7 @@
 #include "../include/runtime.hpp"
 using namespace std;
 
-void cli() {
+void cli(Engine::Type engine) {
   cout << "Welcome to Banger King !" << endl;
   cout << "Write your first program below." << endl;
   cout << "Type \\q to quit at any time." << endl;
@@ -22,12 +22,12 @@ void cli() {
       break;
     }
     if (!input.starts_with("\\")) {
-      unique_ptr<const RuntimeResult> res = runLine(input, ctx);
+      unique_ptr<const RuntimeResult> res = runLine(input, ctx, engine);
       if (res == nullptr) {
         continue;
       }
-      const shared_ptr<ListValue> main_value = dynamic_pointer_cast<ListValue>(res->get_value());
-      const list<shared_ptr<const Value>> values = main_value->get_elements();
+      const ListValue* main_value = static_cast<const ListValue*>(res->get_value());
+      const list_of_values_view values = main_value->get_elements();
       if (values.size() == 1) {
         cout << values.front()->to_string() << endl;
       } else {
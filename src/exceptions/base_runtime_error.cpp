@@ -1,4 +1,3 @@
-#include "../../include/files.hpp"
 #include "../../include/exceptions/base_runtime_error.hpp"
 #include "../../include/utils/string_with_arrows.hpp"
 using namespace std;
@@ -14,8 +13,8 @@ BaseRuntimeError::BaseRuntimeError(
 string BaseRuntimeError::to_string() const {
   string result = generate_traceback();
   result += error_name + ": " + details;
-  if (!READ_FILES.contains(pos_start.get_filename())) return result;
-  result += "\n\n" + string_with_arrows(*(READ_FILES[pos_start.get_filename()]), pos_start, pos_end);
+  if (source == nullptr) return result;
+  result += "\n\n" + string_with_arrows(*source, pos_start, pos_end);
   return result;
 }
 
@@ -12,13 +12,13 @@ CustomError::CustomError(
   Position end,
   string error,
   string d
-): pos_start(move(start)), pos_end(move(end)), error_name(move(error)), details(move(d)) {}
+): pos_start(move(start)), pos_end(move(end)), error_name(move(error)), details(move(d)), source(find_source(pos_start.get_filename())) {}
 
 string CustomError::to_string() const {
   string result = error_name + ": " + details + "\n";
-  const string text = *(READ_FILES.at(pos_start.get_filename()));
-  result += "File " + pos_start.get_filename() + ", line " + std::to_string(pos_start.get_ln() + 1) + "\n\n";
-  result += string_with_arrows(text, pos_start, pos_end);
+  result += "File " + pos_start.get_filename() + ", line " + std::to_string(pos_start.get_ln() + 1);
+  if (source == nullptr) return result;
+  result += "\n\n" + string_with_arrows(*source, pos_start, pos_end);
   return result;
 }
 
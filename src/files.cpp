@@ -1,4 +1,47 @@
+#include <mutex>
+#include <atomic>
 #include "../include/files.hpp"
 using namespace std;
 
-map<string, shared_ptr<string>> READ_FILES;
\ No newline at end of file
+map<string, shared_ptr<string>> READ_FILES;
+
+/// @brief Guards READ_FILES against the programs compiled or failing on several threads.
+static mutex read_files_mutex;
+
+/// @brief Removes a source code from READ_FILES.
+/// @param key The key of the source code, empty for a moved StoredSource.
+static void forget(const string& key) {
+  if (key.empty()) return;
+  const lock_guard<mutex> lock(read_files_mutex);
+  READ_FILES.erase(key);
+}
+
+StoredSource::StoredSource(const string& kind, string source) {
+  static atomic<unsigned long long> number_of_sources = 0;
+  key = "<" + kind + " " + to_string(++number_of_sources) + ">";
+  const lock_guard<mutex> lock(read_files_mutex);
+  READ_FILES[key] = make_shared<string>(move(source));
+}
+
+StoredSource::StoredSource(StoredSource&& other) noexcept: key(move(other.key)) {
+  other.key.clear();
+}
+
+StoredSource& StoredSource::operator=(StoredSource&& other) noexcept {
+  if (this != &other) {
+    forget(key);
+    key = move(other.key);
+    other.key.clear();
+  }
+  return *this;
+}
+
+StoredSource::~StoredSource() { forget(key); }
+
+const string& StoredSource::get_key() const { return key; }
+
+shared_ptr<const string> find_source(const string& key) {
+  const lock_guard<mutex> lock(read_files_mutex);
+  const auto it = READ_FILES.find(key);
+  return it != READ_FILES.end() ? it->second : nullptr;
+}
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "../include/exceptions/runtime_error.hpp"
 #include "../include/exceptions/type_error.hpp"
 #include "../include/exceptions/type_overflow_error.hpp"
+#include "../include/values/list_operations.hpp"
 using namespace std;
 
 // Since `shared_ctx` is static,
@@ -15,31 +16,62 @@ void Interpreter::set_shared_ctx(const shared_ptr<Context>& ctx) {
   shared_ctx = ctx;
 }
 
-unique_ptr<RuntimeResult> Interpreter::visit(unique_ptr<CustomNode>&& node) {
+RuntimeResult Interpreter::visit(unique_ptr<CustomNode>&& node) {
+  if (shared_ctx == nullptr || node->getNodeType() != NodeType::LIST) {
+    return visit(*node);
+  }
+
+  // The statements of the program are deallocated one by one,
+  // as soon as they've been interpreted.
+  RuntimeResult res;
+  const list_of_nodes_ptr nodes = cast_node<ListNode>(move(node))->get_element_nodes();
+  list_of_values_ptr elements;
+  elements.reserve(nodes->size());
+  while (!nodes->empty()) {
+    shared_ptr<const Value> value = res.read(visit(*nodes->front()));
+    if (res.should_return()) return res;
+    elements.push_back(move(value));
+    nodes->pop_front();
+  }
+  res.success(make_unique<ListValue>(move(elements)));
+  return res;
+}
+
+RuntimeResult Interpreter::visit(const CustomNode& node) {
   if (shared_ctx == nullptr) {
     throw Exception("Fatal", "A context was not provided for interpretation.");
   }
-  switch (node->getNodeType()) {
-    case NodeType::LIST: return visit_ListNode(cast_node<ListNode>(move(node)));
-    case NodeType::INTEGER: return visit_IntegerNode(cast_node<IntegerNode>(move(node)));
-    case NodeType::DOUBLE: return visit_DoubleNode(cast_node<DoubleNode>(move(node)));
-    case NodeType::NEGATIVE: return visit_MinusNode(cast_node<MinusNode>(move(node)));
-    case NodeType::POSITIVE: return visit_PlusNode(cast_node<PlusNode>(move(node)));
-    case NodeType::NOT: return visit_NotNode(cast_node<NotNode>(move(node)));
-    case NodeType::AND: return visit_AndNode(cast_node<AndNode>(move(node)));
-    case NodeType::OR: return visit_OrNode(cast_node<OrNode>(move(node)));
-    case NodeType::STRING: return visit_StringNode(cast_node<StringNode>(move(node)));
-    case NodeType::VAR_ASSIGNMENT: return visit_VarAssignmentNode(cast_node<VarAssignmentNode>(move(node)));
-    case NodeType::DEFINE_CONSTANT: return visit_DefineConstantNode(cast_node<DefineConstantNode>(move(node)));
-    case NodeType::VAR_ACCESS: return visit_VarAccessNode(cast_node<VarAccessNode>(move(node)));
-    case NodeType::VAR_MODIFY: return visit_VarModifyNode(cast_node<VarModifyNode>(move(node)));
-    case NodeType::BOOLEAN: return visit_BooleanNode(cast_node<BooleanNode>(move(node)));
+  switch (node.getNodeType()) {
+    case NodeType::LIST: return visit_ListNode(static_cast<const ListNode&>(node));
+    case NodeType::DICT: return visit_DictNode(static_cast<const DictNode&>(node));
+    case NodeType::INTEGER: return visit_IntegerNode(static_cast<const IntegerNode&>(node));
+    case NodeType::DOUBLE: return visit_DoubleNode(static_cast<const DoubleNode&>(node));
+    case NodeType::NEGATIVE: return visit_MinusNode(static_cast<const MinusNode&>(node));
+    case NodeType::POSITIVE: return visit_PlusNode(static_cast<const PlusNode&>(node));
+    case NodeType::NOT: return visit_NotNode(static_cast<const NotNode&>(node));
+    case NodeType::AND: return visit_AndNode(static_cast<const AndNode&>(node));
+    case NodeType::OR: return visit_OrNode(static_cast<const OrNode&>(node));
+    case NodeType::STRING: return visit_StringNode(static_cast<const StringNode&>(node));
+    case NodeType::VAR_ASSIGNMENT: return visit_VarAssignmentNode(static_cast<const VarAssignmentNode&>(node));
+    case NodeType::DEFINE_CONSTANT: return visit_DefineConstantNode(static_cast<const DefineConstantNode&>(node));
+    case NodeType::VAR_ACCESS: return visit_VarAccessNode(static_cast<const VarAccessNode&>(node));
+    case NodeType::VAR_MODIFY: return visit_VarModifyNode(static_cast<const VarModifyNode&>(node));
+    case NodeType::BOOLEAN: return visit_BooleanNode(static_cast<const BooleanNode&>(node));
+    case NodeType::CONCAT: return visit_ConcatNode(static_cast<const ConcatNode&>(node));
+    case NodeType::CALL: return visit_CallNode(static_cast<const CallNode&>(node));
+    case NodeType::LIST_ACCESS: return visit_ListAccessNode(static_cast<const ListAccessNode&>(node));
+    case NodeType::LIST_SLICE: return visit_ListSliceNode(static_cast<const ListSliceNode&>(node));
+    case NodeType::LIST_ASSIGNMENT: return visit_ListAssignmentNode(static_cast<const ListAssignmentNode&>(node));
+    // The binary operations don't have their own visit method
+    case NodeType::ADD:
+    case NodeType::SUBSTRACT:
+    case NodeType::MULTIPLY:
+    case NodeType::DIVIDE:
+    case NodeType::MODULO:
+    case NodeType::POWER:
+      return visit_BinaryOperationNode(static_cast<const BinaryOperationNode&>(node));
     default:
-      // The binary operation doesn't have its own node type
-      if (instanceof<BinaryOperationNode>(node.get())) {
-        return visit_BinaryOperationNode(cast_node<BinaryOperationNode>(move(node)));
-      }
-      throw UndefinedBehaviorException("Unimplemented visit method for input node '" + node->to_string() + "'");
+      throw UndefinedBehaviorException("Unimplemented visit method for input node '" + node.to_string() + "'");
   }
 }
 
@@ -49,35 +81,97 @@ unique_ptr<RuntimeResult> Interpreter::visit(unique_ptr<CustomNode>&& node) {
 *
 */
 
-void Interpreter::populate(Value& value, const Position& pos_start, const Position& pos_end, const shared_ptr<Context>& ctx) {
-  value.set_pos(pos_start, pos_end);
-  value.set_ctx(ctx);
-}
-
-void Interpreter::populate(Value& value, unique_ptr<const CustomNode>&& node, const shared_ptr<Context>& ctx) {
-  value.set_pos(node->getStartingPosition(), node->getEndingPosition());
-  value.set_ctx(ctx);
+void Interpreter::illegal_operation(const CustomNode& node, const shared_ptr<Context>& ctx) {
+  throw RuntimeError(
+    node.getStartingPosition(), node.getEndingPosition(),
+    "Illegal operation",
+    ctx
+  );
 }
 
-void Interpreter::illegal_operation(unique_ptr<const CustomNode>&& node, const shared_ptr<Context>& ctx) {
+void Interpreter::illegal_operation(const Position& pos_start, const Position& pos_end, const shared_ptr<Context>& ctx) {
   throw RuntimeError(
-    node->getStartingPosition(), node->getEndingPosition(),
+    pos_start, pos_end,
     "Illegal operation",
     ctx
   );
 }
 
-void Interpreter::type_error(const shared_ptr<Value>& value, const Type& expected_type, const shared_ptr<Context>& ctx) {
-  throw TypeError(
-    *(value->get_pos_start()), *(value->get_pos_end()),
-    "Type '" + get_type_name(value->get_type()) + "' is not assignable to type '" + get_type_name(expected_type) + "'",
+void Interpreter::integer_overflow(const Position& pos_start, const Position& pos_end, const shared_ptr<Context>& ctx) {
+  throw TypeOverflowError(
+    pos_start, pos_end,
+    "The result of this operation is too big to be stored as an integer",
     ctx
   );
 }
 
-void Interpreter::make_success(const unique_ptr<RuntimeResult>& res, unique_ptr<Value>&& value, unique_ptr<const CustomNode>&& node) {
-  populate(*value, move(node), shared_ctx);
-  res->success(move(value));
+void Interpreter::string_overflow(const Position& pos_start, const Position& pos_end, const shared_ptr<Context>& ctx) {
+  throw TypeOverflowError(
+    pos_start, pos_end,
+    "The result of this operation is too long to be stored as a string (the maximum length is " + std::to_string(StringValue::MAX_LENGTH) + ")",
+    ctx
+  );
+}
+
+const ListValue& Interpreter::expect_list(const Value& value, const Position& pos_start, const Position& pos_end, const shared_ptr<Context>& ctx) {
+  if (value.get_type() != Type::LIST) {
+    throw TypeError(
+      pos_start, pos_end,
+      "Cannot read the elements of a value of type '" + get_type_name(value.get_type()) + "'",
+      ctx
+    );
+  }
+  return static_cast<const ListValue&>(value);
+}
+
+size_t Interpreter::read_index(const Value& index, const Position& pos_start, const Position& pos_end, const shared_ptr<Context>& ctx) {
+  if (index.get_type() != Type::INT) {
+    throw TypeError(
+      pos_start, pos_end,
+      "An index must be of type 'int', not '" + get_type_name(index.get_type()) + "'",
+      ctx
+    );
+  }
+  const int64_t i = static_cast<const IntegerValue&>(index).get_actual_value();
+  if (i < 0) {
+    throw RuntimeError(
+      pos_start, pos_end,
+      "An index cannot be negative (" + std::to_string(i) + ")",
+      ctx
+    );
+  }
+  return static_cast<size_t>(i);
+}
+
+string_view Interpreter::read_key(const Value& key, const Position& pos_start, const Position& pos_end, const shared_ptr<Context>& ctx) {
+  if (key.get_type() != Type::STRING) {
+    throw TypeError(
+      pos_start, pos_end,
+      "A key must be of type 'string', not '" + get_type_name(key.get_type()) + "'",
+      ctx
+    );
+  }
+  return static_cast<const StringValue&>(key).get_actual_value();
+}
+
+size_t Interpreter::read_element_index(const ListValue& list, const Value& index, const Position& pos_start, const Position& pos_end, const shared_ptr<Context>& ctx) {
+  const size_t i = read_index(index, pos_start, pos_end, ctx);
+  if (i >= list.size()) {
+    throw RuntimeError(
+      pos_start, pos_end,
+      "Index " + std::to_string(i) + " is out of range (the list has " + std::to_string(list.size()) + " elements)",
+      ctx
+    );
+  }
+  return i;
+}
+
+void Interpreter::type_error(const Value& value, const Type& expected_type, const Position& value_start, const Position& value_end, const shared_ptr<Context>& ctx) {
+  throw TypeError(
+    value_start, value_end,
+    "Type '" + get_type_name(value.get_type()) + "' is not assignable to type '" + get_type_name(expected_type) + "'",
+    ctx
+  );
 }
 
 /*
@@ -86,402 +180,742 @@ void Interpreter::make_success(const unique_ptr<RuntimeResult>& res, unique_ptr<
 *
 */
 
-unique_ptr<RuntimeResult> Interpreter::visit_ListNode(unique_ptr<ListNode>&& node) {
-  unique_ptr<RuntimeResult> res = make_unique<RuntimeResult>();
-  list<shared_ptr<const Value>> elements;
-  if (node->get_number_of_nodes() > 0) {
-    const auto nodes = node->get_element_nodes();
-    for (auto& element_node : *nodes) {
-      shared_ptr<const Value> value = res->read(visit(move(element_node)));
-      if (res->should_return()) return res;
-      elements.push_back(value);
-    }
+RuntimeResult Interpreter::visit_ListNode(const ListNode& node) {
+  RuntimeResult res;
+  list_of_values_ptr elements;
+  elements.reserve(node.get_elements().size());
+  for (const auto& element_node : node.get_elements()) {
+    shared_ptr<const Value> value = res.read(visit(*element_node));
+    if (res.should_return()) return res;
+    elements.push_back(move(value));
   }
-  unique_ptr<ListValue> list_value = make_unique<ListValue>(elements);
-  make_success(res, move(list_value), move(node));
+  unique_ptr<ListValue> list_value = make_unique<ListValue>(move(elements));
+  res.success(move(list_value));
   return res;
 }
 
-unique_ptr<RuntimeResult> Interpreter::visit_IntegerNode(unique_ptr<const IntegerNode>&& node) {
-  unique_ptr<RuntimeResult> res = make_unique<RuntimeResult>();
-  int actual_integer;
+RuntimeResult Interpreter::visit_DictNode(const DictNode& node) {
+  RuntimeResult res;
+  vector<unique_ptr<Value>> values;
+  values.reserve(node.get_entries().size());
+  for (const auto& entry_node : node.get_entries()) {
+    values.push_back(res.read(visit(*entry_node)));
+    if (res.should_return()) return res;
+  }
+  vector<const Value*> keys_and_values;
+  keys_and_values.reserve(values.size());
+  for (const auto& value : values) {
+    keys_and_values.push_back(value.get());
+  }
+  res.success(make_dictionary(keys_and_values, node.getStartingPosition(), node.getEndingPosition(), shared_ctx));
+  return res;
+}
+
+unique_ptr<Value> Interpreter::make_dictionary(const vector<const Value*>& keys_and_values, const Position& pos_start, const Position& pos_end, const shared_ptr<Context>& ctx) {
+  vector<pair<string, shared_ptr<const Value>>> entries;
+  entries.reserve(keys_and_values.size() / 2);
+  for (size_t i = 0; i < keys_and_values.size(); i += 2) {
+    entries.emplace_back(string(read_key(*keys_and_values[i], pos_start, pos_end, ctx)), shared_ptr<const Value>(keys_and_values[i + 1]->copy()));
+  }
+  return make_unique<DictionaryValue>(move(entries));
+}
+
+RuntimeResult Interpreter::visit_IntegerNode(const IntegerNode& node) {
+  RuntimeResult res;
   try {
-    actual_integer = stoi(node->get_token().getStringValue());
+    res.success(make_unique<IntegerValue>(stoll(node.get_token().getStringValue())));
   } catch (std::out_of_range&) {
-    throw TypeOverflowError(
-      node->getStartingPosition(), node->getEndingPosition(),
-      "Cannot store such a big integer",
-      shared_ctx
-    );
+    res.success(make_unique<BigIntValue>(BigInteger::from_string(node.get_token().getStringValue())));
   }
-  unique_ptr<IntegerValue> i = make_unique<IntegerValue>(actual_integer);
-  make_success(res, move(i), move(node));
   return res;
 }
 
-unique_ptr<RuntimeResult> Interpreter::visit_DoubleNode(unique_ptr<const DoubleNode>&& node) {
-  unique_ptr<RuntimeResult> res = make_unique<RuntimeResult>();
+RuntimeResult Interpreter::visit_DoubleNode(const DoubleNode& node) {
+  RuntimeResult res;
   double actual_double;
   try {
-    actual_double = stod(node->get_token().getStringValue());
+    actual_double = stod(node.get_token().getStringValue());
   } catch (std::out_of_range&) {
     throw TypeOverflowError(
-      node->getStartingPosition(), node->getEndingPosition(),
+      node.getStartingPosition(), node.getEndingPosition(),
       "Cannot store such a big double",
       shared_ctx
     );
   }
   unique_ptr<DoubleValue> d = make_unique<DoubleValue>(actual_double);
-  make_success(res, move(d), move(node));
+  res.success(move(d));
   return res;
 }
 
-unique_ptr<RuntimeResult> Interpreter::visit_MinusNode(unique_ptr<MinusNode>&& node) {
-  unique_ptr<RuntimeResult> res = make_unique<RuntimeResult>();
-  shared_ptr<const Value> value = res->read(visit(node->retrieve_node()));
-  if (res->should_return()) return res;
+RuntimeResult Interpreter::visit_MinusNode(const MinusNode& node) {
+  RuntimeResult res;
+  const unique_ptr<Value> value = res.read(visit(node.get_node()));
+  if (res.should_return()) return res;
+  res.success(interpret_negation(*value, node.getStartingPosition(), node.getEndingPosition(), shared_ctx));
+  return res;
+}
 
-  if (instanceof<IntegerValue>(value)) {
-    const shared_ptr<const IntegerValue> integer = cast_const_value<IntegerValue>(value);
-    unique_ptr<IntegerValue> negative_integer = make_unique<IntegerValue>(-1 * integer->get_actual_value());
-    make_success(res, move(negative_integer), move(node));
-    return res;
+RuntimeResult Interpreter::visit_PlusNode(const PlusNode& node) {
+  RuntimeResult res;
+  const unique_ptr<Value> value = res.read(visit(node.get_node()));
+  if (res.should_return()) return res;
+  res.success(interpret_positive(*value, node.getStartingPosition(), node.getEndingPosition(), shared_ctx));
+  return res;
+}
+
+unique_ptr<Value> Interpreter::interpret_negation(const Value& value, const Position& pos_start, const Position& pos_end, const shared_ptr<Context>& ctx) {
+  unique_ptr<Value> negative_value = nullptr;
+  if (value.get_type() == Type::INT) {
+    int64_t result;
+    if (__builtin_sub_overflow(0, static_cast<const IntegerValue&>(value).get_actual_value(), &result)) {
+      negative_value = make_unique<BigIntValue>(-BigInteger(static_cast<const IntegerValue&>(value).get_actual_value()));
+    } else {
+      negative_value = make_unique<IntegerValue>(result);
+    }
+  } else if (value.get_type() == Type::BIGINT) {
+    negative_value = unique_ptr<Value>(BigIntValue::make(-static_cast<const BigIntValue&>(value).get_actual_value()));
+  } else if (value.get_type() == Type::DOUBLE) {
+    negative_value = make_unique<DoubleValue>(-1 * static_cast<const DoubleValue&>(value).get_actual_value());
+  } else {
+    illegal_operation(pos_start, pos_end, ctx);
   }
+  return negative_value;
+}
 
-  if (instanceof<DoubleValue>(value.get())) {
-    shared_ptr<const DoubleValue> d = cast_const_value<DoubleValue>(value);
-    unique_ptr<DoubleValue> negative_double = make_unique<DoubleValue>(-1 * d->get_actual_value());
-    make_success(res, move(negative_double), move(node));
-    return res;
+unique_ptr<Value> Interpreter::interpret_positive(const Value& value, const Position& pos_start, const Position& pos_end, const shared_ptr<Context>& ctx) {
+  unique_ptr<Value> positive_value = nullptr;
+  if (value.get_type() == Type::INT) {
+    const int64_t integer = static_cast<const IntegerValue&>(value).get_actual_value();
+    if (integer == INT64_MIN) {
+      positive_value = make_unique<BigIntValue>(-BigInteger(integer));
+    } else {
+      positive_value = make_unique<IntegerValue>(abs(integer));
+    }
+  } else if (value.get_type() == Type::BIGINT) {
+    const BigInteger& integer = static_cast<const BigIntValue&>(value).get_actual_value();
+    positive_value = make_unique<BigIntValue>(integer.is_negative() ? -integer : integer);
+  } else if (value.get_type() == Type::DOUBLE) {
+    positive_value = make_unique<DoubleValue>(abs(static_cast<const DoubleValue&>(value).get_actual_value()));
+  } else {
+    illegal_operation(pos_start, pos_end, ctx);
   }
+  return positive_value;
+}
 
-  illegal_operation(move(node), shared_ctx);
-  return nullptr;
+unique_ptr<Value> Interpreter::make_concatenation(const Value& left, const Value& right, const Position&, const Position&, const shared_ptr<Context>&) {
+  return unique_ptr<StringValue>(static_cast<const StringValue&>(left) + right);
 }
 
-unique_ptr<RuntimeResult> Interpreter::visit_PlusNode(unique_ptr<PlusNode>&& node) {
-  unique_ptr<RuntimeResult> res = make_unique<RuntimeResult>();
-  shared_ptr<const Value> value = res->read(visit(node->retrieve_node()));
-  if (res->should_return()) return res;
+unique_ptr<Value> Interpreter::make_concatenation_rtl(const Value& left, const Value& right, const Position&, const Position&, const shared_ptr<Context>&) {
+  return unique_ptr<StringValue>(StringValue::make_concatenation_rtl(&left, &static_cast<const StringValue&>(right)));
+}
 
-  if (instanceof<IntegerValue>(value)) {
-    shared_ptr<const IntegerValue> integer = cast_const_value<IntegerValue>(value);
-    unique_ptr<IntegerValue> positive_integer = make_unique<IntegerValue>(abs(integer->get_actual_value()));
-    make_success(res, move(positive_integer), move(node));
-    return res;
-  } else if (instanceof<DoubleValue>(value)) {
-    shared_ptr<const DoubleValue> d = cast_const_value<DoubleValue>(value);
-    unique_ptr<DoubleValue> positive_double = make_unique<DoubleValue>(abs(d->get_actual_value()));
-    make_success(res, move(positive_double), move(node));
-    return res;
+unique_ptr<Value> Interpreter::make_list_addition(const Value& left, const Value& right, const Position& pos_start, const Position& pos_end, const shared_ptr<Context>& ctx) {
+  const ListValue& a = static_cast<const ListValue&>(left);
+  const ListValue& b = static_cast<const ListValue&>(right);
+  if (a.size() != b.size()) {
+    throw RuntimeError(
+      pos_start, pos_end,
+      "Cannot add lists of different lengths (" + std::to_string(a.size()) + " and " + std::to_string(b.size()) + ")",
+      ctx
+    );
+  }
+  if (ListValue* sum = ListOperations::add(a, b)) {
+    return unique_ptr<Value>(sum);
+  }
+  // The kernels only handle native numbers (and their overflows produce big integers here)
+  const list_of_values_view x = a.get_elements();
+  const list_of_values_view y = b.get_elements();
+  list_of_values_ptr elements;
+  elements.reserve(x.size());
+  for (size_t i = 0; i < x.size(); ++i) {
+    elements.push_back(interpret_binary_operation(NodeType::ADD, *x[i], *y[i], pos_start, pos_end, ctx));
   }
+  return make_unique<ListValue>(move(elements));
+}
+
+unique_ptr<Value> Interpreter::make_list_multiplication(const Value& left, const Value& right, const Position& pos_start, const Position& pos_end, const shared_ptr<Context>& ctx) {
+  const ListValue& list = static_cast<const ListValue&>(left);
+  if (ListValue* product = ListOperations::multiply(list, right)) {
+    return unique_ptr<Value>(product);
+  }
+  const list_of_values_view x = list.get_elements();
+  list_of_values_ptr elements;
+  elements.reserve(x.size());
+  for (const auto& element : x) {
+    elements.push_back(interpret_binary_operation(NodeType::MULTIPLY, *element, right, pos_start, pos_end, ctx));
+  }
+  return make_unique<ListValue>(move(elements));
+}
+
+unique_ptr<Value> Interpreter::make_inverted_list_multiplication(const Value& left, const Value& right, const Position& pos_start, const Position& pos_end, const shared_ptr<Context>& ctx) {
+  return make_list_multiplication(right, left, pos_start, pos_end, ctx);
+}
 
-  illegal_operation(move(node), shared_ctx);
+unique_ptr<Value> Interpreter::make_illegal_operation(const Value&, const Value&, const Position& pos_start, const Position& pos_end, const shared_ptr<Context>& ctx) {
+  illegal_operation(pos_start, pos_end, ctx);
   return nullptr;
 }
 
-unique_ptr<Value> Interpreter::interpret_addition(shared_ptr<const Value> left, shared_ptr<const Value> right, unique_ptr<const BinaryOperationNode> node) {
-  // The permutations:
-  // - int + int = int
-  // - int + double = double
-  // - double + double = double
-  // - double + int = double
-  if      (instanceof<IntegerValue>(left) && instanceof<IntegerValue>(right)) return make_addition<IntegerValue, IntegerValue>(left, right, move(node));
-  else if (instanceof<IntegerValue>(left) && instanceof<DoubleValue>(right))  return make_addition<IntegerValue, DoubleValue>(left, right, move(node));
-  else if (instanceof<DoubleValue>(left)  && instanceof<DoubleValue>(right))  return make_addition<DoubleValue, DoubleValue>(left, right, move(node));
-  else if (instanceof<DoubleValue>(left)  && instanceof<IntegerValue>(right)) return make_addition<DoubleValue, IntegerValue>(left, right, move(node));
+constexpr Interpreter::binary_operations_table_t Interpreter::make_binary_operations_table() {
+  binary_operations_table_t table{};
+  for (auto& operation : table) {
+    for (auto& row : operation) {
+      row.fill(&make_illegal_operation);
+    }
+  }
+
+  // The permutations of the arithmetic operations:
+  // - int (op) int = int
+  // - int (op) double = double
+  // - double (op) double = double
+  // - double (op) int = double
+  // The big integers only appear in operations with other big integers (see `interpret_binary_operation`).
+
+  table[NodeType::ADD][Type::INT][Type::INT] = &make_addition<IntegerValue, IntegerValue>;
+  table[NodeType::ADD][Type::INT][Type::DOUBLE] = &make_addition<IntegerValue, DoubleValue>;
+  table[NodeType::ADD][Type::DOUBLE][Type::DOUBLE] = &make_addition<DoubleValue, DoubleValue>;
+  table[NodeType::ADD][Type::DOUBLE][Type::INT] = &make_addition<DoubleValue, IntegerValue>;
+  table[NodeType::ADD][Type::BIGINT][Type::BIGINT] = &make_addition<BigIntValue, BigIntValue>;
 
   // Since concatenation is possible with any type of value,
   // it must be treated differently than the other types of additions.
-  if (instanceof<StringValue>(left)) {
-    const shared_ptr<const StringValue> a = cast_const_value<StringValue>(left);
-    unique_ptr<StringValue> concatenation = unique_ptr<StringValue>(*a + *right);
-    populate(*concatenation, move(node), shared_ctx);
-    return concatenation;
-  } else if (instanceof<StringValue>(right)) {
-    const shared_ptr<const StringValue> b = cast_const_value<StringValue>(right);
-    unique_ptr<StringValue> concatenation = unique_ptr<StringValue>(StringValue::make_concatenation_rtl(left.get(), b.get()));
-    populate(*concatenation, move(node), shared_ctx);
-    return concatenation;
-  }
-
-  illegal_operation(move(node), shared_ctx);
-  return nullptr;
-}
+  // A string on the left takes precedence over a string on the right.
+  for (int type = 0; type < NUMBER_OF_TYPES; ++type) {
+    table[NodeType::ADD][type][Type::STRING] = &make_concatenation_rtl;
+  }
+  for (int type = 0; type < NUMBER_OF_TYPES; ++type) {
+    table[NodeType::ADD][Type::STRING][type] = &make_concatenation;
+  }
 
-unique_ptr<Value> Interpreter::interpret_substraction(shared_ptr<const Value> left, shared_ptr<const Value> right, unique_ptr<const BinaryOperationNode> node) {
-  // The permutations:
-  // - int - int = int
-  // - int - double = double
-  // - double - double = double
-  // - double - int = double
-  if      (instanceof<IntegerValue>(left) && instanceof<IntegerValue>(right)) return make_substraction<IntegerValue, IntegerValue>(left, right, move(node));
-  else if (instanceof<IntegerValue>(left) && instanceof<DoubleValue>(right))  return make_substraction<IntegerValue, DoubleValue>(left, right, move(node));
-  else if (instanceof<DoubleValue>(left)  && instanceof<DoubleValue>(right))  return make_substraction<DoubleValue, DoubleValue>(left, right, move(node));
-  else if (instanceof<DoubleValue>(left)  && instanceof<IntegerValue>(right)) return make_substraction<DoubleValue, IntegerValue>(left, right, move(node));
-  
-  illegal_operation(move(node), shared_ctx);
-  return nullptr;
-}
+  table[NodeType::SUBSTRACT][Type::INT][Type::INT] = &make_substraction<IntegerValue, IntegerValue>;
+  table[NodeType::SUBSTRACT][Type::INT][Type::DOUBLE] = &make_substraction<IntegerValue, DoubleValue>;
+  table[NodeType::SUBSTRACT][Type::DOUBLE][Type::DOUBLE] = &make_substraction<DoubleValue, DoubleValue>;
+  table[NodeType::SUBSTRACT][Type::DOUBLE][Type::INT] = &make_substraction<DoubleValue, IntegerValue>;
+  table[NodeType::SUBSTRACT][Type::BIGINT][Type::BIGINT] = &make_substraction<BigIntValue, BigIntValue>;
 
-unique_ptr<Value> Interpreter::interpret_multiplication(shared_ptr<const Value> left, shared_ptr<const Value> right, unique_ptr<const BinaryOperationNode> node) {
-  // The permutations:
-  // - int * int = int
-  // - int * double = double
-  // - double * double = double
-  // - double * int = double
+  // Also:
   // - string * int = string
   // - int * string = string
-  if      (instanceof<IntegerValue>(left) && instanceof<IntegerValue>(right)) return make_multiplication<IntegerValue, IntegerValue>(left, right, move(node));
-  else if (instanceof<IntegerValue>(left) && instanceof<DoubleValue>(right))  return make_multiplication<IntegerValue, DoubleValue>(left, right, move(node));
-  else if (instanceof<DoubleValue>(left)  && instanceof<DoubleValue>(right))  return make_multiplication<DoubleValue, DoubleValue>(left, right, move(node));
-  else if (instanceof<DoubleValue>(left)  && instanceof<IntegerValue>(right)) return make_multiplication<DoubleValue, IntegerValue>(left, right, move(node));
-  else if (instanceof<StringValue>(left)  && instanceof<IntegerValue>(right)) return make_multiplication<StringValue, IntegerValue>(left, right, move(node));
-  else if (instanceof<IntegerValue>(left)  && instanceof<StringValue>(right)) return make_multiplication<StringValue, IntegerValue>(right, left, move(node)); // we inverse the operation because it comes to the same thing, but as a consequence it cannot be tested in values.test.cpp
-
-  illegal_operation(move(node), shared_ctx);
-  return nullptr;
+  // - string * bigint = string (only for an empty string, it overflows otherwise)
+  // - bigint * string = string
+  table[NodeType::MULTIPLY][Type::INT][Type::INT] = &make_multiplication<IntegerValue, IntegerValue>;
+  table[NodeType::MULTIPLY][Type::INT][Type::DOUBLE] = &make_multiplication<IntegerValue, DoubleValue>;
+  table[NodeType::MULTIPLY][Type::DOUBLE][Type::DOUBLE] = &make_multiplication<DoubleValue, DoubleValue>;
+  table[NodeType::MULTIPLY][Type::DOUBLE][Type::INT] = &make_multiplication<DoubleValue, IntegerValue>;
+  table[NodeType::MULTIPLY][Type::BIGINT][Type::BIGINT] = &make_multiplication<BigIntValue, BigIntValue>;
+  table[NodeType::MULTIPLY][Type::STRING][Type::INT] = &make_multiplication<StringValue, IntegerValue>;
+  table[NodeType::MULTIPLY][Type::INT][Type::STRING] = &make_inverted_multiplication<IntegerValue, StringValue>;
+  table[NodeType::MULTIPLY][Type::STRING][Type::BIGINT] = &make_multiplication<StringValue, BigIntValue>;
+  table[NodeType::MULTIPLY][Type::BIGINT][Type::STRING] = &make_inverted_multiplication<BigIntValue, StringValue>;
+
+  // The element-wise operations on lists:
+  // - list + list = list (of the same length)
+  // - list * number = number * list = list
+  table[NodeType::ADD][Type::LIST][Type::LIST] = &make_list_addition;
+  table[NodeType::MULTIPLY][Type::LIST][Type::INT] = &make_list_multiplication;
+  table[NodeType::MULTIPLY][Type::LIST][Type::DOUBLE] = &make_list_multiplication;
+  table[NodeType::MULTIPLY][Type::LIST][Type::BIGINT] = &make_list_multiplication;
+  table[NodeType::MULTIPLY][Type::INT][Type::LIST] = &make_inverted_list_multiplication;
+  table[NodeType::MULTIPLY][Type::DOUBLE][Type::LIST] = &make_inverted_list_multiplication;
+  table[NodeType::MULTIPLY][Type::BIGINT][Type::LIST] = &make_inverted_list_multiplication;
+
+  table[NodeType::POWER][Type::INT][Type::INT] = &make_integer_power<IntegerValue, IntegerValue>;
+  table[NodeType::POWER][Type::INT][Type::DOUBLE] = &make_power<IntegerValue, DoubleValue, DoubleValue>;
+  table[NodeType::POWER][Type::DOUBLE][Type::DOUBLE] = &make_power<DoubleValue, DoubleValue, DoubleValue>;
+  table[NodeType::POWER][Type::DOUBLE][Type::INT] = &make_power<DoubleValue, IntegerValue, DoubleValue>;
+  table[NodeType::POWER][Type::BIGINT][Type::BIGINT] = &make_integer_power<BigIntValue, BigIntValue>;
+
+  table[NodeType::DIVIDE][Type::INT][Type::INT] = &make_division<IntegerValue, IntegerValue>;
+  table[NodeType::DIVIDE][Type::INT][Type::DOUBLE] = &make_division<IntegerValue, DoubleValue>;
+  table[NodeType::DIVIDE][Type::DOUBLE][Type::DOUBLE] = &make_division<DoubleValue, DoubleValue>;
+  table[NodeType::DIVIDE][Type::DOUBLE][Type::INT] = &make_division<DoubleValue, IntegerValue>;
+  table[NodeType::DIVIDE][Type::BIGINT][Type::BIGINT] = &make_division<BigIntValue, BigIntValue>;
+
+  table[NodeType::MODULO][Type::INT][Type::INT] = &make_modulo<IntegerValue, IntegerValue>;
+  table[NodeType::MODULO][Type::INT][Type::DOUBLE] = &make_modulo<IntegerValue, DoubleValue>;
+  table[NodeType::MODULO][Type::DOUBLE][Type::DOUBLE] = &make_modulo<DoubleValue, DoubleValue>;
+  table[NodeType::MODULO][Type::DOUBLE][Type::INT] = &make_modulo<DoubleValue, IntegerValue>;
+  table[NodeType::MODULO][Type::BIGINT][Type::BIGINT] = &make_modulo<BigIntValue, BigIntValue>;
+
+  return table;
 }
 
-unique_ptr<Value> Interpreter::interpret_power(shared_ptr<const Value> left, shared_ptr<const Value> right, unique_ptr<const BinaryOperationNode> node) {
-  // The permutations:
-  // - int ** int = int
-  // - int ** double = double
-  // - double ** double = double
-  // - double ** int = double
-  if      (instanceof<IntegerValue>(left) && instanceof<IntegerValue>(right)) return make_power<IntegerValue, IntegerValue, IntegerValue>(left, right, move(node));
-  else if (instanceof<IntegerValue>(left) && instanceof<DoubleValue>(right))  return make_power<IntegerValue, DoubleValue, DoubleValue>(left, right, move(node));
-  else if (instanceof<DoubleValue>(left)  && instanceof<DoubleValue>(right))  return make_power<DoubleValue, DoubleValue, DoubleValue>(left, right, move(node));
-  else if (instanceof<DoubleValue>(left)  && instanceof<IntegerValue>(right)) return make_power<DoubleValue, IntegerValue, DoubleValue>(left, right, move(node));
+// `constinit` makes sure that the table is entirely built by the compiler
+constinit const Interpreter::binary_operations_table_t Interpreter::binary_operations = Interpreter::make_binary_operations_table();
 
-  illegal_operation(move(node), shared_ctx);
-  return nullptr;
+unique_ptr<Value> Interpreter::interpret_binary_operation(NodeType::Type op, const Value& left, const Value& right, const Position& pos_start, const Position& pos_end, const shared_ptr<Context>& ctx) {
+  // A boolean, when used in mathematical operations should be considered as an Integer.
+  // - true = 1
+  // - false = 0
+  if (left.get_type() == Type::BOOLEAN) return interpret_binary_operation(op, *left.cast(Type::INT), right, pos_start, pos_end, ctx);
+  if (right.get_type() == Type::BOOLEAN) return interpret_binary_operation(op, left, *right.cast(Type::INT), pos_start, pos_end, ctx);
+
+  // A big integer combined with a native integer promotes it,
+  // but a double takes precedence over a big integer (just like it does over an integer).
+  if (left.get_type() == Type::BIGINT || right.get_type() == Type::BIGINT) {
+    if (left.get_type() == Type::INT) return interpret_binary_operation(op, BigIntValue(BigInteger(static_cast<const IntegerValue&>(left).get_actual_value())), right, pos_start, pos_end, ctx);
+    if (right.get_type() == Type::INT) return interpret_binary_operation(op, left, BigIntValue(BigInteger(static_cast<const IntegerValue&>(right).get_actual_value())), pos_start, pos_end, ctx);
+    if (left.get_type() == Type::DOUBLE) return interpret_binary_operation(op, left, *right.cast(Type::DOUBLE), pos_start, pos_end, ctx);
+    if (right.get_type() == Type::DOUBLE) return interpret_binary_operation(op, *left.cast(Type::DOUBLE), right, pos_start, pos_end, ctx);
+  }
+
+  return binary_operations[op][left.get_type()][right.get_type()](left, right, pos_start, pos_end, ctx);
+}
+
+RuntimeResult Interpreter::visit_ConcatNode(const ConcatNode& node) {
+  RuntimeResult res;
+  vector<unique_ptr<Value>> values;
+  vector<const Value*> parts;
+  values.reserve(node.get_parts().size());
+  parts.reserve(node.get_parts().size());
+  for (const auto& part_node : node.get_parts()) {
+    unique_ptr<Value> value = res.read(visit(*part_node));
+    if (res.should_return()) return res;
+    parts.push_back(value.get());
+    values.push_back(move(value));
+  }
+  res.success(unique_ptr<StringValue>(StringValue::concatenate(parts)));
+  return res;
 }
 
-unique_ptr<Value> Interpreter::interpret_division(shared_ptr<const Value> left, shared_ptr<const Value> right, unique_ptr<const BinaryOperationNode> node) {
-  // The permutations:
-  // - int / int = int
-  // - int / double = double
-  // - double / double = double
-  // - double / int = double
-  if      (instanceof<IntegerValue>(left) && instanceof<IntegerValue>(right)) return make_division<IntegerValue, IntegerValue>(left, right, move(node));
-  else if (instanceof<IntegerValue>(left) && instanceof<DoubleValue>(right))  return make_division<IntegerValue, DoubleValue>(left, right, move(node));
-  else if (instanceof<DoubleValue>(left)  && instanceof<DoubleValue>(right))  return make_division<DoubleValue, DoubleValue>(left, right, move(node));
-  else if (instanceof<DoubleValue>(left)  && instanceof<IntegerValue>(right)) return make_division<DoubleValue, IntegerValue>(left, right, move(node));
+RuntimeResult Interpreter::visit_CallNode(const CallNode& node) {
+  RuntimeResult res;
+  vector<unique_ptr<Value>> values;
+  vector<const Value*> args;
+  values.reserve(node.get_args().size());
+  args.reserve(node.get_args().size());
+  for (const auto& arg_node : node.get_args()) {
+    unique_ptr<Value> value = res.read(visit(*arg_node));
+    if (res.should_return()) return res;
+    args.push_back(value.get());
+    values.push_back(move(value));
+  }
+  res.success(interpret_call(node.get_builtin(), args, node.getStartingPosition(), node.getEndingPosition(), shared_ctx));
+  return res;
+}
 
-  illegal_operation(move(node), shared_ctx);
-  return nullptr;
+unique_ptr<Value> Interpreter::interpret_call(Builtin::Type builtin, const vector<const Value*>& args, const Position& pos_start, const Position& pos_end, const shared_ptr<Context>& ctx) {
+  const string name = get_builtin_name(builtin);
+  for (const Value* arg : args) {
+    if (arg->get_type() != Type::LIST) {
+      throw TypeError(
+        pos_start, pos_end,
+        "The function '" + name + "' expects a list, not a value of type '" + get_type_name(arg->get_type()) + "'",
+        ctx
+      );
+    }
+  }
+
+  const ListValue& list = static_cast<const ListValue&>(*args.front());
+  if (list.size() == 0 && (builtin == Builtin::MIN || builtin == Builtin::MAX || builtin == Builtin::MEAN)) {
+    throw RuntimeError(
+      pos_start, pos_end,
+      "The function '" + name + "' cannot receive an empty list",
+      ctx
+    );
+  }
+
+  Value* result = nullptr;
+  switch (builtin) {
+    case Builtin::SUM: result = ListOperations::sum(list); break;
+    case Builtin::MIN: result = ListOperations::min(list); break;
+    case Builtin::MAX: result = ListOperations::max(list); break;
+    case Builtin::MEAN: result = ListOperations::mean(list); break;
+    case Builtin::DOT: {
+      const ListValue& other = static_cast<const ListValue&>(*args.back());
+      if (list.size() != other.size()) {
+        throw RuntimeError(
+          pos_start, pos_end,
+          "The function 'dot' expects lists of the same length (" + std::to_string(list.size()) + " and " + std::to_string(other.size()) + ")",
+          ctx
+        );
+      }
+      result = ListOperations::dot(list, other);
+      break;
+    }
+    default:
+      throw UndefinedBehaviorException("Unimplemented built-in function '" + name + "'");
+  }
+
+  if (result != nullptr) {
+    return unique_ptr<Value>(result);
+  }
+  // The kernels only handle native numbers
+  unique_ptr<Value> folded = fold_call(builtin, list, static_cast<const ListValue&>(*args.back()), pos_start, pos_end, ctx);
+  if (folded == nullptr) {
+    throw RuntimeError(
+      pos_start, pos_end,
+      "The function '" + name + "' expects a list of numbers (int, double, bool or big integer)",
+      ctx
+    );
+  }
+  return folded;
 }
 
-unique_ptr<Value> Interpreter::interpret_modulo(shared_ptr<const Value> left, shared_ptr<const Value> right, unique_ptr<const BinaryOperationNode> node) {
-  // The permutations:
-  // - int % int = int
-  // - int % double = double
-  // - double % double = double
-  // - double % int = double
-  if      (instanceof<IntegerValue>(left) && instanceof<IntegerValue>(right)) return make_modulo<IntegerValue, IntegerValue>(left, right, move(node));
-  else if (instanceof<IntegerValue>(left) && instanceof<DoubleValue>(right))  return make_modulo<IntegerValue, DoubleValue>(left, right, move(node));
-  else if (instanceof<DoubleValue>(left)  && instanceof<DoubleValue>(right))  return make_modulo<DoubleValue, DoubleValue>(left, right, move(node));
-  else if (instanceof<DoubleValue>(left)  && instanceof<IntegerValue>(right)) return make_modulo<DoubleValue, IntegerValue>(left, right, move(node));
+/// @brief Whether a value is a number that can go through the binary operations.
+static bool is_number(const Value& value) {
+  const Type type = value.get_type();
+  return type == Type::INT || type == Type::DOUBLE || type == Type::BOOLEAN || type == Type::BIGINT;
+}
 
-  illegal_operation(move(node), shared_ctx);
-  return nullptr;
+/// @brief Whether a number (an integer, a double or a big integer) is strictly negative.
+static bool is_negative(const Value& number) {
+  switch (number.get_type()) {
+    case Type::INT: return static_cast<const IntegerValue&>(number).get_actual_value() < 0;
+    case Type::DOUBLE: return static_cast<const DoubleValue&>(number).get_actual_value() < 0;
+    case Type::BIGINT: return static_cast<const BigIntValue&>(number).get_actual_value() < BigInteger(0);
+    default:
+      return false;
+  }
 }
 
-unique_ptr<RuntimeResult> Interpreter::visit_BinaryOperationNode(unique_ptr<BinaryOperationNode>&& node) {
-  unique_ptr<RuntimeResult> res = make_unique<RuntimeResult>();
-  shared_ptr<const Value> left = res->read(visit(node->retrieve_a()));
-  if (res->should_return()) return res;
-  shared_ptr<const Value> right = res->read(visit(node->retrieve_b()));
-  if (res->should_return()) return res;
+unique_ptr<Value> Interpreter::fold_call(Builtin::Type builtin, const ListValue& list, const ListValue& other, const Position& pos_start, const Position& pos_end, const shared_ptr<Context>& ctx) {
+  const list_of_values_view x = list.get_elements();
+  const list_of_values_view y = other.get_elements();
+  for (const auto& element : x) if (!is_number(*element)) return nullptr;
+  for (const auto& element : y) if (!is_number(*element)) return nullptr;
+
+  unique_ptr<Value> result;
+  switch (builtin) {
+    case Builtin::SUM:
+    case Builtin::MEAN:
+      result = make_unique<IntegerValue>(0);
+      for (const auto& element : x) {
+        result = interpret_binary_operation(NodeType::ADD, *result, *element, pos_start, pos_end, ctx);
+      }
+      if (builtin == Builtin::MEAN) {
+        const double total = result->get_type() == Type::DOUBLE
+          ? static_cast<const DoubleValue&>(*result).get_actual_value()
+          : static_cast<const DoubleValue&>(*result->cast(Type::DOUBLE)).get_actual_value();
+        result = make_unique<DoubleValue>(total / static_cast<double>(x.size()));
+      }
+      break;
+    case Builtin::MIN:
+    case Builtin::MAX: {
+      // a boolean is an integer, like in the kernels
+      const auto as_number = [](const Value& element) {
+        return element.get_type() == Type::BOOLEAN ? element.cast(Type::INT) : unique_ptr<Value>(element.copy());
+      };
+      result = as_number(*x.front());
+      for (size_t i = 1; i < x.size(); ++i) {
+        // x[i] - min < 0, or max - x[i] < 0
+        const unique_ptr<Value> difference = builtin == Builtin::MIN
+          ? interpret_binary_operation(NodeType::SUBSTRACT, *x[i], *result, pos_start, pos_end, ctx)
+          : interpret_binary_operation(NodeType::SUBSTRACT, *result, *x[i], pos_start, pos_end, ctx);
+        if (is_negative(*difference)) {
+          result = as_number(*x[i]);
+        }
+      }
+      break;
+    }
+    case Builtin::DOT:
+      result = make_unique<IntegerValue>(0);
+      for (size_t i = 0; i < x.size(); ++i) {
+        const unique_ptr<Value> product = interpret_binary_operation(NodeType::MULTIPLY, *x[i], *y[i], pos_start, pos_end, ctx);
+        result = interpret_binary_operation(NodeType::ADD, *result, *product, pos_start, pos_end, ctx);
+      }
+      break;
+    default:
+      throw UndefinedBehaviorException("Unimplemented built-in function '" + get_builtin_name(builtin) + "'");
+  }
+  return result;
+}
 
-  // A boolean, when used in mathematical operations should be considered as an Integer.
-  // - true = 1
-  // - false = 0
-  if (instanceof<BooleanValue>(left)) left = left->cast(Type::INT);
-  if (instanceof<BooleanValue>(right)) right = right->cast(Type::INT);
+RuntimeResult Interpreter::visit_ListAccessNode(const ListAccessNode& node) {
+  RuntimeResult res;
+  const unique_ptr<Value> list = res.read(visit(node.get_list()));
+  if (res.should_return()) return res;
+  const unique_ptr<Value> index = res.read(visit(node.get_index()));
+  if (res.should_return()) return res;
+  res.success(interpret_list_access(*list, *index, node.getStartingPosition(), node.getEndingPosition(), shared_ctx));
+  return res;
+}
+
+RuntimeResult Interpreter::visit_ListSliceNode(const ListSliceNode& node) {
+  RuntimeResult res;
+  const unique_ptr<Value> list = res.read(visit(node.get_list()));
+  if (res.should_return()) return res;
+  const unique_ptr<Value> start = res.read(visit(node.get_start()));
+  if (res.should_return()) return res;
+  const unique_ptr<Value> end = res.read(visit(node.get_end()));
+  if (res.should_return()) return res;
+  res.success(interpret_list_slice(*list, *start, *end, node.getStartingPosition(), node.getEndingPosition(), shared_ctx));
+  return res;
+}
+
+RuntimeResult Interpreter::visit_ListAssignmentNode(const ListAssignmentNode& node) {
+  check_variable_modification(node.get_var_name(), node.getStartingPosition(), node.getEndingPosition(), shared_ctx);
+
+  RuntimeResult res;
+  const unique_ptr<Value> index = res.read(visit(node.get_index_node()));
+  if (res.should_return()) return res;
+  const unique_ptr<Value> element = res.read(visit(node.get_value_node()));
+  if (res.should_return()) return res;
+  res.success(assign_list_element(node.get_var_name(), *index, *element, node.getStartingPosition(), node.getEndingPosition(), shared_ctx));
+  return res;
+}
+
+unique_ptr<Value> Interpreter::interpret_list_access(const Value& list, const Value& index, const Position& pos_start, const Position& pos_end, const shared_ptr<Context>& ctx) {
+  if (list.get_type() == Type::DICT) {
+    const string_view key = read_key(index, pos_start, pos_end, ctx);
+    const Value* value = static_cast<const DictionaryValue&>(list).get(key);
+    if (value == nullptr) {
+      throw RuntimeError(
+        pos_start, pos_end,
+        "The key '" + string(key) + "' doesn't exist",
+        ctx
+      );
+    }
+    return unique_ptr<Value>(value->copy());
+  }
+  const ListValue& elements = expect_list(list, pos_start, pos_end, ctx);
+  const size_t i = read_element_index(elements, index, pos_start, pos_end, ctx);
+  return unique_ptr<Value>(elements.get_element(i));
+}
+
+unique_ptr<Value> Interpreter::interpret_list_slice(const Value& list, const Value& start, const Value& end, const Position& pos_start, const Position& pos_end, const shared_ptr<Context>& ctx) {
+  const ListValue& elements = expect_list(list, pos_start, pos_end, ctx);
+  const size_t last = min(read_index(end, pos_start, pos_end, ctx), elements.size());
+  const size_t first = min(read_index(start, pos_start, pos_end, ctx), last);
+  return unique_ptr<Value>(elements.slice(first, last));
+}
+
+unique_ptr<Value> Interpreter::assign_list_element(const string& name, const Value& index, const Value& element, const Position& pos_start, const Position& pos_end, const shared_ptr<Context>& ctx) {
+  // The list is read in place, the new list being created before the old one gets released
+  SymbolTableEntry* entry = ctx->get_symbol_table()->find(name);
+  const Value& list = entry->get_value();
+  if (list.get_type() == Type::DICT) {
+    // The dictionary of the variable is modified in place, its entries being copied only if another value shares them
+    const string_view key = read_key(index, pos_start, pos_end, ctx);
+    static_cast<DictionaryValue&>(entry->get_mutable_value()).set(key, element);
+    return unique_ptr<Value>(element.copy());
+  }
+  const ListValue& elements = expect_list(list, pos_start, pos_end, ctx);
+  const size_t i = read_element_index(elements, index, pos_start, pos_end, ctx);
+  entry->overwrite_value(unique_ptr<Value>(elements.with_element(i, element)));
+  return unique_ptr<Value>(element.copy());
+}
+
+RuntimeResult Interpreter::visit_BinaryOperationNode(const BinaryOperationNode& node) {
+  RuntimeResult res;
+  const unique_ptr<Value> left = res.read(visit(node.get_a()));
+  if (res.should_return()) return res;
+  const unique_ptr<Value> right = res.read(visit(node.get_b()));
+  if (res.should_return()) return res;
+  res.success(interpret_binary_operation(node.getNodeType(), *left, *right, node.getStartingPosition(), node.getEndingPosition(), shared_ctx));
+  return res;
+}
+
+RuntimeResult Interpreter::visit_VarAssignmentNode(const VarAssignmentNode& node) {
+  // TODO: this will need to change when custom types will be possible
+  const Type node_var_type = get_type_from_name(node.get_type_name());
+  check_variable_declaration(node.get_var_name(), node_var_type, node.getStartingPosition(), node.getEndingPosition(), shared_ctx);
+
+  RuntimeResult res;
+  if (!node.has_value()) {
+    res.success(declare_variable(node.get_var_name(), node_var_type, nullptr, node.getStartingPosition(), node.getEndingPosition(), node.getStartingPosition(), node.getEndingPosition(), shared_ctx));
+    return res;
+  }
 
-  if      (instanceof<AddNode>(node))       res->success(interpret_addition(move(left), move(right), move(node)));
-  else if (instanceof<SubstractNode>(node)) res->success(interpret_substraction(move(left), move(right), move(node)));
-  else if (instanceof<MultiplyNode>(node))  res->success(interpret_multiplication(move(left), move(right), move(node)));
-  else if (instanceof<PowerNode>(node))     res->success(interpret_power(move(left), move(right), move(node)));
-  else if (instanceof<DivideNode>(node))    res->success(interpret_division(move(left), move(right), move(node)));
-  else if (instanceof<ModuloNode>(node))    res->success(interpret_modulo(move(left), move(right), move(node)));
-  else illegal_operation(move(node), shared_ctx);
+  // The value doesn't hold its positions,
+  // so they're read from its node in case the value cannot be cast into the type of the variable.
+  const CustomNode& value_node = *node.get_value_node();
+  const unique_ptr<Value> initial_value = res.read(visit(value_node));
+  if (res.should_return()) return res;
 
+  res.success(declare_variable(node.get_var_name(), node_var_type, initial_value.get(), node.getStartingPosition(), node.getEndingPosition(), value_node.getStartingPosition(), value_node.getEndingPosition(), shared_ctx));
   return res;
 }
 
-unique_ptr<RuntimeResult> Interpreter::visit_VarAssignmentNode(unique_ptr<VarAssignmentNode>&& node) {
-  const string& variable_name = node->get_var_name();
-  if (shared_ctx->get_symbol_table()->exists(variable_name)) {
+void Interpreter::check_variable_declaration(const string& name, Type type, const Position& pos_start, const Position& pos_end, const shared_ptr<Context>& ctx) {
+  if (ctx->get_symbol_table()->exists(name)) {
     throw RuntimeError(
-      node->getStartingPosition(), node->getEndingPosition(),
-      "The variable named '" + variable_name + "' already defined in the current context.",
-      shared_ctx
+      pos_start, pos_end,
+      "The variable named '" + name + "' already defined in the current context.",
+      ctx
     );
   }
 
-  // TODO: this will need to change when custom types will be possible
-  const Type node_var_type = get_type_from_name(node->get_type_name());
-  if (node_var_type == Type::ERROR_TYPE) {
+  if (type == Type::ERROR_TYPE) {
     throw TypeError(
-      node->getStartingPosition(), node->getEndingPosition(),
+      pos_start, pos_end,
       "Unknown type for variable assignment",
-      shared_ctx
+      ctx
     );
   }
+}
 
-  unique_ptr<RuntimeResult> res = make_unique<RuntimeResult>();
-  const bool has_initial_value = node->has_value(); // because "retrieve_value_node()" will change the result of this method
-  shared_ptr<Value> initial_value = has_initial_value ? res->read(visit(node->retrieve_value_node())) : nullptr;
-  if (res->should_return()) return res;
-
+unique_ptr<Value> Interpreter::declare_variable(const string& name, Type type, const Value* initial_value, const Position& pos_start, const Position& pos_end, const Position& value_start, const Position& value_end, const shared_ptr<Context>& ctx) {
+  unique_ptr<Value> value = nullptr;
   // A default value must be assigned
   // if the developer didn't set an initial value.
   // This default value will depend on the given type.
-  if (!has_initial_value) {
-    switch (node_var_type) {
-      case Type::INT: initial_value = make_shared<IntegerValue>(); break;
-      case Type::DOUBLE: initial_value = make_shared<DoubleValue>(); break;
-      case Type::STRING: initial_value = make_shared<StringValue>(); break;
+  if (initial_value == nullptr) {
+    switch (type) {
+      case Type::INT: value = make_unique<IntegerValue>(); break;
+      case Type::DOUBLE: value = make_unique<DoubleValue>(); break;
+      case Type::STRING: value = make_unique<StringValue>(); break;
       default:
         throw RuntimeError(
-          node->getStartingPosition(), node->getEndingPosition(),
-          "The variable named '" + variable_name + "' cannot receive a default value for this type.",
-          shared_ctx
+          pos_start, pos_end,
+          "The variable named '" + name + "' cannot receive a default value for this type.",
+          ctx
         );
     }
-  } else {
-    if (node_var_type != initial_value->get_type()) {
-      const shared_ptr<Value> cast_value = initial_value->cast(node_var_type);
-      if (cast_value == nullptr) {
-        type_error(
-          initial_value,
-          node_var_type,
-          shared_ctx
-        );
-      }
-      initial_value = cast_value;
+  } else if (type != initial_value->get_type()) {
+    value = initial_value->cast(type);
+    if (value == nullptr) {
+      type_error(
+        *initial_value,
+        type,
+        value_start, value_end,
+        ctx
+      );
     }
+  } else {
+    value = unique_ptr<Value>(initial_value->copy());
   }
 
-  populate(*initial_value, move(node), shared_ctx);
-  shared_ctx->get_symbol_table()->set(variable_name, unique_ptr<Value>(initial_value->copy()), false); // copy's important because the garbage collector deallocates the returning value
+  ctx->get_symbol_table()->set(name, unique_ptr<Value>(value->copy()), false); // copy's important because the garbage collector deallocates the returning value
 
-  res->success(unique_ptr<Value>(initial_value->copy()));
-  return res;
+  return value;
 }
 
-unique_ptr<RuntimeResult> Interpreter::visit_DefineConstantNode(unique_ptr<DefineConstantNode>&& node) {
+RuntimeResult Interpreter::visit_DefineConstantNode(const DefineConstantNode& node) {
   // TODO: a constant cannot be created in a nested context
+  check_constant_definition(node.get_var_name(), node.getStartingPosition(), node.getEndingPosition(), shared_ctx);
+
+  RuntimeResult res;
+  const CustomNode& value_node = node.get_value_node();
+  const unique_ptr<Value> value = res.read(visit(value_node));
+  if (res.should_return()) return res;
+
+  res.success(define_constant(node.get_var_name(), node.get_type(), *value, value_node.getStartingPosition(), value_node.getEndingPosition(), shared_ctx));
+  return res;
+}
 
-  const string& variable_name = node->get_var_name();
-  if (shared_ctx->get_symbol_table()->exists(variable_name)) {
+void Interpreter::check_constant_definition(const string& name, const Position& pos_start, const Position& pos_end, const shared_ptr<Context>& ctx) {
+  if (ctx->get_symbol_table()->exists(name)) {
     throw RuntimeError(
-      node->getStartingPosition(), node->getEndingPosition(),
-      "The constant named '" + variable_name + "' already defined.",
-      shared_ctx
+      pos_start, pos_end,
+      "The constant named '" + name + "' already defined.",
+      ctx
     );
   }
+}
 
-  unique_ptr<RuntimeResult> res = make_unique<RuntimeResult>();
-  shared_ptr<Value> value = res->read(visit(node->retrieve_value_node()));
-  if (res->should_return()) return res;
-
-  if (node->get_type() != value->get_type()) {
-    shared_ptr<Value> cast_value = value->cast(node->get_type());
-    if (cast_value == nullptr) {
+unique_ptr<Value> Interpreter::define_constant(const string& name, Type type, const Value& value, const Position& value_start, const Position& value_end, const shared_ptr<Context>& ctx) {
+  unique_ptr<Value> constant = nullptr;
+  if (type != value.get_type()) {
+    constant = value.cast(type);
+    if (constant == nullptr) {
       type_error(
         value,
-        node->get_type(),
-        shared_ctx
+        type,
+        value_start, value_end,
+        ctx
       );
     }
-    value = cast_value;
+  } else {
+    constant = unique_ptr<Value>(value.copy());
   }
 
-  populate(*value, move(node), shared_ctx);
-  shared_ctx->get_symbol_table()->set(variable_name, unique_ptr<Value>(value->copy()), true);
+  ctx->get_symbol_table()->set(name, unique_ptr<Value>(constant->copy()), true);
+
+  return constant;
+}
 
-  res->success(unique_ptr<Value>(value->copy()));
+RuntimeResult Interpreter::visit_VarAccessNode(const VarAccessNode& node) {
+  RuntimeResult res;
+  res.success(access_variable(node.get_var_name(), node.getStartingPosition(), node.getEndingPosition(), shared_ctx));
   return res;
 }
 
-unique_ptr<RuntimeResult> Interpreter::visit_VarAccessNode(unique_ptr<VarAccessNode>&& node) {
-  const string& variable_name = node->get_var_name();
-  if (!shared_ctx->get_symbol_table()->exists_globally(variable_name)) {
+unique_ptr<Value> Interpreter::access_variable(const string& name, const Position& pos_start, const Position& pos_end, const shared_ptr<Context>& ctx) {
+  // The variable is found with a single lookup, and then copied
+  const SymbolTableEntry* entry = ctx->get_symbol_table()->find(name);
+  if (entry == nullptr) {
     throw RuntimeError(
-      node->getStartingPosition(), node->getEndingPosition(),
-      "Undefined variable '" + variable_name + "'.",
-      shared_ctx
+      pos_start, pos_end,
+      "Undefined variable '" + name + "'.",
+      ctx
     );
   }
-  
-  unique_ptr<RuntimeResult> res = make_unique<RuntimeResult>();
-  unique_ptr<Value> value = shared_ctx->get_symbol_table()->get(variable_name); // "get" returns a copy of the variable stored in the symbol table
-  make_success(res, move(value), move(node));
+
+  return unique_ptr<Value>(entry->get_copy());
+}
+
+RuntimeResult Interpreter::visit_VarModifyNode(const VarModifyNode& node) {
+  check_variable_modification(node.get_var_name(), node.getStartingPosition(), node.getEndingPosition(), shared_ctx);
+
+  RuntimeResult res;
+  const CustomNode& value_node = node.get_value_node();
+  const unique_ptr<Value> new_value = res.read(visit(value_node));
+  if (res.should_return()) return res;
+
+  res.success(modify_variable(node.get_var_name(), *new_value, value_node.getStartingPosition(), value_node.getEndingPosition(), shared_ctx));
   return res;
 }
 
-unique_ptr<RuntimeResult> Interpreter::visit_VarModifyNode(unique_ptr<VarModifyNode>&& node) {
-  const string& variable_name = node->get_var_name();
-  if (!shared_ctx->get_symbol_table()->exists_globally(variable_name)) {
+void Interpreter::check_variable_modification(const string& name, const Position& pos_start, const Position& pos_end, const shared_ptr<Context>& ctx) {
+  if (!ctx->get_symbol_table()->exists_globally(name)) {
     throw RuntimeError(
-      node->getStartingPosition(), node->getEndingPosition(),
-      "Undefined variable '" + variable_name + "'.",
-      shared_ctx
+      pos_start, pos_end,
+      "Undefined variable '" + name + "'.",
+      ctx
     );
   }
 
-  if (shared_ctx->get_symbol_table()->is_constant(variable_name)) {
+  if (ctx->get_symbol_table()->is_constant(name)) {
     throw TypeError(
-      node->getStartingPosition(), node->getEndingPosition(),
+      pos_start, pos_end,
       "Assignment to constant variable",
-      shared_ctx
+      ctx
     );
   }
+}
 
-  unique_ptr<RuntimeResult> res = make_unique<RuntimeResult>();
-  shared_ptr<Value> new_value = res->read(visit(node->retrieve_value_node()));
-  if (res->should_return()) return res;
-
+unique_ptr<Value> Interpreter::modify_variable(const string& name, const Value& new_value, const Position& value_start, const Position& value_end, const shared_ptr<Context>& ctx) {
   // If the type isn't exactly the same,
   // then try to cast the given value
   // so as to match the one of the variable.
   // If it doesn't work, throw a TypeError.
-  const unique_ptr<Value> existing_value = shared_ctx->get_symbol_table()->get(variable_name);
-  if (new_value->get_type() != existing_value->get_type()) {
-    const shared_ptr<Value> cast_value = new_value->cast(existing_value->get_type());
-    if (cast_value == nullptr) {
+  SymbolTableEntry* entry = ctx->get_symbol_table()->find(name);
+  const Type existing_type = entry->get_value().get_type();
+  unique_ptr<Value> value = nullptr;
+  if (new_value.get_type() != existing_type) {
+    value = new_value.cast(existing_type);
+    if (value == nullptr) {
       type_error(
         new_value,
-        existing_value->get_type(),
-        shared_ctx
+        existing_type,
+        value_start, value_end,
+        ctx
       );
     }
-    new_value = cast_value;
+  } else {
+    value = unique_ptr<Value>(new_value.copy());
   }
 
-  shared_ctx->get_symbol_table()->modify(variable_name, unique_ptr<Value>(new_value->copy()));
+  entry->overwrite_value(unique_ptr<Value>(value->copy()));
 
   // It's important to keep in mind that the garbage collector will deallocate the returned value of a statement.
   // To make sure it doesn't delete a variable, it must return a copy.
-  res->success(unique_ptr<Value>(new_value->copy()));
-  return res;
+  return value;
 }
 
-unique_ptr<RuntimeResult> Interpreter::visit_StringNode(unique_ptr<const StringNode>&& node) {
-  unique_ptr<RuntimeResult> res = make_unique<RuntimeResult>();
-  unique_ptr<StringValue> str = make_unique<StringValue>(node->getValue());
-  make_success(res, move(str), move(node));
+RuntimeResult Interpreter::visit_StringNode(const StringNode& node) {
+  RuntimeResult res;
+  unique_ptr<StringValue> str = make_unique<StringValue>(node.getValue());
+  res.success(move(str));
   return res;
 }
 
-unique_ptr<RuntimeResult> Interpreter::visit_BooleanNode(unique_ptr<const BooleanNode>&& node) {
-  unique_ptr<RuntimeResult> res = make_unique<RuntimeResult>();
-  unique_ptr<BooleanValue> str = make_unique<BooleanValue>(node->is_true());
-  make_success(res, move(str), move(node));
+RuntimeResult Interpreter::visit_BooleanNode(const BooleanNode& node) {
+  RuntimeResult res;
+  unique_ptr<BooleanValue> str = make_unique<BooleanValue>(node.is_true());
+  res.success(move(str));
   return res;
 }
 
@@ -492,47 +926,47 @@ unique_ptr<RuntimeResult> Interpreter::visit_BooleanNode(unique_ptr<const Boolea
 // store a as int = function_that_might_return_0() or 5
 // ```
 // In this code a = 5 only if the left operand returned a falsy value.
-unique_ptr<RuntimeResult> Interpreter::visit_OrNode(unique_ptr<OrNode>&& node) {
-  unique_ptr<RuntimeResult> res = make_unique<RuntimeResult>();
-  const shared_ptr<const Value> left = res->read(visit(node->retrieve_a()));
-  if (res->should_return()) return res;
+RuntimeResult Interpreter::visit_OrNode(const OrNode& node) {
+  RuntimeResult res;
+  const unique_ptr<Value> left = res.read(visit(node.get_a()));
+  if (res.should_return()) return res;
 
   if (left->is_truthy()) {
     unique_ptr<Value> left_copy = unique_ptr<Value>(left->copy());
-    make_success(res, move(left_copy), move(node));
+    res.success(move(left_copy));
   } else {
-    const shared_ptr<const Value> right = res->read(visit(node->retrieve_b()));
-    if (res->should_return()) return res;
+    const unique_ptr<Value> right = res.read(visit(node.get_b()));
+    if (res.should_return()) return res;
     unique_ptr<Value> right_copy = unique_ptr<Value>(right->copy());
-    make_success(res, move(right_copy), move(node));
+    res.success(move(right_copy));
   }
 
   return res;
 }
 
-unique_ptr<RuntimeResult> Interpreter::visit_AndNode(unique_ptr<AndNode>&& node) {
-  unique_ptr<RuntimeResult> res = make_unique<RuntimeResult>();
-  const shared_ptr<const Value> left = res->read(visit(node->retrieve_a()));
-  if (res->should_return()) return res;
+RuntimeResult Interpreter::visit_AndNode(const AndNode& node) {
+  RuntimeResult res;
+  const unique_ptr<Value> left = res.read(visit(node.get_a()));
+  if (res.should_return()) return res;
 
   if (!left->is_truthy()) { // do not interpret the right operand if the left one is false
     unique_ptr<BooleanValue> bool_false = make_unique<BooleanValue>(false);
-    make_success(res, move(bool_false), move(node));
+    res.success(move(bool_false));
   } else {
-    const shared_ptr<const Value> right = res->read(visit(node->retrieve_b()));
-    if (res->should_return()) return res;
+    const unique_ptr<Value> right = res.read(visit(node.get_b()));
+    if (res.should_return()) return res;
     unique_ptr<BooleanValue> answer = make_unique<BooleanValue>(right->is_truthy());
-    make_success(res, move(answer), move(node));
+    res.success(move(answer));
   }
 
   return res;
 }
 
-unique_ptr<RuntimeResult> Interpreter::visit_NotNode(unique_ptr<NotNode>&& node) {
-  unique_ptr<RuntimeResult> res = make_unique<RuntimeResult>();
-  const shared_ptr<const Value> value = res->read(visit(node->retrieve_node()));
-  if (res->should_return()) return res;
+RuntimeResult Interpreter::visit_NotNode(const NotNode& node) {
+  RuntimeResult res;
+  const unique_ptr<Value> value = res.read(visit(node.get_node()));
+  if (res.should_return()) return res;
   unique_ptr<BooleanValue> return_value = make_unique<BooleanValue>(!value->is_truthy());
-  make_success(res, move(return_value), move(node));
+  res.success(move(return_value));
   return res;
 }
\ No newline at end of file
@@ -15,6 +15,7 @@ const map<char, char> ESCAPE_CHARACTERS{{'n', '\n'}, {'t', '\t'}, {'r', '\r'}};
 const char DOUBLE_QUOTE = '"';
 const char SIMPLE_QUOTE = '\'';
 const char BACKSLASH = '\\';
+const char DOLLAR = '$';
 
 /// @brief Helper method to know if a specific identifier is a keyword or not.
 /// @param keyword The identifier that may or may not be a keyword.
@@ -23,9 +24,9 @@ bool is_keyword(const string& keyword) {
   return std::find(KEYWORDS.begin(), KEYWORDS.end(), keyword) != KEYWORDS.end();
 }
 
-unique_ptr<Lexer> Lexer::readCLI(const string& input) {
+unique_ptr<Lexer> Lexer::readCLI(const string& input, const string& filename) {
   unique_ptr<Lexer> lexer = make_unique<Lexer>();
-  lexer->pos = make_unique<Position>(0, 0, 0, "<stdin>");
+  lexer->pos = make_unique<Position>(0, 0, 0, filename);
   lexer->iter = input.begin();
   lexer->input_end = input.end();
   lexer->is_cli = true;
@@ -132,6 +133,30 @@ shared_ptr<const Token> Lexer::get_next_token() {
       const Position pos_start = pos->copy();
       advance();
       return make_shared<Token>(TokenType::RPAREN, ")", pos_start, pos.get());
+    } else if (getChar() == '[') {
+      const Position pos_start = pos->copy();
+      advance();
+      return make_shared<Token>(TokenType::LSQUARE, "[", pos_start, pos.get());
+    } else if (getChar() == ']') {
+      const Position pos_start = pos->copy();
+      advance();
+      return make_shared<Token>(TokenType::RSQUARE, "]", pos_start, pos.get());
+    } else if (getChar() == '{') {
+      const Position pos_start = pos->copy();
+      advance();
+      return make_shared<Token>(TokenType::LBRACK, "{", pos_start, pos.get());
+    } else if (getChar() == '}') {
+      const Position pos_start = pos->copy();
+      advance();
+      return make_shared<Token>(TokenType::RBRACK, "}", pos_start, pos.get());
+    } else if (getChar() == ':') {
+      const Position pos_start = pos->copy();
+      advance();
+      return make_shared<Token>(TokenType::COLON, ":", pos_start, pos.get());
+    } else if (getChar() == ',') {
+      const Position pos_start = pos->copy();
+      advance();
+      return make_shared<Token>(TokenType::COMMA, ",", pos_start, pos.get());
     } else if (getChar() == '=') {
       const Position pos_start = pos->copy();
       advance();
@@ -263,6 +288,7 @@ shared_ptr<Token> Lexer::make_string() {
   const char opening_quote = (getChar());
   bool allow_concatenation = getChar() == DOUBLE_QUOTE;
   string value;
+  vector<interpolation_t> interpolations;
   advance();
 
   bool escaped = false; // `true` if the previous character was a backslash (\)
@@ -276,6 +302,24 @@ shared_ptr<Token> Lexer::make_string() {
         "The maximum length of a string has been reached: " + std::to_string(value.length())
       );
     }
+    if (allow_concatenation && !escaped && getChar() == DOLLAR) {
+      // The name of the variable follows the same rules as an identifier.
+      // A dollar sign that isn't followed by a name stays in the string, and so does "\$name".
+      const Position dollar_pos = pos->copy();
+      const size_t offset = value.length();
+      string name;
+      value.push_back(DOLLAR);
+      advance();
+      while (hasMoreTokens() && (name.empty() ? LETTERS_UNDERSCORE : LETTERS_DIGITS).find(getChar()) != string::npos) {
+        name += getChar();
+        value.push_back(getChar());
+        advance();
+      }
+      if (!name.empty() && !is_keyword(name)) {
+        interpolations.push_back({ offset, move(name), dollar_pos, pos->copy() });
+      }
+      continue;
+    }
     if (getChar() == BACKSLASH) {
       if (escaped) {
         value.push_back(BACKSLASH);
@@ -302,5 +346,5 @@ shared_ptr<Token> Lexer::make_string() {
 
   advance(); // to skip the ending quote (the lexer must not believe it's the start of a new string).
 
-  return make_shared<Token>(TokenType::STR, value, pos_start, pos.get(), allow_concatenation);
+  return make_shared<Token>(TokenType::STR, value, pos_start, pos.get(), allow_concatenation, move(interpolations));
 }
\ No newline at end of file
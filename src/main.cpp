@@ -15,11 +15,29 @@
 #include "../include/run.hpp"
 #include "../include/compiler.hpp"
 #include "../include/runtime.hpp"
+#include "../include/batch/batch_evaluator.hpp"
+#include "../include/utils/read_entire_file.hpp"
+#include "../include/exceptions/exception.hpp"
+#include "../include/exceptions/custom_error.hpp"
 using namespace std;
 
 // "argc" is the number of arguments passed to the executable.
 // "argv" is the arguments themselves, of length "argc", with the first argument being the executable itself.
 int main(int argc, char *argv[]) {
+  // The engine can be chosen with the first argument (--engine=vm).
+  // It's then removed from the arguments so that the rest of the function doesn't have to care about it.
+  Engine::Type engine = Engine::TREE_WALKER;
+  if (argc >= 2 && string(argv[1]).starts_with("--engine=")) {
+    const string engine_name = string(argv[1]).substr(9);
+    if (!get_engine_from_name(engine_name, engine)) {
+      cerr << "Unknown engine '" << engine_name << "' (expected 'tree', 'vm' or 'regvm')." << endl;
+      return 1;
+    }
+    argv[1] = argv[0];
+    ++argv;
+    --argc;
+  }
+
   if (argc >= 3 && string(argv[1]) == "--compile") {
     try {
       const string bk_file = string(argv[2]);
@@ -34,12 +52,48 @@ int main(int argc, char *argv[]) {
     return 0;
   }
 
+  // Evaluates an expression for each row of a data file,
+  // and writes the result of each row on its own line.
+  if (argc == 4 && string(argv[1]) == "--eval-over") {
+    try {
+      const auto t1 = chrono::steady_clock::now();
+      const table_t table = ColumnLoader::load(argv[2]);
+      string source = read_entire_file(argv[3]);
+      while (!source.empty() && isspace(static_cast<unsigned char>(source.back()))) source.pop_back();
+      BatchEvaluator evaluator(source);
+      evaluator.bind(table);
+      size_t rows = 0;
+      string output;
+      evaluator.eval([&rows, &output](const Column& batch) {
+        output.clear();
+        for (size_t i = 0; i < batch.size(); ++i) {
+          output += batch.to_string(i);
+          output += '\n';
+        }
+        cout << output;
+        rows += batch.size();
+      });
+      cout.flush();
+      const auto t2 = chrono::steady_clock::now();
+      const double seconds = chrono::duration<double>(t2 - t1).count();
+      cerr << rows << " rows in " << seconds * 1000 << " ms (" << static_cast<size_t>(rows / seconds) << " rows/s)" << endl;
+    } catch (Exception& e) {
+      cerr << e.to_string() << endl;
+      return 1;
+    } catch (CustomError& e) {
+      cerr << e.to_string() << endl;
+      return 1;
+    }
+    return 0;
+  }
+
   if (argc > 2) {
     cerr << "Too many arguments passed to the main function." << endl;
     cerr << "Usage:" << endl;
-    cerr << "Start the cli: " << argv[0] << endl;
-    cerr << "Interpret a file: " << argv[0] << " file.bk" << endl;
+    cerr << "Start the cli: " << argv[0] << " [--engine=tree|vm|regvm]" << endl;
+    cerr << "Interpret a file: " << argv[0] << " [--engine=tree|vm|regvm] file.bk" << endl;
     cerr << "Compile a file: " << argv[0] << " --compile file.bk [output_path]" << endl;
+    cerr << "Evaluate an expression for each row of a file: " << argv[0] << " --eval-over data.csv|data.bkc expression.bk" << endl;
     return 1;
   }
 
@@ -47,7 +101,7 @@ int main(int argc, char *argv[]) {
   // then just start the CLI
   // instead of returning an error.
   if (argc == 1) {
-    cli();
+    cli(engine);
     return 0;
   }
 
@@ -81,7 +135,7 @@ int main(int argc, char *argv[]) {
   const shared_ptr<Context> global_ctx = make_shared<Context>(filename);
 
   // will do something with this
-  runFile(filename, global_ctx);
+  runFile(filename, global_ctx, engine);
 
   file.close();
 
@@ -9,3 +9,5 @@ BinaryOperationNode::BinaryOperationNode(
 
 unique_ptr<CustomNode> BinaryOperationNode::retrieve_a() { return move(node_a); }
 unique_ptr<CustomNode> BinaryOperationNode::retrieve_b() { return move(node_b); }
+const CustomNode& BinaryOperationNode::get_a() const { return *node_a; }
+const CustomNode& BinaryOperationNode::get_b() const { return *node_b; }
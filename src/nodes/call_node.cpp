@@ -0,0 +1,30 @@
+#include "../../include/nodes/call_node.hpp"
+using namespace std;
+
+CallNode::CallNode(
+  Builtin::Type builtin,
+  list_of_nodes_ptr args,
+  const Position& start,
+  const Position& end
+): CustomNode(start, end, NodeType::CALL), builtin(builtin), arg_nodes(move(args)) {}
+
+Builtin::Type CallNode::get_builtin() const {
+  return builtin;
+}
+
+list_of_nodes_ptr CallNode::retrieve_args() {
+  return move(arg_nodes);
+}
+
+const list<unique_ptr<CustomNode>>& CallNode::get_args() const {
+  return *arg_nodes;
+}
+
+string CallNode::to_string() const {
+  string result = "CallNode(" + get_builtin_name(builtin) + ", [";
+  for (auto iter = arg_nodes->begin(); iter != arg_nodes->end(); ++iter) {
+    if (iter != arg_nodes->begin()) result += ", ";
+    result += (*iter)->to_string();
+  }
+  return result + "])";
+}
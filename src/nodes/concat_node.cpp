@@ -0,0 +1,34 @@
+#include "../../include/nodes/concat_node.hpp"
+using namespace std;
+
+ConcatNode::ConcatNode(
+  list_of_nodes_ptr parts
+):
+  CustomNode(
+    parts->front()->getStartingPosition(),
+    parts->back()->getEndingPosition(),
+    NodeType::CONCAT
+  ), part_nodes(move(parts)) {}
+
+ConcatNode::ConcatNode(
+  list_of_nodes_ptr parts,
+  const Position& start,
+  const Position& end
+): CustomNode(start, end, NodeType::CONCAT), part_nodes(move(parts)) {}
+
+list_of_nodes_ptr ConcatNode::retrieve_parts() {
+  return move(part_nodes);
+}
+
+const list<unique_ptr<CustomNode>>& ConcatNode::get_parts() const {
+  return *part_nodes;
+}
+
+string ConcatNode::to_string() const {
+  string result = "ConcatNode(";
+  for (auto iter = part_nodes->begin(); iter != part_nodes->end(); ++iter) {
+    if (iter != part_nodes->begin()) result += "+";
+    result += (*iter)->to_string();
+  }
+  return result + ")";
+}
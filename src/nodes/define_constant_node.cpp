@@ -15,6 +15,7 @@ DefineConstantNode::DefineConstantNode(
   type(type) {}
 
 unique_ptr<CustomNode> DefineConstantNode::retrieve_value_node() { return move(value_node); }
+const CustomNode& DefineConstantNode::get_value_node() const { return *value_node; }
 string DefineConstantNode::get_var_name() const { return var_name; }
 Type DefineConstantNode::get_type() const { return type; }
 
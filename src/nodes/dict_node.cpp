@@ -0,0 +1,31 @@
+#include "../../include/nodes/dict_node.hpp"
+using namespace std;
+
+DictNode::DictNode(
+  list_of_nodes_ptr entries,
+  const Position& start,
+  const Position& end
+): CustomNode(start, end, NodeType::DICT), entry_nodes(move(entries)) {}
+
+list_of_nodes_ptr DictNode::retrieve_entries() {
+  return move(entry_nodes);
+}
+
+const list<unique_ptr<CustomNode>>& DictNode::get_entries() const {
+  return *entry_nodes;
+}
+
+unsigned int DictNode::get_number_of_entries() const {
+  return static_cast<unsigned int>(entry_nodes->size() / 2);
+}
+
+string DictNode::to_string() const {
+  string result = "DictNode({";
+  bool is_key = true;
+  for (auto iter = entry_nodes->begin(); iter != entry_nodes->end(); ++iter) {
+    if (is_key && iter != entry_nodes->begin()) result += ", ";
+    result += (*iter)->to_string() + (is_key ? ": " : "");
+    is_key = !is_key;
+  }
+  return result + "})";
+}
\ No newline at end of file
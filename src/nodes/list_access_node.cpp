@@ -0,0 +1,17 @@
+#include "../../include/nodes/list_access_node.hpp"
+using namespace std;
+
+ListAccessNode::ListAccessNode(
+  unique_ptr<CustomNode> list,
+  unique_ptr<CustomNode> index,
+  const Position& pos_end
+): CustomNode(list->getStartingPosition(), pos_end, NodeType::LIST_ACCESS), list_node(move(list)), index_node(move(index)) { }
+
+unique_ptr<CustomNode> ListAccessNode::retrieve_list() { return move(list_node); }
+unique_ptr<CustomNode> ListAccessNode::retrieve_index() { return move(index_node); }
+const CustomNode& ListAccessNode::get_list() const { return *list_node; }
+const CustomNode& ListAccessNode::get_index() const { return *index_node; }
+
+string ListAccessNode::to_string() const {
+  return "ListAccessNode(" + list_node->to_string() + "[" + index_node->to_string() + "])";
+}
\ No newline at end of file
@@ -0,0 +1,19 @@
+#include "../../include/nodes/list_assignment_node.hpp"
+using namespace std;
+
+ListAssignmentNode::ListAssignmentNode(
+  string var_name,
+  unique_ptr<CustomNode> index,
+  unique_ptr<CustomNode> value,
+  const Position& pos_start
+): CustomNode(pos_start, value->getEndingPosition(), NodeType::LIST_ASSIGNMENT), var_name(move(var_name)), index_node(move(index)), value_node(move(value)) { }
+
+unique_ptr<CustomNode> ListAssignmentNode::retrieve_index_node() { return move(index_node); }
+unique_ptr<CustomNode> ListAssignmentNode::retrieve_value_node() { return move(value_node); }
+const CustomNode& ListAssignmentNode::get_index_node() const { return *index_node; }
+const CustomNode& ListAssignmentNode::get_value_node() const { return *value_node; }
+string ListAssignmentNode::get_var_name() const { return var_name; }
+
+string ListAssignmentNode::to_string() const {
+  return var_name + "[" + index_node->to_string() + "] = " + value_node->to_string();
+}
\ No newline at end of file
@@ -21,6 +21,10 @@ list_of_nodes_ptr ListNode::get_element_nodes() {
   return move(element_nodes);
 }
 
+const list<unique_ptr<CustomNode>>& ListNode::get_elements() const {
+  return *element_nodes;
+}
+
 int ListNode::get_number_of_nodes() const {
   return static_cast<int>(element_nodes->size());
 }
@@ -0,0 +1,20 @@
+#include "../../include/nodes/list_slice_node.hpp"
+using namespace std;
+
+ListSliceNode::ListSliceNode(
+  unique_ptr<CustomNode> list,
+  unique_ptr<CustomNode> start,
+  unique_ptr<CustomNode> end,
+  const Position& pos_end
+): CustomNode(list->getStartingPosition(), pos_end, NodeType::LIST_SLICE), list_node(move(list)), start_node(move(start)), end_node(move(end)) { }
+
+unique_ptr<CustomNode> ListSliceNode::retrieve_list() { return move(list_node); }
+unique_ptr<CustomNode> ListSliceNode::retrieve_start() { return move(start_node); }
+unique_ptr<CustomNode> ListSliceNode::retrieve_end() { return move(end_node); }
+const CustomNode& ListSliceNode::get_list() const { return *list_node; }
+const CustomNode& ListSliceNode::get_start() const { return *start_node; }
+const CustomNode& ListSliceNode::get_end() const { return *end_node; }
+
+string ListSliceNode::to_string() const {
+  return "ListSliceNode(" + list_node->to_string() + "[" + start_node->to_string() + ":" + end_node->to_string() + "])";
+}
\ No newline at end of file
@@ -6,6 +6,7 @@ MinusNode::MinusNode(
 ): CustomNode(n->getStartingPosition(), n->getEndingPosition(), NodeType::NEGATIVE), node(move(n)) {}
 
 unique_ptr<CustomNode> MinusNode::retrieve_node() { return move(node); }
+const CustomNode& MinusNode::get_node() const { return *node; }
 
 string MinusNode::to_string() const {
   return "(-" + node->to_string() + ")";
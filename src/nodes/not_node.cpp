@@ -6,6 +6,7 @@ NotNode::NotNode(
 ): CustomNode(n->getStartingPosition(), n->getEndingPosition(), NodeType::NOT), node(move(n)) {}
 
 unique_ptr<CustomNode> NotNode::retrieve_node() { return move(node); }
+const CustomNode& NotNode::get_node() const { return *node; }
 
 string NotNode::to_string() const {
   return "(!" + node->to_string() + ")";
@@ -6,6 +6,7 @@ PlusNode::PlusNode(
 ): CustomNode(n->getStartingPosition(), n->getEndingPosition(), NodeType::POSITIVE), node(move(n)) {}
 
 unique_ptr<CustomNode> PlusNode::retrieve_node() { return move(node); }
+const CustomNode& PlusNode::get_node() const { return *node; }
 
 string PlusNode::to_string() const {
   return "(+" + node->to_string() + ")";
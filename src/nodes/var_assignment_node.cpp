@@ -15,6 +15,7 @@ VarAssignmentNode::VarAssignmentNode(
   type_name(type_tok.getStringValue()) {}
 
 unique_ptr<CustomNode> VarAssignmentNode::retrieve_value_node() { return move(value_node); }
+const CustomNode* VarAssignmentNode::get_value_node() const { return value_node.get(); }
 string VarAssignmentNode::get_var_name() const { return var_name; }
 bool VarAssignmentNode::has_value() const { return value_node != nullptr; }
 string VarAssignmentNode::get_type_name() const { return type_name; }
@@ -8,6 +8,7 @@ VarModifyNode::VarModifyNode(
 ): CustomNode(pos_start, value->getEndingPosition(), NodeType::VAR_MODIFY), var_name(move(var_name)), value_node(move(value)) { }
 
 unique_ptr<CustomNode> VarModifyNode::retrieve_value_node() { return move(value_node); }
+const CustomNode& VarModifyNode::get_value_node() const { return *value_node; }
 string VarModifyNode::get_var_name() const { return var_name; }
 
 string VarModifyNode::to_string() const {
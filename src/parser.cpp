@@ -45,6 +45,31 @@ shared_ptr<const Token> Parser::expect(const TokenType type, const Position& pos
   return token;
 }
 
+list_of_nodes_ptr Parser::comma_separated_exprs(const TokenType closing_type, const char closing_char, const Position& pos) {
+  list_of_nodes_ptr nodes = make_unique<list<unique_ptr<CustomNode>>>();
+  ignore_newlines();
+  require_token(pos);
+  if (get_tok()->notOfType(closing_type)) {
+    nodes->push_back(expr());
+    ignore_newlines();
+    while (has_more_tokens() && get_tok()->ofType(TokenType::COMMA)) {
+      advance();
+      ignore_newlines();
+      require_token(pos);
+      nodes->push_back(expr());
+      ignore_newlines();
+    }
+  }
+  require_token(pos);
+  if (get_tok()->notOfType(closing_type)) {
+    throw InvalidSyntaxError(
+      get_tok()->getStartingPosition(), get_tok()->getEndingPosition(),
+      string("Expected ',' or '") + closing_char + "'"
+    );
+  }
+  return nodes;
+}
+
 void Parser::advance() {
   current_token = lexer->get_next_token();
 }
@@ -59,9 +84,9 @@ shared_ptr<const Token> Parser::get_tok() {
 *
 */
 
-Parser Parser::initCLI(const std::string& input) {
+Parser Parser::initCLI(const std::string& input, const std::string& filename) {
   Parser parser;
-  parser.lexer = Lexer::readCLI(input);
+  parser.lexer = Lexer::readCLI(input, filename);
   // because current_tok is nullptr right now,
   // and it would create issues (seg faults):
   parser.advance();
@@ -289,6 +314,56 @@ unique_ptr<CustomNode> Parser::comp_expr() {
 
 unique_ptr<CustomNode> Parser::bin_op() { return arith_expr(); }
 
+/// @brief Creates the node of an addition.
+/// A chain of additions whose first operand is a string literal is a chain of concatenations,
+/// so it's folded into a single ConcatNode from its third part
+/// (a single concatenation doesn't produce any intermediate string).
+/// @param left The left operand.
+/// @param right The right operand.
+/// @return Either an AddNode or a ConcatNode.
+static unique_ptr<CustomNode> make_addition(unique_ptr<CustomNode> left, unique_ptr<CustomNode> right) {
+  list_of_nodes_ptr parts;
+  if (left->getNodeType() == NodeType::CONCAT) {
+    parts = cast_node<ConcatNode>(move(left))->retrieve_parts();
+  } else if (left->getNodeType() == NodeType::ADD && static_cast<const AddNode&>(*left).get_a().getNodeType() == NodeType::STRING) {
+    unique_ptr<AddNode> addition = cast_node<AddNode>(move(left));
+    parts = make_unique<list<unique_ptr<CustomNode>>>();
+    parts->push_back(addition->retrieve_a());
+    parts->push_back(addition->retrieve_b());
+  } else {
+    return make_unique<AddNode>(left, right);
+  }
+  parts->push_back(move(right));
+  return make_unique<ConcatNode>(move(parts));
+}
+
+/// @brief Splits a string with double quotes into its constant segments and the variables it inserts,
+/// so that the template is never scanned again at runtime.
+/// @param token A string with at least one interpolation.
+/// @return The ConcatNode of the segments (the empty ones are skipped) and of the variables.
+static unique_ptr<CustomNode> make_interpolation(const Token& token) {
+  const string value = token.getStringValue();
+  list_of_nodes_ptr parts = make_unique<list<unique_ptr<CustomNode>>>();
+  size_t offset = 0;
+  Position segment_start = token.getStartingPosition();
+  for (const interpolation_t& interpolation : token.getInterpolations()) {
+    if (interpolation.offset > offset) {
+      const Token segment(TokenType::STR, value.substr(offset, interpolation.offset - offset), segment_start, &interpolation.pos_start, true);
+      parts->push_back(make_unique<StringNode>(segment));
+    }
+    const Token variable(TokenType::IDENTIFIER, interpolation.name, interpolation.pos_start, &interpolation.pos_end);
+    parts->push_back(make_unique<VarAccessNode>(variable));
+    offset = interpolation.offset + 1 + interpolation.name.length();
+    segment_start = interpolation.pos_end;
+  }
+  if (offset < value.length()) {
+    const Position end = token.getEndingPosition();
+    const Token segment(TokenType::STR, value.substr(offset), segment_start, &end, true);
+    parts->push_back(make_unique<StringNode>(segment));
+  }
+  return make_unique<ConcatNode>(move(parts), token.getStartingPosition(), token.getEndingPosition());
+}
+
 unique_ptr<CustomNode> Parser::arith_expr() {
   unique_ptr<CustomNode> result = term();
 
@@ -307,7 +382,7 @@ unique_ptr<CustomNode> Parser::arith_expr() {
     }
     auto ter = term();
     if (tok.ofType(TokenType::PLUS)) {
-      result = make_unique<AddNode>(result, ter);
+      result = make_addition(move(result), move(ter));
     } else {
       result = make_unique<SubstractNode>(result, ter);
     }
@@ -363,7 +438,91 @@ unique_ptr<CustomNode> Parser::factor() {
 
 unique_ptr<CustomNode> Parser::prop() { return call(); }
 
-unique_ptr<CustomNode> Parser::call() { return atom(); }
+unique_ptr<CustomNode> Parser::call() {
+  unique_ptr<CustomNode> result = atom();
+
+  // For now, only the built-in functions can be called,
+  // so the function is resolved here and the engines receive it directly.
+  if (has_more_tokens() && get_tok()->ofType(TokenType::LPAREN) && result->getNodeType() == NodeType::VAR_ACCESS) {
+    const string name = static_cast<const VarAccessNode&>(*result).get_var_name();
+    const optional<Builtin::Type> builtin = get_builtin_from_name(name);
+    if (!builtin.has_value()) {
+      throw InvalidSyntaxError(
+        result->getStartingPosition(), result->getEndingPosition(),
+        "Unknown function '" + name + "'"
+      );
+    }
+    advance();
+    list_of_nodes_ptr args = comma_separated_exprs(TokenType::RPAREN, ')', result->getEndingPosition());
+    const Position pos_end = get_tok()->getEndingPosition();
+    advance();
+    const unsigned int arity = get_builtin_arity(*builtin);
+    if (args->size() != arity) {
+      throw InvalidSyntaxError(
+        result->getStartingPosition(), pos_end,
+        "The function '" + name + "' expects " + std::to_string(arity) + (arity == 1 ? " argument" : " arguments") + ", but received " + std::to_string(args->size())
+      );
+    }
+    result = make_unique<CallNode>(*builtin, move(args), result->getStartingPosition(), pos_end);
+  }
+
+  while (has_more_tokens() && get_tok()->ofType(TokenType::LSQUARE)) {
+    advance();
+    ignore_newlines();
+    require_token(result->getEndingPosition());
+    unique_ptr<CustomNode> index = expr();
+    ignore_newlines();
+    require_token(result->getEndingPosition());
+    if (get_tok()->ofType(TokenType::COLON)) {
+      advance();
+      ignore_newlines();
+      require_token(result->getEndingPosition());
+      unique_ptr<CustomNode> end = expr();
+      ignore_newlines();
+      require_token(result->getEndingPosition());
+      if (get_tok()->notOfType(TokenType::RSQUARE)) {
+        throw InvalidSyntaxError(
+          get_tok()->getStartingPosition(), get_tok()->getEndingPosition(),
+          "Expected ']'"
+        );
+      }
+      const Position pos_end = get_tok()->getEndingPosition();
+      advance();
+      result = make_unique<ListSliceNode>(move(result), move(index), move(end), pos_end);
+      continue;
+    }
+    if (get_tok()->notOfType(TokenType::RSQUARE)) {
+      throw InvalidSyntaxError(
+        get_tok()->getStartingPosition(), get_tok()->getEndingPosition(),
+        "Expected ':' or ']'"
+      );
+    }
+    const Position pos_end = get_tok()->getEndingPosition();
+    advance();
+    if (has_more_tokens() && get_tok()->ofType(TokenType::EQUALS)) {
+      // Only the lists stored in a variable can be modified, and only one level deep
+      if (result->getNodeType() != NodeType::VAR_ACCESS) {
+        throw InvalidSyntaxError(
+          result->getStartingPosition(), pos_end,
+          "Only the elements of a list (or the entries of a dictionary) stored in a variable can be modified"
+        );
+      }
+      advance();
+      if (!has_more_tokens()) {
+        throw InvalidSyntaxError(
+          result->getStartingPosition(), pos_end,
+          "Expected a new value to be assigned to the element."
+        );
+      }
+      unique_ptr<CustomNode> value_node = expr();
+      const string name = static_cast<const VarAccessNode&>(*result).get_var_name();
+      return make_unique<ListAssignmentNode>(name, move(index), move(value_node), result->getStartingPosition());
+    }
+    result = make_unique<ListAccessNode>(move(result), move(index), pos_end);
+  }
+
+  return result;
+}
 
 unique_ptr<CustomNode> Parser::atom() {
   const Token first_token = get_tok()->copy();
@@ -381,6 +540,48 @@ unique_ptr<CustomNode> Parser::atom() {
     }
     advance();
     return result;
+  } else if (first_token.ofType(TokenType::LSQUARE)) {
+    advance();
+    list_of_nodes_ptr element_nodes = comma_separated_exprs(TokenType::RSQUARE, ']', first_token.getEndingPosition());
+    const Position pos_end = get_tok()->getEndingPosition();
+    advance();
+    return make_unique<ListNode>(move(element_nodes), first_token.getStartingPosition(), pos_end);
+  } else if (first_token.ofType(TokenType::LBRACK)) {
+    advance();
+    list_of_nodes_ptr entry_nodes = make_unique<list<unique_ptr<CustomNode>>>();
+    ignore_newlines();
+    require_token(first_token.getEndingPosition());
+    while (get_tok()->notOfType(TokenType::RBRACK)) {
+      if (!entry_nodes->empty()) {
+        if (get_tok()->notOfType(TokenType::COMMA)) {
+          throw InvalidSyntaxError(
+            get_tok()->getStartingPosition(), get_tok()->getEndingPosition(),
+            "Expected ',' or '}'"
+          );
+        }
+        advance();
+        ignore_newlines();
+        require_token(first_token.getEndingPosition());
+      }
+      entry_nodes->push_back(expr());
+      ignore_newlines();
+      require_token(first_token.getEndingPosition());
+      if (get_tok()->notOfType(TokenType::COLON)) {
+        throw InvalidSyntaxError(
+          get_tok()->getStartingPosition(), get_tok()->getEndingPosition(),
+          "Expected ':'"
+        );
+      }
+      advance();
+      ignore_newlines();
+      require_token(first_token.getEndingPosition());
+      entry_nodes->push_back(expr());
+      ignore_newlines();
+      require_token(first_token.getEndingPosition());
+    }
+    const Position pos_end = get_tok()->getEndingPosition();
+    advance();
+    return make_unique<DictNode>(move(entry_nodes), first_token.getStartingPosition(), pos_end);
   } else if (first_token.ofType(TokenType::NUMBER)) {
     advance();
     if (string_contains(first_token.getStringValue(), '.')) {
@@ -405,6 +606,9 @@ unique_ptr<CustomNode> Parser::atom() {
     return make_unique<VarAccessNode>(first_token);
   } else if (first_token.ofType(TokenType::STR)) {
     advance();
+    if (!first_token.getInterpolations().empty()) {
+      return make_interpolation(first_token);
+    }
     return make_unique<StringNode>(first_token);
   } else if (first_token.is_keyword("true") || first_token.is_keyword("false")) {
     advance();
@@ -0,0 +1,90 @@
+#include "../include/program.hpp"
+#include "../include/parser.hpp"
+#include "../include/symbol_table.hpp"
+#include "../include/vm/register_compiler.hpp"
+#include "../include/values/compositer.hpp"
+#include "../include/exceptions/exception.hpp"
+using namespace std;
+
+Program::Program(const string& source) {
+  // Each program has its own key, so that its errors never show the source code of another program
+  StoredSource stored_source("program", source);
+  // Just like `runLine`, an empty input isn't given to the Parser
+  unique_ptr<ListNode> tree = source.empty()
+    ? make_unique<ListNode>(make_unique<list<unique_ptr<CustomNode>>>())
+    : Parser::initCLI(source, stored_source.get_key()).parse();
+  auto program = make_shared<compiled_program_t>(move(stored_source));
+  program->chunk = RegisterCompiler::compile(move(tree));
+
+  const RegisterChunk& chunk = program->chunk;
+  for (unsigned int slot = 0; slot < chunk.names.size(); ++slot) {
+    program->slots.emplace(chunk.names[slot], slot);
+  }
+  program->assigned.resize(chunk.names.size(), false);
+  for (const three_address_t& instruction : chunk.code) {
+    switch (instruction.op) {
+      case RegOpCode::DECLARE:
+      case RegOpCode::DEFINE:
+        program->assigned[chunk.declarations[instruction.b].name] = true;
+        break;
+      case RegOpCode::STORE:
+      case RegOpCode::STORE_ELEMENT: // modifies the whole list stored in the symbol table
+        program->assigned[instruction.b] = true;
+        break;
+      default:
+        break;
+    }
+  }
+
+  inputs.resize(chunk.names.size());
+  compiled = move(program);
+  ctx = make_shared<Context>("<program>");
+}
+
+Program::Program(const Program& other):
+  compiled(other.compiled),
+  inputs(other.inputs),
+  ctx(make_shared<Context>("<program>")) {}
+
+Program& Program::operator=(const Program& other) {
+  if (this != &other) {
+    compiled = other.compiled;
+    inputs = other.inputs;
+    ctx = make_shared<Context>("<program>");
+  }
+  return *this;
+}
+
+void Program::bind(const string& name, unique_ptr<Value> value) {
+  const auto it = compiled->slots.find(name);
+  if (it == compiled->slots.end()) return;
+  if (compiled->assigned[it->second]) {
+    throw Exception("Binding error", "The variable '" + name + "' is assigned by the program, it cannot be bound.");
+  }
+  inputs[it->second] = move(value);
+}
+
+void Program::bind(const string& name, int value) { bind(name, make_unique<IntegerValue>(value)); }
+void Program::bind(const string& name, int64_t value) { bind(name, make_unique<IntegerValue>(value)); }
+void Program::bind(const string& name, double value) { bind(name, make_unique<DoubleValue>(value)); }
+void Program::bind(const string& name, bool value) { bind(name, make_unique<BooleanValue>(value)); }
+void Program::bind(const string& name, const string& value) { bind(name, make_unique<StringValue>(value)); }
+void Program::bind(const string& name, const char* value) { bind(name, make_unique<StringValue>(value)); }
+
+void Program::unbind_all() {
+  for (auto& input : inputs) {
+    input = nullptr;
+  }
+}
+
+shared_ptr<const Value> Program::eval() {
+  ctx->get_symbol_table()->clear();
+  RuntimeResult res = RegisterVirtualMachine::run(compiled->chunk, ctx, &inputs);
+  const unique_ptr<Value> result = res.take_value();
+  const list_of_values_view statements = static_cast<const ListValue&>(*result).get_elements();
+  return statements.empty() ? nullptr : statements.back();
+}
+
+Program bk::compile(const string& source) {
+  return Program(source);
+}
@@ -9,10 +9,40 @@
 #include "../include/context.hpp"
 #include "../include/runtime.hpp"
 #include "../include/interpreter.hpp"
+#include "../include/vm/bytecode_compiler.hpp"
+#include "../include/vm/vm.hpp"
+#include "../include/vm/register_compiler.hpp"
+#include "../include/vm/register_vm.hpp"
 using namespace std;
 
+bool get_engine_from_name(const string& name, Engine::Type& engine) {
+  if (name == "tree") engine = Engine::TREE_WALKER;
+  else if (name == "vm") engine = Engine::VM;
+  else if (name == "regvm") engine = Engine::REGISTER_VM;
+  else return false;
+  return true;
+}
+
+// Executes the tree given by the Parser with the chosen engine.
+static RuntimeResult execute(unique_ptr<ListNode>&& tree, const shared_ptr<Context>& ctx, Engine::Type engine) {
+  if (engine == Engine::VM) {
+    // The tree is deallocated once it has been compiled
+    const Chunk chunk = BytecodeCompiler::compile(move(tree));
+    return VirtualMachine::run(chunk, ctx);
+  }
+
+  if (engine == Engine::REGISTER_VM) {
+    const RegisterChunk chunk = RegisterCompiler::compile(move(tree));
+    return RegisterVirtualMachine::run(chunk, ctx);
+  }
+
+  // The interpreter will progressively deallocate the nodes of the tree
+  Interpreter::set_shared_ctx(ctx);
+  return Interpreter::visit(move(tree));
+}
+
 // To run the CLI:
-unique_ptr<const RuntimeResult> runLine(const string& input, const shared_ptr<Context>& ctx) {
+unique_ptr<const RuntimeResult> runLine(const string& input, const shared_ptr<Context>& ctx, Engine::Type engine) {
   if (input.empty()) {
     return nullptr;
   }
@@ -21,12 +51,7 @@ unique_ptr<const RuntimeResult> runLine(const string& input, const shared_ptr<Co
     READ_FILES["<stdin>"] = make_shared<string>(input);
     Parser parser = Parser::initCLI(input);
     unique_ptr<ListNode> tree = parser.parse();
-
-    // The interpreter will progressively deallocate the nodes of the tree
-    Interpreter::set_shared_ctx(ctx);
-    unique_ptr<const RuntimeResult> result = Interpreter::visit(move(tree));
-
-    return result;
+    return make_unique<const RuntimeResult>(execute(move(tree), ctx, engine));
   } catch (CustomError& e) {
     cerr << e.to_string() << endl;
   } catch (Exception& e) {
@@ -37,7 +62,7 @@ unique_ptr<const RuntimeResult> runLine(const string& input, const shared_ptr<Co
 
 // When reading a file, the Lexer will read the file character by character
 // and construct a string containing the entire file (because the errors need it).
-unique_ptr<const RuntimeResult> runFile(const string& path, const shared_ptr<Context>& ctx) {
+unique_ptr<const RuntimeResult> runFile(const string& path, const shared_ptr<Context>& ctx, Engine::Type engine) {
   // I'm using a shared_ptr because I want READ_FILES to hold the value,
   // and I want the Lexer to be able to modify it.
   // I also want to use smart pointers for automatic memory management.
@@ -46,12 +71,7 @@ unique_ptr<const RuntimeResult> runFile(const string& path, const shared_ptr<Con
   try {
     Parser parser = Parser::initFile(source_code, path); // will take care of "READ_FILES"
     unique_ptr<ListNode> tree = parser.parse();
-
-    // The interpreter will progressively deallocate the nodes of the tree
-    Interpreter::set_shared_ctx(ctx);
-    unique_ptr<const RuntimeResult> result = Interpreter::visit(move(tree));
-
-    return result;
+    return make_unique<const RuntimeResult>(execute(move(tree), ctx, engine));
   } catch (CustomError& e) {
     cerr << e.to_string() << endl;
   } catch (Exception& e) {
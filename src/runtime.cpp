@@ -6,17 +6,18 @@ void RuntimeResult::reset() {
   error.reset();
 }
 
-shared_ptr<BaseRuntimeError> RuntimeResult::get_error() const { return error; }
-shared_ptr<Value> RuntimeResult::get_value() const { return value; }
+const BaseRuntimeError* RuntimeResult::get_error() const { return error.get(); }
+const Value* RuntimeResult::get_value() const { return value.get(); }
+unique_ptr<Value> RuntimeResult::take_value() { return move(value); }
 
-shared_ptr<Value> RuntimeResult::read(const unique_ptr<RuntimeResult>& res) {
-  if (res->get_error() != nullptr) error = res->get_error();
-  return res->get_value();
+unique_ptr<Value> RuntimeResult::read(RuntimeResult&& res) {
+  if (res.error != nullptr) error = move(res.error);
+  return move(res.value);
 }
 
 void RuntimeResult::success(unique_ptr<Value> v) {
   reset();
-  value = move(v); // transfers ownership of "v" to the shared_ptr "value"
+  value = move(v); // transfers ownership of "v" to this result
 } 
 
 void RuntimeResult::failure(unique_ptr<BaseRuntimeError> err) {
@@ -33,4 +34,4 @@ string RuntimeResult::to_string() const {
     return "RuntimeResult()";
   }
   return "RuntimeResult(value = " + value->to_string() + ")";
-}
\ No newline at end of file
+}
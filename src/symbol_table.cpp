@@ -1,4 +1,5 @@
 #include "../include/symbol_table.hpp"
+#include <functional>
 using namespace std;
 
 // without "move(p)" the argument would be copied twice:
@@ -7,17 +8,64 @@ using namespace std;
 // Here it's copied just once.
 SymbolTable::SymbolTable(shared_ptr<SymbolTable> p): parent(move(p)) {}
 
+size_t SymbolTable::hash(string_view name) { return std::hash<string_view>{}(name); }
+
+size_t SymbolTable::probe(string_view name, size_t hash) const {
+  const size_t mask = slots.size() - 1;
+  size_t i = hash & mask;
+  // The table is never full, so the probing ends on an empty slot
+  while (slots[i].entry.has_value() && (slots[i].hash != hash || slots[i].name != name)) {
+    i = (i + 1) & mask;
+  }
+  return i;
+}
+
+SymbolTableEntry* SymbolTable::find_locally(string_view name, size_t hash) {
+  if (number_of_symbols == 0) return nullptr;
+  slot_t& slot = slots[probe(name, hash)];
+  return slot.entry.has_value() ? &*slot.entry : nullptr;
+}
+
+const SymbolTableEntry* SymbolTable::find_locally(string_view name, size_t hash) const {
+  if (number_of_symbols == 0) return nullptr;
+  const slot_t& slot = slots[probe(name, hash)];
+  return slot.entry.has_value() ? &*slot.entry : nullptr;
+}
+
+SymbolTableEntry* SymbolTable::find(const string& name) {
+  const size_t h = hash(name);
+  for (SymbolTable* table = this; table != nullptr; table = table->parent.get()) {
+    SymbolTableEntry* entry = table->find_locally(name, h);
+    if (entry != nullptr) return entry;
+  }
+  return nullptr;
+}
+
+const SymbolTableEntry* SymbolTable::find(const string& name) const {
+  const size_t h = hash(name);
+  for (const SymbolTable* table = this; table != nullptr; table = table->parent.get()) {
+    const SymbolTableEntry* entry = table->find_locally(name, h);
+    if (entry != nullptr) return entry;
+  }
+  return nullptr;
+}
+
+void SymbolTable::grow() {
+  vector<slot_t> old_slots = move(slots);
+  slots = vector<slot_t>(max(old_slots.size() * 2, size_t(8)));
+  for (slot_t& slot : old_slots) {
+    if (slot.entry.has_value()) {
+      slots[probe(slot.name, slot.hash)] = move(slot);
+    }
+  }
+}
+
 bool SymbolTable::exists(const string& var_name) const {
-  return symbols.contains(var_name);
+  return find_locally(var_name, hash(var_name)) != nullptr;
 }
 
 bool SymbolTable::exists_globally(const string& var_name) const {
-  if (exists(var_name)) {
-    return true;
-  } else {
-    if (!has_parent()) return false;
-    return parent->exists_globally(var_name);
-  }
+  return find(var_name) != nullptr;
 }
 
 bool SymbolTable::has_parent() const {
@@ -25,42 +73,58 @@ bool SymbolTable::has_parent() const {
 }
 
 unique_ptr<Value> SymbolTable::get(const string& name) {
-  unique_ptr<Value> value = exists(name) ? unique_ptr<Value>(symbols[name]->get_copy()) : nullptr;
-  if (value == nullptr && has_parent()) {
-    return parent->get(name);
-  }
-  return value;
+  const SymbolTableEntry* entry = find(name);
+  return entry != nullptr ? unique_ptr<Value>(entry->get_copy()) : nullptr;
 }
 
 void SymbolTable::modify(const string& name, unique_ptr<Value> new_value) {
-  if (exists(name)) {
-    symbols[name]->overwrite_value(move(new_value));
-  } else {
-    if (!has_parent()) return;
-    parent->modify(name, move(new_value));
+  SymbolTableEntry* entry = find(name);
+  if (entry != nullptr) {
+    entry->overwrite_value(move(new_value));
   }
 }
 
 void SymbolTable::set(const string& name, unique_ptr<Value> value, bool constant) {
-  symbols[name] = make_unique<SymbolTableEntry>(
-    move(value),
-    constant
-  );
+  const size_t h = hash(name);
+  // The table is at most 3/4 full
+  if ((number_of_symbols + 1) * 4 > slots.size() * 3) {
+    grow();
+  }
+  slot_t& slot = slots[probe(name, h)];
+  if (!slot.entry.has_value()) {
+    slot.name = name;
+    slot.hash = h;
+    ++number_of_symbols;
+  }
+  slot.entry.emplace(move(value), constant);
 }
 
 bool SymbolTable::is_constant(const string& name) const {
-  if (exists(name)) {
-    return symbols.at(name)->is_constant();
-  }
-  return false;
+  const SymbolTableEntry* entry = find_locally(name, hash(name));
+  return entry != nullptr && entry->is_constant();
 }
 
 void SymbolTable::remove(const string& name) {
-  if (exists(name)) {
-    symbols.erase(name);
-  } else {
-    if (!has_parent()) return;
-    parent->remove(name);
+  const size_t h = hash(name);
+  for (SymbolTable* table = this; table != nullptr; table = table->parent.get()) {
+    if (table->number_of_symbols == 0) continue;
+    vector<slot_t>& table_slots = table->slots;
+    const size_t mask = table_slots.size() - 1;
+    size_t hole = table->probe(name, h);
+    if (!table_slots[hole].entry.has_value()) continue;
+    // The following entries of the probe sequence are shifted back into the hole,
+    // unless the hole is before the slot where their own probe sequence starts.
+    for (size_t i = (hole + 1) & mask; table_slots[i].entry.has_value(); i = (i + 1) & mask) {
+      const size_t start = table_slots[i].hash & mask;
+      if (((i - start) & mask) >= ((i - hole) & mask)) {
+        table_slots[hole] = move(table_slots[i]);
+        hole = i;
+      }
+    }
+    table_slots[hole].entry.reset();
+    table_slots[hole].name.clear();
+    --table->number_of_symbols;
+    return;
   }
 }
 
@@ -77,7 +141,8 @@ bool SymbolTable::does_constant_exist(const string& name) const {
 }
 
 void SymbolTable::clear() {
-  symbols.clear();
+  slots.clear();
+  number_of_symbols = 0;
 }
 
 SymbolTableEntry::SymbolTableEntry(
@@ -93,6 +158,14 @@ Value* SymbolTableEntry::get_copy() const {
   return value->copy();
 }
 
+const Value& SymbolTableEntry::get_value() const {
+  return *value;
+}
+
+Value& SymbolTableEntry::get_mutable_value() {
+  return *value;
+}
+
 void SymbolTableEntry::overwrite_value(unique_ptr<Value> new_value) {
   value.reset();
   value = move(new_value);
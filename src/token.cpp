@@ -21,11 +21,13 @@ Token::Token(
   string v,
   const Position& start,
   const Position* end,
-  const bool concatenation
+  const bool concatenation,
+  vector<interpolation_t> variables
 ):
   type(t),
   value(move(v)),
   allow_concatenation(concatenation),
+  interpolations(move(variables)),
   pos_start(start.copy()),
   pos_end(end == nullptr ? start.copy() : end->copy()) {}
 
@@ -49,4 +51,5 @@ string Token::getStringValue() const { return value; }
 bool Token::ofType(const TokenType& type) const { return this->type == type; }
 bool Token::notOfType(const TokenType& type) const { return !ofType(type); }
 bool Token::canConcatenate() const { return allow_concatenation; }
+const vector<interpolation_t>& Token::getInterpolations() const { return interpolations; }
 Token Token::copy() const { return { *this }; }
\ No newline at end of file
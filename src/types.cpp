@@ -8,6 +8,8 @@ string get_type_name(const Type& type) {
     case Type::STRING: return "string";
     case Type::BOOLEAN: return "bool";
     case Type::LIST: return "list";
+    case Type::BIGINT: return "int";
+    case Type::DICT: return "dict";
     default:
       return "Unknown type";
   }
@@ -19,5 +21,6 @@ Type get_type_from_name(const string& type) {
   if (type == "string") return Type::STRING;
   if (type == "bool") return Type::BOOLEAN;
   if (type == "list") return Type::LIST;
+  if (type == "dict") return Type::DICT;
   return Type::ERROR_TYPE;
 }
\ No newline at end of file
@@ -0,0 +1,411 @@
+#include <cmath>
+#include <algorithm>
+#include "../../include/utils/big_integer.hpp"
+#include "../../include/exceptions/exception.hpp"
+using namespace std;
+
+using limbs_t = BigInteger::limbs_t;
+using uint128_t = unsigned __int128;
+
+/// @brief The biggest power of 10 that fits in a limb.
+static constexpr uint64_t DECIMAL_BASE = 10000000000000000000ULL;
+static constexpr size_t DECIMAL_BASE_DIGITS = 19;
+
+/*
+*
+* Operations on magnitudes
+*
+*/
+
+static void trim(limbs_t& limbs) {
+  while (!limbs.empty() && limbs.back() == 0) {
+    limbs.pop_back();
+  }
+}
+
+static int compare_magnitudes(const limbs_t& a, const limbs_t& b) {
+  if (a.size() != b.size()) return a.size() < b.size() ? -1 : 1;
+  for (size_t i = a.size(); i-- > 0;) {
+    if (a[i] != b[i]) return a[i] < b[i] ? -1 : 1;
+  }
+  return 0;
+}
+
+/// @brief a += b * B^shift, where B is the base of the limbs (2^64).
+static void add_shifted(limbs_t& a, const limbs_t& b, size_t shift) {
+  if (a.size() < b.size() + shift) a.resize(b.size() + shift, 0);
+  uint64_t carry = 0;
+  size_t i = shift;
+  for (const uint64_t limb : b) {
+    const uint128_t sum = static_cast<uint128_t>(a[i]) + limb + carry;
+    a[i++] = static_cast<uint64_t>(sum);
+    carry = static_cast<uint64_t>(sum >> 64);
+  }
+  for (; carry != 0; ++i) {
+    if (i == a.size()) a.push_back(0);
+    const uint128_t sum = static_cast<uint128_t>(a[i]) + carry;
+    a[i] = static_cast<uint64_t>(sum);
+    carry = static_cast<uint64_t>(sum >> 64);
+  }
+}
+
+/// @brief a -= b, where a >= b.
+static void subtract_in_place(limbs_t& a, const limbs_t& b) {
+  uint64_t borrow = 0;
+  for (size_t i = 0; i < a.size() && (i < b.size() || borrow != 0); ++i) {
+    const uint64_t x = a[i];
+    const uint64_t y = i < b.size() ? b[i] : 0;
+    const uint64_t difference = x - y;
+    a[i] = difference - borrow;
+    borrow = (x < y) | (difference < borrow);
+  }
+  trim(a);
+}
+
+static limbs_t add_magnitudes(const limbs_t& a, const limbs_t& b) {
+  limbs_t result = a;
+  add_shifted(result, b, 0);
+  return result;
+}
+
+static limbs_t schoolbook_multiply(const uint64_t* a, size_t na, const uint64_t* b, size_t nb) {
+  limbs_t result(na + nb, 0);
+  for (size_t i = 0; i < na; ++i) {
+    uint64_t carry = 0;
+    for (size_t j = 0; j < nb; ++j) {
+      const uint128_t product = static_cast<uint128_t>(a[i]) * b[j] + result[i + j] + carry;
+      result[i + j] = static_cast<uint64_t>(product);
+      carry = static_cast<uint64_t>(product >> 64);
+    }
+    result[i + nb] = carry;
+  }
+  trim(result);
+  return result;
+}
+
+static limbs_t multiply_magnitudes(const uint64_t* a, size_t na, const uint64_t* b, size_t nb);
+
+/// @brief Multiplies two magnitudes with three half-size multiplications instead of four:
+/// with a = a1 * B^h + a0 and b = b1 * B^h + b0,
+/// a * b = z2 * B^2h + (z1 - z2 - z0) * B^h + z0,
+/// where z0 = a0 * b0, z2 = a1 * b1 and z1 = (a0 + a1) * (b0 + b1).
+static limbs_t karatsuba_multiply(const uint64_t* a, size_t na, const uint64_t* b, size_t nb) {
+  // na >= nb
+  const size_t half = na / 2;
+  if (nb <= half) {
+    // `b` doesn't have any high part, so a * b = a1 * b * B^h + a0 * b
+    limbs_t result = multiply_magnitudes(a, half, b, nb);
+    add_shifted(result, multiply_magnitudes(a + half, na - half, b, nb), half);
+    trim(result);
+    return result;
+  }
+
+  limbs_t a0(a, a + half);
+  limbs_t b0(b, b + half);
+  trim(a0);
+  trim(b0);
+  const limbs_t a1(a + half, a + na);
+  const limbs_t b1(b + half, b + nb);
+
+  const limbs_t z0 = multiply_magnitudes(a0.data(), a0.size(), b0.data(), b0.size());
+  const limbs_t z2 = multiply_magnitudes(a1.data(), a1.size(), b1.data(), b1.size());
+  const limbs_t sum_a = add_magnitudes(a0, a1);
+  const limbs_t sum_b = add_magnitudes(b0, b1);
+  limbs_t z1 = multiply_magnitudes(sum_a.data(), sum_a.size(), sum_b.data(), sum_b.size());
+  subtract_in_place(z1, z0);
+  subtract_in_place(z1, z2);
+
+  limbs_t result = z0;
+  add_shifted(result, z1, half);
+  add_shifted(result, z2, 2 * half);
+  trim(result);
+  return result;
+}
+
+static limbs_t multiply_magnitudes(const uint64_t* a, size_t na, const uint64_t* b, size_t nb) {
+  while (na > 0 && a[na - 1] == 0) --na;
+  while (nb > 0 && b[nb - 1] == 0) --nb;
+  if (na == 0 || nb == 0) return {};
+  if (na < nb) {
+    swap(a, b);
+    swap(na, nb);
+  }
+  if (nb < BigInteger::KARATSUBA_THRESHOLD) {
+    return schoolbook_multiply(a, na, b, nb);
+  }
+  return karatsuba_multiply(a, na, b, nb);
+}
+
+/// @brief Divides a magnitude by a single limb.
+/// @return The remainder.
+static uint64_t divide_by_limb(const limbs_t& a, uint64_t divisor, limbs_t& quotient) {
+  quotient.assign(a.size(), 0);
+  uint128_t remainder = 0;
+  for (size_t i = a.size(); i-- > 0;) {
+    const uint128_t current = (remainder << 64) | a[i];
+    quotient[i] = static_cast<uint64_t>(current / divisor);
+    remainder = current % divisor;
+  }
+  trim(quotient);
+  return static_cast<uint64_t>(remainder);
+}
+
+static limbs_t shift_left(const limbs_t& a, int bits, size_t size) {
+  limbs_t result(size, 0);
+  for (size_t i = 0; i < a.size(); ++i) {
+    result[i] |= bits == 0 ? a[i] : a[i] << bits;
+    if (bits != 0 && i + 1 < size) result[i + 1] = a[i] >> (64 - bits);
+  }
+  return result;
+}
+
+/// @brief Divides two magnitudes with the algorithm D of Knuth (The Art of Computer Programming, 4.3.1).
+static void divide_magnitudes(const limbs_t& dividend, const limbs_t& divisor, limbs_t& quotient, limbs_t& remainder) {
+  if (compare_magnitudes(dividend, divisor) < 0) {
+    quotient.clear();
+    remainder = dividend;
+    return;
+  }
+  if (divisor.size() == 1) {
+    const uint64_t rest = divide_by_limb(dividend, divisor[0], quotient);
+    remainder = rest == 0 ? limbs_t{} : limbs_t{ rest };
+    return;
+  }
+
+  // The divisor is normalized so that its most significant bit is set,
+  // which makes the estimation of each digit of the quotient off by 2 at most.
+  const size_t n = divisor.size();
+  const size_t m = dividend.size() - n;
+  const int shift = __builtin_clzll(divisor.back());
+  const limbs_t v = shift_left(divisor, shift, n);
+  limbs_t u = shift_left(dividend, shift, dividend.size() + 1);
+  quotient.assign(m + 1, 0);
+
+  for (size_t j = m + 1; j-- > 0;) {
+    const uint128_t numerator = (static_cast<uint128_t>(u[j + n]) << 64) | u[j + n - 1];
+    uint128_t estimate = numerator / v[n - 1];
+    uint128_t rest = numerator % v[n - 1];
+    while ((estimate >> 64) != 0 || estimate * v[n - 2] > ((rest << 64) | u[j + n - 2])) {
+      --estimate;
+      rest += v[n - 1];
+      if ((rest >> 64) != 0) break;
+    }
+
+    // u -= estimate * v (shifted by j limbs)
+    uint64_t carry = 0;
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < n; ++i) {
+      const uint128_t product = estimate * v[i] + carry;
+      carry = static_cast<uint64_t>(product >> 64);
+      const uint64_t low = static_cast<uint64_t>(product);
+      const uint64_t x = u[i + j];
+      const uint64_t difference = x - low;
+      u[i + j] = difference - borrow;
+      borrow = (x < low) | (difference < borrow);
+    }
+    const uint128_t subtrahend = static_cast<uint128_t>(carry) + borrow;
+    const bool is_negative = u[j + n] < subtrahend;
+    u[j + n] -= static_cast<uint64_t>(subtrahend);
+
+    // the estimate was one too big, so v is added back
+    if (is_negative) {
+      --estimate;
+      uint64_t sum_carry = 0;
+      for (size_t i = 0; i < n; ++i) {
+        const uint128_t sum = static_cast<uint128_t>(u[i + j]) + v[i] + sum_carry;
+        u[i + j] = static_cast<uint64_t>(sum);
+        sum_carry = static_cast<uint64_t>(sum >> 64);
+      }
+      u[j + n] += sum_carry;
+    }
+    quotient[j] = static_cast<uint64_t>(estimate);
+  }
+  trim(quotient);
+
+  remainder.assign(n, 0);
+  for (size_t i = 0; i < n; ++i) {
+    remainder[i] = shift == 0 ? u[i] : (u[i] >> shift) | (u[i + 1] << (64 - shift));
+  }
+  trim(remainder);
+}
+
+/// @brief Writes a magnitude that is smaller than 10^(19 * 2^level).
+/// @param pad Whether the number must be written with exactly 19 * 2^level digits (with leading zeros).
+static void write_decimal(const limbs_t& n, size_t level, const vector<limbs_t>& powers, bool pad, string& out) {
+  if (n.size() <= BigInteger::DECIMAL_THRESHOLD || level == 0) {
+    vector<uint64_t> chunks; // the least significant first
+    limbs_t rest = n;
+    while (!rest.empty()) {
+      limbs_t quotient;
+      chunks.push_back(divide_by_limb(rest, DECIMAL_BASE, quotient));
+      rest = move(quotient);
+    }
+    string digits;
+    for (size_t i = chunks.size(); i-- > 0;) {
+      const string chunk = std::to_string(chunks[i]);
+      if (i + 1 != chunks.size()) digits.append(DECIMAL_BASE_DIGITS - chunk.size(), '0');
+      digits += chunk;
+    }
+    if (pad) {
+      out.append((DECIMAL_BASE_DIGITS << level) - digits.size(), '0');
+    } else if (digits.empty()) {
+      digits = "0";
+    }
+    out += digits;
+    return;
+  }
+
+  limbs_t quotient;
+  limbs_t remainder;
+  divide_magnitudes(n, powers[level - 1], quotient, remainder);
+  if (quotient.empty() && !pad) {
+    write_decimal(remainder, level - 1, powers, false, out);
+    return;
+  }
+  write_decimal(quotient, level - 1, powers, pad, out);
+  write_decimal(remainder, level - 1, powers, true, out);
+}
+
+/*
+*
+* BigInteger
+*
+*/
+
+BigInteger::BigInteger(bool negative, limbs_t limbs): negative(negative), limbs(move(limbs)) {
+  trim(this->limbs);
+  if (this->limbs.empty()) this->negative = false;
+}
+
+BigInteger::BigInteger(int64_t value): negative(value < 0) {
+  // the magnitude is computed on unsigned integers, because -INT64_MIN doesn't fit in an int64_t
+  const uint64_t magnitude = negative ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+  if (magnitude != 0) limbs.push_back(magnitude);
+}
+
+BigInteger BigInteger::from_string(string_view digits) {
+  const bool is_negative = !digits.empty() && digits.front() == '-';
+  if (is_negative) digits.remove_prefix(1);
+  if (digits.empty() || !all_of(digits.begin(), digits.end(), [](char c) { return c >= '0' && c <= '9'; })) {
+    throw Exception("Invalid number", "'" + string(digits) + "' isn't an integer.");
+  }
+
+  limbs_t limbs;
+  size_t position = 0;
+  // the first chunk is shorter, so that all the other ones have exactly 19 digits
+  size_t length = digits.size() % DECIMAL_BASE_DIGITS;
+  if (length == 0) length = DECIMAL_BASE_DIGITS;
+  while (position < digits.size()) {
+    uint64_t chunk = 0;
+    uint64_t multiplier = 1;
+    for (size_t i = 0; i < length; ++i) {
+      chunk = chunk * 10 + static_cast<uint64_t>(digits[position + i] - '0');
+      multiplier *= 10;
+    }
+    // limbs = limbs * multiplier + chunk
+    uint64_t carry = chunk;
+    for (uint64_t& limb : limbs) {
+      const uint128_t product = static_cast<uint128_t>(limb) * multiplier + carry;
+      limb = static_cast<uint64_t>(product);
+      carry = static_cast<uint64_t>(product >> 64);
+    }
+    if (carry != 0) limbs.push_back(carry);
+    position += length;
+    length = DECIMAL_BASE_DIGITS;
+  }
+  return { is_negative, move(limbs) };
+}
+
+size_t BigInteger::bit_length() const {
+  if (limbs.empty()) return 0;
+  return limbs.size() * 64 - static_cast<size_t>(__builtin_clzll(limbs.back()));
+}
+
+bool BigInteger::fits_in_int64() const {
+  if (limbs.size() > 1) return false;
+  if (limbs.empty()) return true;
+  return negative ? limbs[0] <= static_cast<uint64_t>(INT64_MAX) + 1 : limbs[0] <= static_cast<uint64_t>(INT64_MAX);
+}
+
+int64_t BigInteger::to_int64() const {
+  if (limbs.empty()) return 0;
+  return negative ? static_cast<int64_t>(0 - limbs[0]) : static_cast<int64_t>(limbs[0]);
+}
+
+double BigInteger::to_double() const {
+  double result = 0;
+  for (size_t i = limbs.size(); i-- > 0;) {
+    result = result * 18446744073709551616.0 + static_cast<double>(limbs[i]);
+  }
+  return negative ? -result : result;
+}
+
+string BigInteger::to_string() const {
+  // powers[i] = 10^(19 * 2^i), until it's bigger than the number
+  vector<limbs_t> powers = { { DECIMAL_BASE } };
+  if (limbs.size() > DECIMAL_THRESHOLD) {
+    while (compare_magnitudes(powers.back(), limbs) <= 0) {
+      const limbs_t& last = powers.back();
+      powers.push_back(multiply_magnitudes(last.data(), last.size(), last.data(), last.size()));
+    }
+  }
+  string result = negative ? "-" : "";
+  write_decimal(limbs, powers.size() - 1, powers, false, result);
+  return result;
+}
+
+strong_ordering BigInteger::operator<=>(const BigInteger& other) const {
+  if (negative != other.negative) return negative ? strong_ordering::less : strong_ordering::greater;
+  const int comparison = compare_magnitudes(limbs, other.limbs);
+  if (comparison == 0) return strong_ordering::equal;
+  return (comparison < 0) != negative ? strong_ordering::less : strong_ordering::greater;
+}
+
+BigInteger BigInteger::operator-() const {
+  return { !negative, limbs };
+}
+
+BigInteger operator+(const BigInteger& a, const BigInteger& b) {
+  if (a.negative == b.negative) {
+    return { a.negative, add_magnitudes(a.limbs, b.limbs) };
+  }
+  // the result has the sign of the operand with the biggest magnitude
+  if (compare_magnitudes(a.limbs, b.limbs) >= 0) {
+    limbs_t result = a.limbs;
+    subtract_in_place(result, b.limbs);
+    return { a.negative, move(result) };
+  }
+  limbs_t result = b.limbs;
+  subtract_in_place(result, a.limbs);
+  return { b.negative, move(result) };
+}
+
+BigInteger operator-(const BigInteger& a, const BigInteger& b) {
+  return a + -b;
+}
+
+BigInteger operator*(const BigInteger& a, const BigInteger& b) {
+  return { a.negative != b.negative, multiply_magnitudes(a.limbs.data(), a.limbs.size(), b.limbs.data(), b.limbs.size()) };
+}
+
+void BigInteger::divide(const BigInteger& a, const BigInteger& b, BigInteger& quotient, BigInteger& remainder) {
+  if (b.is_zero()) {
+    throw Exception("Arithmetic error", "Division by zero isn't possible");
+  }
+  limbs_t q;
+  limbs_t r;
+  divide_magnitudes(a.limbs, b.limbs, q, r);
+  quotient = { a.negative != b.negative, move(q) };
+  remainder = { a.negative, move(r) };
+}
+
+BigInteger BigInteger::pow(uint64_t exponent) const {
+  BigInteger result(1);
+  BigInteger base = *this;
+  while (exponent != 0) {
+    if (exponent & 1) result = result * base;
+    exponent >>= 1;
+    if (exponent != 0) base = base * base;
+  }
+  return result;
+}
@@ -0,0 +1,24 @@
+#include "../../include/utils/checked_power.hpp"
+using namespace std;
+
+bool checked_power(int64_t base, int64_t exponent, int64_t& result) {
+  switch (base) {
+    case 0: result = exponent == 0 ? 1 : 0; return true;
+    case 1: result = 1; return true;
+    case -1: result = (exponent & 1) != 0 ? -1 : 1; return true;
+    default: break;
+  }
+  // |base| >= 2, so an exponent of 64 or more always overflows
+  if (exponent >= 64) return false;
+  // Squaring the base can only overflow if the result would overflow too,
+  // since the result is then multiplied by at least this square.
+  int64_t power = 1;
+  while (true) {
+    if ((exponent & 1) != 0 && __builtin_mul_overflow(power, base, &power)) return false;
+    exponent >>= 1;
+    if (exponent == 0) break;
+    if (__builtin_mul_overflow(base, base, &base)) return false;
+  }
+  result = power;
+  return true;
+}
\ No newline at end of file
@@ -0,0 +1,38 @@
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "../../include/utils/mapped_file.hpp"
+#include "../../include/exceptions/exception.hpp"
+using namespace std;
+
+MappedFile::MappedFile(const string& path) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw Exception("File error", "The file " + path + " doesn't exist.");
+  }
+  struct stat info{};
+  if (fstat(fd, &info) != 0) {
+    close(fd);
+    throw Exception("File error", "Failed to determine the size of " + path + ".");
+  }
+  length = static_cast<size_t>(info.st_size);
+  // mapping 0 bytes is an error
+  if (length > 0) {
+    void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+      close(fd);
+      throw Exception("File error", "Failed to map " + path + " into memory.");
+    }
+    // the file is read sequentially, so the OS can read ahead aggressively
+    madvise(mapping, length, MADV_SEQUENTIAL);
+    data = static_cast<const char*>(mapping);
+  }
+  close(fd); // the mapping stays valid after the file descriptor is closed
+}
+
+MappedFile::~MappedFile() {
+  if (data != nullptr) {
+    munmap(const_cast<char*>(data), length);
+  }
+}
@@ -0,0 +1,81 @@
+#include "../../include/values/bigint.hpp"
+#include "../../include/values/integer.hpp"
+#include "../../include/values/double.hpp"
+#include <cmath>
+using namespace std;
+
+BigIntValue::BigIntValue(BigInteger v): Value(BIGINT) {
+  payload.heap = new heap_t<BigInteger>(move(v));
+}
+
+Value* BigIntValue::make(BigInteger v) {
+  if (v.fits_in_int64()) {
+    return new IntegerValue(v.to_int64());
+  }
+  return new BigIntValue(move(v));
+}
+
+bool BigIntValue::is_truthy() const { return !get_actual_value().is_zero(); }
+string BigIntValue::to_string() const { return get_actual_value().to_string(); }
+BigIntValue* BigIntValue::copy() const { return new BigIntValue(*this); }
+
+unique_ptr<Value> BigIntValue::cast(Type output_type) const {
+  unique_ptr<Value> cast_value;
+  switch (output_type) {
+    case INT: cast_value = unique_ptr<BigIntValue>(copy()); break;
+    case DOUBLE: cast_value = make_unique<DoubleValue>(get_actual_value().to_double()); break;
+    default:
+      return nullptr;
+  }
+  return cast_value;
+}
+
+Value* BigIntValue::operator+(const BigIntValue& other) const {
+  return make(get_actual_value() + other.get_actual_value());
+}
+
+Value* BigIntValue::operator-(const BigIntValue& other) const {
+  return make(get_actual_value() - other.get_actual_value());
+}
+
+Value* BigIntValue::operator*(const BigIntValue& other) const {
+  return make(get_actual_value() * other.get_actual_value());
+}
+
+Value* BigIntValue::operator/(const BigIntValue& other) const {
+  if (other.get_actual_value().is_zero()) {
+    return nullptr;
+  }
+  BigInteger quotient, remainder;
+  BigInteger::divide(get_actual_value(), other.get_actual_value(), quotient, remainder);
+  return make(move(quotient));
+}
+
+Value* BigIntValue::operator%(const BigIntValue& other) const {
+  if (other.get_actual_value().is_zero()) {
+    return nullptr;
+  }
+  BigInteger quotient, remainder;
+  BigInteger::divide(get_actual_value(), other.get_actual_value(), quotient, remainder);
+  return make(move(remainder));
+}
+
+Value* BigIntValue::pow(const BigIntValue& other) const {
+  const BigInteger& base = get_actual_value();
+  const BigInteger& exponent = other.get_actual_value();
+  if (exponent.is_negative()) {
+    return new IntegerValue(static_cast<int64_t>(std::pow(base.to_double(), exponent.to_double())));
+  }
+  if (exponent.is_zero()) {
+    return new IntegerValue(1);
+  }
+  // 0, 1 and -1 are the only bases whose powers don't grow
+  if (base.bit_length() <= 1) {
+    if (base.is_zero()) return new IntegerValue(0);
+    return new IntegerValue(base.is_negative() && exponent.is_odd() ? -1 : 1);
+  }
+  if (!exponent.fits_in_int64() || base.bit_length() > MAX_POWER_BITS / static_cast<uint64_t>(exponent.to_int64())) {
+    return nullptr;
+  }
+  return make(base.pow(static_cast<uint64_t>(exponent.to_int64())));
+}
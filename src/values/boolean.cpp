@@ -5,16 +5,15 @@
 using namespace std;
 
 BooleanValue::BooleanValue(bool v): Value(BOOLEAN) {
-  actual_value = any(v);
+  payload.boolean = v;
 }
 
 BooleanValue::BooleanValue(): Value(BOOLEAN) {
-  actual_value = get_default_value();
+  payload.boolean = get_default_value();
 }
 
 bool BooleanValue::get_default_value() { return false; }
 
-bool BooleanValue::get_actual_value() const { return any_cast<bool>(actual_value); }
 bool BooleanValue::is_truthy() const { return get_actual_value(); }
 string BooleanValue::to_string() const { return std::to_string(get_actual_value()); }
 BooleanValue* BooleanValue::copy() const { return new BooleanValue(*this); }
@@ -28,8 +27,6 @@ unique_ptr<Value> BooleanValue::cast(Type output_type) const {
     default:
       return nullptr;
   }
-  cast_value->set_pos(pos_start, pos_end);
-  cast_value->set_ctx(context);
   return cast_value;
 }
 
@@ -0,0 +1,168 @@
+#include "../../include/values/dictionary.hpp"
+#include "../../include/values/integer.hpp"
+#include <bit>
+#include <functional>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+using namespace std;
+
+/*
+*
+* Storage
+*
+*/
+
+/// @brief Compares the control bytes of a group with a byte.
+/// @return A mask whose bit `i` is set if the control byte of the slot `i` of the group is `byte`.
+#if defined(__SSE2__)
+static uint32_t match_byte(const int8_t* group, int8_t byte) {
+  const __m128i control = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+  return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8(byte))));
+}
+#else
+static uint32_t match_byte(const int8_t* group, int8_t byte) {
+  uint32_t mask = 0;
+  for (size_t i = 0; i < dictionary_storage_t::GROUP_SIZE; ++i) {
+    if (group[i] == byte) mask |= uint32_t(1) << i;
+  }
+  return mask;
+}
+#endif
+
+/// @brief The 7 bits of a hash that are stored in the control byte of its slot.
+static int8_t control_byte(size_t hash) { return static_cast<int8_t>(hash & 0x7F); }
+
+/// @brief The group where the probe sequence of a hash starts.
+static size_t first_group(size_t hash, size_t number_of_groups) { return (hash >> 7) & (number_of_groups - 1); }
+
+dictionary_storage_t::dictionary_storage_t(const dictionary_storage_t& other):
+  heap_storage_t(), entries(other.entries), control(other.control), slots(other.slots) {}
+
+size_t dictionary_storage_t::hash(string_view key) { return std::hash<string_view>{}(key); }
+
+const dictionary_entry_t* dictionary_storage_t::find(string_view key, size_t hash) const {
+  if (entries.empty()) return nullptr;
+  const size_t number_of_groups = control.size() / GROUP_SIZE;
+  const int8_t byte = control_byte(hash);
+  size_t group = first_group(hash, number_of_groups);
+  // The groups are visited with a triangular sequence, which reaches all of them because their number is a power of two,
+  // and the table always has empty slots, so the probing ends.
+  for (size_t probe = 1; ; ++probe) {
+    const int8_t* group_control = control.data() + group * GROUP_SIZE;
+    for (uint32_t matches = match_byte(group_control, byte); matches != 0; matches &= matches - 1) {
+      const dictionary_entry_t& entry = entries[slots[group * GROUP_SIZE + countr_zero(matches)]];
+      if (entry.hash == hash && entry.key == key) return &entry;
+    }
+    if (match_byte(group_control, EMPTY) != 0) return nullptr;
+    group = (group + probe) & (number_of_groups - 1);
+  }
+}
+
+size_t dictionary_storage_t::find_empty_slot(size_t hash) const {
+  const size_t number_of_groups = control.size() / GROUP_SIZE;
+  size_t group = first_group(hash, number_of_groups);
+  for (size_t probe = 1; ; ++probe) {
+    const uint32_t empty = match_byte(control.data() + group * GROUP_SIZE, EMPTY);
+    if (empty != 0) return group * GROUP_SIZE + countr_zero(empty);
+    group = (group + probe) & (number_of_groups - 1);
+  }
+}
+
+void dictionary_storage_t::insert(string key, size_t hash, shared_ptr<const Value> value) {
+  const dictionary_entry_t* existing = find(key, hash);
+  if (existing != nullptr) {
+    entries[existing - entries.data()].value = move(value);
+    return;
+  }
+  // The table is at most 7/8 full
+  if ((entries.size() + 1) * 8 > control.size() * 7) {
+    grow();
+  }
+  const size_t slot = find_empty_slot(hash);
+  control[slot] = control_byte(hash);
+  slots[slot] = static_cast<uint32_t>(entries.size());
+  entries.push_back({ move(key), hash, move(value) });
+}
+
+void dictionary_storage_t::grow() {
+  const size_t capacity = max(control.size() * 2, GROUP_SIZE);
+  control.assign(capacity, EMPTY);
+  slots.assign(capacity, 0);
+  for (size_t i = 0; i < entries.size(); ++i) {
+    const size_t slot = find_empty_slot(entries[i].hash);
+    control[slot] = control_byte(entries[i].hash);
+    slots[slot] = static_cast<uint32_t>(i);
+  }
+}
+
+/*
+*
+* DictionaryValue
+*
+*/
+
+DictionaryValue::DictionaryValue(dictionary_storage_t* storage): Value(DICT) {
+  payload.heap = storage;
+}
+
+DictionaryValue::DictionaryValue(): DictionaryValue(new dictionary_storage_t()) {}
+
+/// @brief Stores the entries of a new dictionary.
+static dictionary_storage_t* make_storage(vector<pair<string, shared_ptr<const Value>>> entries) {
+  dictionary_storage_t* storage = new dictionary_storage_t();
+  for (auto& [key, value] : entries) {
+    const size_t hash = dictionary_storage_t::hash(key);
+    storage->insert(move(key), hash, move(value));
+  }
+  return storage;
+}
+
+DictionaryValue::DictionaryValue(
+  vector<pair<string, shared_ptr<const Value>>> entries
+): DictionaryValue(make_storage(move(entries))) {}
+
+const Value* DictionaryValue::get(string_view key) const {
+  const dictionary_entry_t* entry = get_storage().find(key, dictionary_storage_t::hash(key));
+  return entry != nullptr ? entry->value.get() : nullptr;
+}
+
+DictionaryValue* DictionaryValue::with_entry(string_view key, const Value& value) const {
+  DictionaryValue* dictionary = new DictionaryValue(*this);
+  dictionary->set(key, value);
+  return dictionary;
+}
+
+void DictionaryValue::set(string_view key, const Value& value) {
+  // A single reference means that no other dictionary can read the storage, even from another thread
+  if (payload.heap->references.load(memory_order_acquire) != 1) {
+    const heap_storage_t* shared = payload.heap;
+    payload.heap = new dictionary_storage_t(get_storage());
+    if (shared->references.fetch_sub(1, memory_order_acq_rel) == 1) {
+      delete shared;
+    }
+  }
+  const_cast<dictionary_storage_t*>(&get_storage())->insert(string(key), dictionary_storage_t::hash(key), shared_ptr<const Value>(value.copy()));
+}
+
+bool DictionaryValue::is_truthy() const { return size() != 0; }
+DictionaryValue* DictionaryValue::copy() const { return new DictionaryValue(*this); }
+
+string DictionaryValue::to_string() const {
+  string res = "{";
+  for (const dictionary_entry_t& entry : get_entries()) {
+    if (res.size() > 1) res += ", ";
+    res += entry.key + ": " + entry.value->to_string();
+  }
+  return res + "}";
+}
+
+unique_ptr<Value> DictionaryValue::cast(const Type output_type) const {
+  unique_ptr<Value> cast_value = nullptr;
+  switch (output_type) {
+    case INT: cast_value = make_unique<IntegerValue>(static_cast<int64_t>(size())); break;
+    default:
+      return nullptr;
+  }
+  return cast_value;
+}
\ No newline at end of file
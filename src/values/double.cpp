@@ -5,15 +5,14 @@
 using namespace std;
 
 DoubleValue::DoubleValue(double v): Value(DOUBLE) {
-  actual_value = any(v);
+  payload.floating_point = v;
 }
 
 DoubleValue::DoubleValue(): Value(DOUBLE) {
-  actual_value = get_default_value();
+  payload.floating_point = get_default_value();
 }
 
 double DoubleValue::get_default_value() { return 0.0; }
-double DoubleValue::get_actual_value() const { return any_cast<double>(actual_value); }
 bool DoubleValue::is_truthy() const { return get_actual_value() != 0.0; }
 string DoubleValue::to_string() const { return double_to_string(get_actual_value()); }
 DoubleValue* DoubleValue::copy() const { return new DoubleValue(*this); }
@@ -25,8 +24,6 @@ unique_ptr<Value> DoubleValue::cast(Type output_type) const {
     default:
       return nullptr;
   }
-  cast_value->set_pos(pos_start, pos_end);
-  cast_value->set_ctx(context);
   return cast_value;
 } 
 
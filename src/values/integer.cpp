@@ -1,19 +1,20 @@
 #include "../../include/values/integer.hpp"
 #include "../../include/values/double.hpp"
+#include "../../include/values/bigint.hpp"
+#include "../../include/utils/checked_power.hpp"
 #include <cmath>
 using namespace std;
 
-IntegerValue::IntegerValue(int v): Value(INT) {
-  actual_value = any(v);
+IntegerValue::IntegerValue(int64_t v): Value(INT) {
+  payload.integer = v;
 }
 
 IntegerValue::IntegerValue(): Value(INT) {
-  actual_value = get_default_value();
+  payload.integer = get_default_value();
 }
 
-int IntegerValue::get_default_value() { return 0; }
+int64_t IntegerValue::get_default_value() { return 0; }
 
-int IntegerValue::get_actual_value() const { return any_cast<int>(actual_value); }
 bool IntegerValue::is_truthy() const { return get_actual_value() != 0; }
 string IntegerValue::to_string() const { return std::to_string(get_actual_value()); }
 IntegerValue* IntegerValue::copy() const { return new IntegerValue(*this); }
@@ -22,11 +23,10 @@ unique_ptr<Value> IntegerValue::cast(Type output_type) const {
   unique_ptr<Value> cast_value;
   switch (output_type) {
     case DOUBLE: cast_value = make_unique<DoubleValue>(static_cast<double>(get_actual_value())); break;
+    case BIGINT: cast_value = unique_ptr<IntegerValue>(copy()); break;
     default:
       return nullptr;
   }
-  cast_value->set_pos(pos_start, pos_end);
-  cast_value->set_ctx(context);
   return cast_value;
 }
 
@@ -36,10 +36,15 @@ unique_ptr<Value> IntegerValue::cast(Type output_type) const {
 *
 */
 
-IntegerValue* IntegerValue::operator+(const IntegerValue& other) const {
-  return new IntegerValue{
-    get_actual_value() + other.get_actual_value()
-  };
+// The checked operations of GCC and Clang only cost a branch on the overflow flag,
+// so the big integers are only used when it's actually needed.
+
+Value* IntegerValue::operator+(const IntegerValue& other) const {
+  int64_t result;
+  if (__builtin_add_overflow(get_actual_value(), other.get_actual_value(), &result)) {
+    return new BigIntValue(BigInteger(get_actual_value()) + BigInteger(other.get_actual_value()));
+  }
+  return new IntegerValue(result);
 }
 
 DoubleValue* IntegerValue::operator+(const DoubleValue& other) const {
@@ -54,10 +59,12 @@ DoubleValue* IntegerValue::operator+(const DoubleValue& other) const {
 *
 */
 
-IntegerValue* IntegerValue::operator-(const IntegerValue& other) const {
-  return new IntegerValue(
-    get_actual_value() - other.get_actual_value()
-  );
+Value* IntegerValue::operator-(const IntegerValue& other) const {
+  int64_t result;
+  if (__builtin_sub_overflow(get_actual_value(), other.get_actual_value(), &result)) {
+    return new BigIntValue(BigInteger(get_actual_value()) - BigInteger(other.get_actual_value()));
+  }
+  return new IntegerValue(result);
 }
 
 DoubleValue* IntegerValue::operator-(const DoubleValue& other) const {
@@ -72,10 +79,12 @@ DoubleValue* IntegerValue::operator-(const DoubleValue& other) const {
 *
 */
 
-IntegerValue* IntegerValue::operator*(const IntegerValue& other) const {
-  return new IntegerValue(
-    get_actual_value() * other.get_actual_value()
-  );
+Value* IntegerValue::operator*(const IntegerValue& other) const {
+  int64_t result;
+  if (__builtin_mul_overflow(get_actual_value(), other.get_actual_value(), &result)) {
+    return new BigIntValue(BigInteger(get_actual_value()) * BigInteger(other.get_actual_value()));
+  }
+  return new IntegerValue(result);
 }
 
 DoubleValue* IntegerValue::operator*(const DoubleValue& other) const {
@@ -90,10 +99,14 @@ DoubleValue* IntegerValue::operator*(const DoubleValue& other) const {
 *
 */
 
-IntegerValue* IntegerValue::operator/(const IntegerValue& other) const {
+Value* IntegerValue::operator/(const IntegerValue& other) const {
   if (other.get_actual_value() == 0) {
     return nullptr;
   }
+  // the smallest integer divided by -1 is the only division that overflows
+  if (other.get_actual_value() == -1 && get_actual_value() == INT64_MIN) {
+    return new BigIntValue(-BigInteger(INT64_MIN));
+  }
   return new IntegerValue(
     get_actual_value() / other.get_actual_value()
   );
@@ -118,6 +131,10 @@ IntegerValue* IntegerValue::operator%(const IntegerValue& other) const {
   if (other.get_actual_value() == 0) {
     return nullptr;
   }
+  // the result is 0, but the smallest integer % -1 traps on some CPUs
+  if (other.get_actual_value() == -1) {
+    return new IntegerValue(0);
+  }
   return new IntegerValue(
     get_actual_value() % other.get_actual_value()
   );
@@ -130,4 +147,37 @@ DoubleValue* IntegerValue::operator%(const DoubleValue& other) const {
   return new DoubleValue{
     std::fmod(get_actual_value(), other.get_actual_value())
   };
+}
+
+/*
+*
+* Powers
+*
+*/
+
+Value* IntegerValue::pow(const IntegerValue& other) const {
+  const int64_t base = get_actual_value();
+  const int64_t exponent = other.get_actual_value();
+  if (exponent < 0) {
+    return new IntegerValue(static_cast<int64_t>(std::pow(base, exponent)));
+  }
+
+  // The trivial powers don't need any loop
+  if (exponent == 0) return new IntegerValue(1);
+  if (exponent == 1) return new IntegerValue(base);
+  switch (base) {
+    case 0: return new IntegerValue(0);
+    case 1: return new IntegerValue(1);
+    case -1: return new IntegerValue((exponent & 1) != 0 ? -1 : 1);
+    case 2: if (exponent < 63) return new IntegerValue(int64_t{1} << exponent); break;
+    default: break;
+  }
+
+  int64_t result;
+  if (exponent == 2) {
+    if (!__builtin_mul_overflow(base, base, &result)) return new IntegerValue(result);
+  } else if (checked_power(base, exponent, result)) {
+    return new IntegerValue(result);
+  }
+  return BigIntValue(BigInteger(base)).pow(BigIntValue(BigInteger(exponent)));
 }
\ No newline at end of file
@@ -1,25 +1,221 @@
 #include "../../include/values/value.hpp"
 #include "../../include/values/integer.hpp"
+#include "../../include/values/double.hpp"
+#include "../../include/values/boolean.hpp"
 #include "../../include/values/list.hpp"
+#include "../../include/utils/double_to_string.hpp"
 using namespace std;
 
+/*
+*
+* Storage
+*
+*/
+
+/// @brief Finds out how a list should be stored.
+/// @param elements The elements of the list.
+/// @return The unboxed kind of a large homogeneous list, `ListKind::VALUES` otherwise.
+static ListKind::Kind classify(const list_of_values_ptr& elements) {
+  if (elements.size() < list_storage_t::UNBOXING_THRESHOLD) return ListKind::VALUES;
+  const Type type = elements.front()->get_type();
+  for (const auto& element : elements) {
+    if (element->get_type() != type) return ListKind::VALUES;
+  }
+  switch (type) {
+    case INT: return ListKind::INTEGERS;
+    case DOUBLE: return ListKind::DOUBLES;
+    case BOOLEAN: return ListKind::BOOLEANS;
+    default:
+      return ListKind::VALUES;
+  }
+}
+
+list_storage_t::list_storage_t(list_of_values_ptr elements): kind(classify(elements)) {
+  switch (kind) {
+    case ListKind::INTEGERS:
+      integers.reserve(elements.size());
+      for (const auto& element : elements) integers.push_back(static_cast<const IntegerValue&>(*element).get_actual_value());
+      break;
+    case ListKind::DOUBLES:
+      doubles.reserve(elements.size());
+      for (const auto& element : elements) doubles.push_back(static_cast<const DoubleValue&>(*element).get_actual_value());
+      break;
+    case ListKind::BOOLEANS:
+      booleans.reserve(elements.size());
+      for (const auto& element : elements) booleans.push_back(static_cast<const BooleanValue&>(*element).get_actual_value());
+      break;
+    case ListKind::VALUES:
+      values = move(elements);
+      break;
+  }
+}
+
+list_storage_t::list_storage_t(vector<int64_t> elements): kind(ListKind::INTEGERS), integers(move(elements)) {}
+list_storage_t::list_storage_t(vector<double> elements): kind(ListKind::DOUBLES), doubles(move(elements)) {}
+list_storage_t::list_storage_t(vector<uint8_t> elements): kind(ListKind::BOOLEANS), booleans(move(elements)) {}
+
+list_storage_t::list_storage_t(
+  const list_storage_t* parent,
+  size_t offset,
+  size_t length
+): kind(parent->kind), parent(parent), offset(offset), length(length) {}
+
+list_storage_t::~list_storage_t() {
+  // The parent is never a slice, so releasing it doesn't release anything else
+  if (parent != nullptr && parent->references.fetch_sub(1, memory_order_acq_rel) == 1) {
+    delete parent;
+  }
+}
+
+size_t list_storage_t::size() const {
+  if (is_slice() || is_persistent()) return length;
+  switch (kind) {
+    case ListKind::INTEGERS: return integers.size();
+    case ListKind::DOUBLES: return doubles.size();
+    case ListKind::BOOLEANS: return booleans.size();
+    case ListKind::VALUES:
+    default:
+      return values.size();
+  }
+}
+
+void list_storage_t::box() const {
+  values.reserve(size());
+  switch (kind) {
+    case ListKind::INTEGERS:
+      for (const int64_t integer : get_integers()) values.push_back(make_shared<IntegerValue>(integer));
+      break;
+    case ListKind::DOUBLES:
+      for (const double d : get_doubles()) values.push_back(make_shared<DoubleValue>(d));
+      break;
+    case ListKind::BOOLEANS:
+      for (const uint8_t boolean : get_booleans()) values.push_back(make_shared<BooleanValue>(boolean != 0));
+      break;
+    case ListKind::VALUES:
+      break;
+  }
+}
+
+void list_storage_t::flatten() const {
+  switch (kind) {
+    case ListKind::INTEGERS: get_trie<int64_t>().append_to(integers); break;
+    case ListKind::DOUBLES: get_trie<double>().append_to(doubles); break;
+    case ListKind::BOOLEANS: get_trie<uint8_t>().append_to(booleans); break;
+    case ListKind::VALUES: get_trie<shared_ptr<const Value>>().append_to(values); break;
+  }
+}
+
+/// @brief Creates a storage of the same kind as `storage`, with a different element.
+/// @param elements Reads the contiguous elements of the storage (they're not read if the storage is persistent).
+/// @param index The index of the element to replace.
+/// @param element The new element, of the type of the kind of the storage.
+template <typename T>
+static list_storage_t* replace(const list_storage_t& storage, span<const T> (list_storage_t::*elements)() const, size_t index, T element) {
+  if (storage.is_persistent()) {
+    return new list_storage_t(storage.kind, storage.get_trie<T>().set(index, move(element)));
+  }
+  const span<const T> contiguous = (storage.*elements)();
+  if (contiguous.size() <= PersistentVector<T>::BRANCHING) {
+    vector<T> copy(contiguous.begin(), contiguous.end());
+    copy[index] = move(element);
+    return new list_storage_t(move(copy));
+  }
+  return new list_storage_t(storage.kind, PersistentVector<T>(contiguous).set(index, move(element)));
+}
+
+/*
+*
+* ListValue
+*
+*/
+
 ListValue::ListValue(
-  list<shared_ptr<const Value>> elts
-): Value(LIST), elements(move(elts)) {}
+  list_of_values_ptr elts
+): Value(LIST) {
+  payload.heap = new list_storage_t(move(elts));
+}
+
+ListValue::ListValue(list_storage_t* storage): Value(LIST) {
+  payload.heap = storage;
+}
+
+ListValue* ListValue::from_integers(vector<int64_t> elements) { return new ListValue(new list_storage_t(move(elements))); }
+ListValue* ListValue::from_doubles(vector<double> elements) { return new ListValue(new list_storage_t(move(elements))); }
+
+Value* ListValue::get_element(size_t index) const {
+  const list_storage_t& storage = get_storage();
+  if (storage.is_persistent()) {
+    switch (storage.kind) {
+      case ListKind::INTEGERS: return new IntegerValue(storage.get_trie<int64_t>()[index]);
+      case ListKind::DOUBLES: return new DoubleValue(storage.get_trie<double>()[index]);
+      case ListKind::BOOLEANS: return new BooleanValue(storage.get_trie<uint8_t>()[index] != 0);
+      case ListKind::VALUES:
+      default:
+        return storage.get_trie<shared_ptr<const Value>>()[index]->copy();
+    }
+  }
+  switch (storage.kind) {
+    case ListKind::INTEGERS: return new IntegerValue(storage.get_integers()[index]);
+    case ListKind::DOUBLES: return new DoubleValue(storage.get_doubles()[index]);
+    case ListKind::BOOLEANS: return new BooleanValue(storage.get_booleans()[index] != 0);
+    case ListKind::VALUES:
+    default:
+      return storage.boxed()[index]->copy();
+  }
+}
+
+ListValue* ListValue::slice(size_t start, size_t end) const {
+  const list_storage_t& storage = get_storage();
+  const list_storage_t* parent = storage.is_slice() ? storage.parent : &storage;
+  parent->references.fetch_add(1, memory_order_relaxed);
+  return new ListValue(new list_storage_t(parent, storage.offset + start, end - start));
+}
+
+ListValue* ListValue::with_element(size_t index, const Value& element) const {
+  const list_storage_t& storage = get_storage();
+  // An unboxed list stays unboxed if the new element has the same type as the other ones
+  if (storage.kind == ListKind::INTEGERS && element.get_type() == INT) {
+    return new ListValue(replace<int64_t>(storage, &list_storage_t::get_integers, index, static_cast<const IntegerValue&>(element).get_actual_value()));
+  }
+  if (storage.kind == ListKind::DOUBLES && element.get_type() == DOUBLE) {
+    return new ListValue(replace<double>(storage, &list_storage_t::get_doubles, index, static_cast<const DoubleValue&>(element).get_actual_value()));
+  }
+  if (storage.kind == ListKind::BOOLEANS && element.get_type() == BOOLEAN) {
+    return new ListValue(replace<uint8_t>(storage, &list_storage_t::get_booleans, index, static_cast<const BooleanValue&>(element).get_actual_value()));
+  }
+  shared_ptr<const Value> handle(element.copy());
+  if (storage.kind == ListKind::VALUES) {
+    return new ListValue(replace<shared_ptr<const Value>>(storage, &list_storage_t::boxed, index, move(handle)));
+  }
+  // The other elements are boxed, once, to store an element of another type
+  const list_of_values_view handles = storage.boxed();
+  if (handles.size() <= PersistentVector<shared_ptr<const Value>>::BRANCHING) {
+    list_of_values_ptr elements(handles.begin(), handles.end());
+    elements[index] = move(handle);
+    return new ListValue(move(elements));
+  }
+  return new ListValue(new list_storage_t(ListKind::VALUES, PersistentVector<shared_ptr<const Value>>(handles).set(index, move(handle))));
+}
 
-list<shared_ptr<const Value>> ListValue::get_elements() const { return elements; }
-bool ListValue::is_truthy() const { return !elements.empty(); }
+bool ListValue::is_truthy() const { return size() != 0; }
 ListValue* ListValue::copy() const { return new ListValue(*this); }
 
 string ListValue::to_string() const {
-  if (elements.empty()) {
+  // The unboxed elements are printed directly, without boxing them
+  const list_storage_t& storage = get_storage();
+  const size_t length = storage.size();
+  if (length == 0) {
     return "[]";
   }
-  auto iter = elements.begin();
-  string res = "[" + (*iter)->to_string();
-  ++iter;
-  while (iter != elements.end()) {
-    res += ", " + (*iter)->to_string();
+  string res = "[";
+  for (size_t i = 0; i < length; ++i) {
+    if (i != 0) res += ", ";
+    switch (storage.kind) {
+      case ListKind::INTEGERS: res += std::to_string(storage.get_integers()[i]); break;
+      case ListKind::DOUBLES: res += double_to_string(storage.get_doubles()[i]); break;
+      case ListKind::BOOLEANS: res += std::to_string(storage.get_booleans()[i] != 0); break;
+      case ListKind::VALUES: res += storage.boxed()[i]->to_string(); break;
+    }
   }
   return res + "]";
 }
@@ -27,11 +223,9 @@ string ListValue::to_string() const {
 unique_ptr<Value> ListValue::cast(const Type output_type) const {
   unique_ptr<Value> cast_value = nullptr;
   switch (output_type) {
-    case INT: cast_value = make_unique<IntegerValue>(elements.size()); break;
+    case INT: cast_value = make_unique<IntegerValue>(static_cast<int64_t>(size())); break;
     default:
       return nullptr;
   }
-  cast_value->set_pos(pos_start, pos_end);
-  cast_value->set_ctx(context);
   return cast_value;
-}
\ No newline at end of file
+}
@@ -0,0 +1,405 @@
+#include "../../include/values/list_operations.hpp"
+#include "../../include/values/integer.hpp"
+#include "../../include/values/double.hpp"
+#include "../../include/values/boolean.hpp"
+#include "../../include/values/bigint.hpp"
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define BK_X86_64_KERNELS
+#endif
+using namespace std;
+
+/*
+*
+* Kernels
+*
+* Each kernel has an AVX2 version, compiled for this instruction set only (the rest of the program doesn't require it),
+* and a scalar version, used when the processor doesn't support AVX2 and for the last elements.
+* The floating-point reductions accumulate 4 lanes in both versions, and combine them the same way,
+* so that the result doesn't depend on the processor.
+*
+*/
+
+static constexpr size_t LANES = 4;
+
+/// @brief Combines the 4 lanes of a reduction, in the same order in both versions.
+template <typename T, typename Op>
+static T combine_lanes(const T lanes[LANES], Op op) {
+  return op(op(lanes[0], lanes[1]), op(lanes[2], lanes[3]));
+}
+
+#ifdef BK_X86_64_KERNELS
+#define BK_AVX2 __attribute__((target("avx2")))
+
+BK_AVX2 static bool sum_integers_avx2(const int64_t* a, size_t n, int64_t* lanes) {
+  __m256i total = _mm256_setzero_si256();
+  __m256i overflow = _mm256_setzero_si256();
+  for (size_t i = 0; i + LANES <= n; i += LANES) {
+    const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    const __m256i r = _mm256_add_epi64(total, x);
+    // an addition overflows if both operands have the same sign, and the result a different one
+    overflow = _mm256_or_si256(overflow, _mm256_and_si256(_mm256_xor_si256(total, r), _mm256_xor_si256(x, r)));
+    total = r;
+  }
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), total);
+  return _mm256_movemask_pd(_mm256_castsi256_pd(overflow)) != 0;
+}
+
+BK_AVX2 static void sum_doubles_avx2(const double* a, size_t n, double* lanes) {
+  __m256d total = _mm256_setzero_pd();
+  for (size_t i = 0; i + LANES <= n; i += LANES) {
+    total = _mm256_add_pd(total, _mm256_loadu_pd(a + i));
+  }
+  _mm256_storeu_pd(lanes, total);
+}
+
+BK_AVX2 static void dot_doubles_avx2(const double* a, const double* b, size_t n, double* lanes) {
+  __m256d total = _mm256_setzero_pd();
+  for (size_t i = 0; i + LANES <= n; i += LANES) {
+    total = _mm256_add_pd(total, _mm256_mul_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+  }
+  _mm256_storeu_pd(lanes, total);
+}
+
+BK_AVX2 static void min_max_integers_avx2(const int64_t* a, size_t n, bool maximum, int64_t* lanes) {
+  __m256i best = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a));
+  for (size_t i = LANES; i + LANES <= n; i += LANES) {
+    const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    // there is no 64-bit min/max before AVX-512, so a comparison selects the lanes
+    const __m256i replace = maximum ? _mm256_cmpgt_epi64(x, best) : _mm256_cmpgt_epi64(best, x);
+    best = _mm256_blendv_epi8(best, x, replace);
+  }
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), best);
+}
+
+BK_AVX2 static void min_max_doubles_avx2(const double* a, size_t n, bool maximum, double* lanes) {
+  __m256d best = _mm256_loadu_pd(a);
+  for (size_t i = LANES; i + LANES <= n; i += LANES) {
+    const __m256d x = _mm256_loadu_pd(a + i);
+    best = maximum ? _mm256_max_pd(x, best) : _mm256_min_pd(x, best);
+  }
+  _mm256_storeu_pd(lanes, best);
+}
+
+BK_AVX2 static bool add_integers_avx2(const int64_t* a, const int64_t* b, int64_t* out, size_t n) {
+  __m256i overflow = _mm256_setzero_si256();
+  for (size_t i = 0; i + LANES <= n; i += LANES) {
+    const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+    const __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+    const __m256i r = _mm256_add_epi64(x, y);
+    overflow = _mm256_or_si256(overflow, _mm256_and_si256(_mm256_xor_si256(x, r), _mm256_xor_si256(y, r)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), r);
+  }
+  return _mm256_movemask_pd(_mm256_castsi256_pd(overflow)) != 0;
+}
+
+BK_AVX2 static void add_doubles_avx2(const double* a, const double* b, double* out, size_t n) {
+  for (size_t i = 0; i + LANES <= n; i += LANES) {
+    _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+  }
+}
+
+BK_AVX2 static void scale_doubles_avx2(const double* a, double factor, double* out, size_t n) {
+  const __m256d f = _mm256_set1_pd(factor);
+  for (size_t i = 0; i + LANES <= n; i += LANES) {
+    _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(a + i), f));
+  }
+}
+#endif
+
+bool ListOperations::uses_avx2() {
+#ifdef BK_X86_64_KERNELS
+  static const bool supported = __builtin_cpu_supports("avx2");
+  return supported;
+#else
+  return false;
+#endif
+}
+
+/// @brief The number of elements that the AVX2 kernels process (a multiple of 4), 0 if they aren't used.
+static size_t vectorized_length(size_t n) {
+  return ListOperations::uses_avx2() ? n - n % LANES : 0;
+}
+
+/// @brief Adds integers, detecting the overflows.
+/// @return Whether the sum (or a partial sum) overflowed.
+static bool sum_integers(const int64_t* a, size_t n, int64_t* result) {
+  bool overflow = false;
+  int64_t total = 0;
+  size_t i = 0;
+#ifdef BK_X86_64_KERNELS
+  if ((i = vectorized_length(n)) != 0) {
+    int64_t lanes[LANES];
+    overflow = sum_integers_avx2(a, i, lanes);
+    for (const int64_t lane : lanes) overflow |= __builtin_add_overflow(total, lane, &total);
+  }
+#endif
+  for (; i < n; ++i) overflow |= __builtin_add_overflow(total, a[i], &total);
+  *result = total;
+  return overflow;
+}
+
+static double sum_doubles(const double* a, size_t n) {
+  double lanes[LANES] = { 0, 0, 0, 0 };
+  const size_t vectorized = n - n % LANES;
+#ifdef BK_X86_64_KERNELS
+  if (ListOperations::uses_avx2()) {
+    sum_doubles_avx2(a, vectorized, lanes);
+  } else
+#endif
+  for (size_t i = 0; i < vectorized; i += LANES) {
+    for (size_t lane = 0; lane < LANES; ++lane) lanes[lane] += a[i + lane];
+  }
+  double total = combine_lanes(lanes, [](double x, double y) { return x + y; });
+  for (size_t i = vectorized; i < n; ++i) total += a[i];
+  return total;
+}
+
+static double dot_doubles(const double* a, const double* b, size_t n) {
+  double lanes[LANES] = { 0, 0, 0, 0 };
+  const size_t vectorized = n - n % LANES;
+#ifdef BK_X86_64_KERNELS
+  if (ListOperations::uses_avx2()) {
+    dot_doubles_avx2(a, b, vectorized, lanes);
+  } else
+#endif
+  for (size_t i = 0; i < vectorized; i += LANES) {
+    for (size_t lane = 0; lane < LANES; ++lane) lanes[lane] += a[i + lane] * b[i + lane];
+  }
+  double total = combine_lanes(lanes, [](double x, double y) { return x + y; });
+  for (size_t i = vectorized; i < n; ++i) total += a[i] * b[i];
+  return total;
+}
+
+/// @brief Gets the smallest or the biggest of `n` numbers (`n` > 0).
+/// The comparison `x < best` (or `x > best`) is the one of `_mm256_min_pd` (or `_mm256_max_pd`).
+template <typename T>
+static T min_max(const T* a, size_t n, bool maximum) {
+  const auto better = [maximum](T x, T best) { return maximum ? (x > best ? x : best) : (x < best ? x : best); };
+  if (n < LANES) {
+    T best = a[0];
+    for (size_t i = 1; i < n; ++i) best = better(a[i], best);
+    return best;
+  }
+  T lanes[LANES] = { a[0], a[1], a[2], a[3] };
+  const size_t vectorized = n - n % LANES;
+#ifdef BK_X86_64_KERNELS
+  if (ListOperations::uses_avx2()) {
+    if constexpr (is_same_v<T, int64_t>) min_max_integers_avx2(a, vectorized, maximum, lanes);
+    else min_max_doubles_avx2(a, vectorized, maximum, lanes);
+  } else
+#endif
+  for (size_t i = LANES; i < vectorized; i += LANES) {
+    for (size_t lane = 0; lane < LANES; ++lane) lanes[lane] = better(a[i + lane], lanes[lane]);
+  }
+  T best = combine_lanes(lanes, better);
+  for (size_t i = vectorized; i < n; ++i) best = better(a[i], best);
+  return best;
+}
+
+/// @return Whether one of the additions overflowed.
+static bool add_integers(const int64_t* a, const int64_t* b, int64_t* out, size_t n) {
+  bool overflow = false;
+  size_t i = 0;
+#ifdef BK_X86_64_KERNELS
+  if ((i = vectorized_length(n)) != 0) overflow = add_integers_avx2(a, b, out, i);
+#endif
+  for (; i < n; ++i) overflow |= __builtin_add_overflow(a[i], b[i], &out[i]);
+  return overflow;
+}
+
+static void add_doubles(const double* a, const double* b, double* out, size_t n) {
+  size_t i = 0;
+#ifdef BK_X86_64_KERNELS
+  if ((i = vectorized_length(n)) != 0) add_doubles_avx2(a, b, out, i);
+#endif
+  for (; i < n; ++i) out[i] = a[i] + b[i];
+}
+
+/// @return Whether one of the multiplications overflowed.
+/// AVX2 doesn't multiply 64-bit integers, so it's always a scalar loop (that the compiler may still unroll).
+static bool scale_integers(const int64_t* a, int64_t factor, int64_t* out, size_t n) {
+  bool overflow = false;
+  for (size_t i = 0; i < n; ++i) overflow |= __builtin_mul_overflow(a[i], factor, &out[i]);
+  return overflow;
+}
+
+static void scale_doubles(const double* a, double factor, double* out, size_t n) {
+  size_t i = 0;
+#ifdef BK_X86_64_KERNELS
+  if ((i = vectorized_length(n)) != 0) scale_doubles_avx2(a, factor, out, i);
+#endif
+  for (; i < n; ++i) out[i] = a[i] * factor;
+}
+
+/*
+*
+* Unboxed numbers
+*
+*/
+
+/// @brief The elements of a list of numbers, either all integers or all doubles.
+/// They're read directly from an unboxed list, or converted into one of the buffers.
+struct numbers_t {
+  bool are_doubles = false;
+  const int64_t* integers = nullptr;
+  const double* doubles = nullptr;
+  size_t size = 0;
+  vector<int64_t> integer_buffer;
+  vector<double> double_buffer;
+
+  numbers_t() = default;
+  numbers_t(const numbers_t&) = delete; // the pointers may point to the buffers
+};
+
+/// @brief Reads the elements of a list as numbers.
+/// @return `false` if one of the elements isn't a number (a string, a big integer, etc.).
+static bool read_numbers(const ListValue& list, numbers_t& numbers) {
+  numbers.size = list.size();
+  switch (list.get_kind()) {
+    case ListKind::INTEGERS:
+      numbers.integers = list.get_integers().data();
+      return true;
+    case ListKind::DOUBLES:
+      numbers.are_doubles = true;
+      numbers.doubles = list.get_doubles().data();
+      return true;
+    case ListKind::BOOLEANS:
+      numbers.integer_buffer.assign(list.get_booleans().begin(), list.get_booleans().end());
+      numbers.integers = numbers.integer_buffer.data();
+      return true;
+    case ListKind::VALUES:
+      break;
+  }
+  const list_of_values_view elements = list.get_elements();
+  for (const auto& element : elements) {
+    const Type type = element->get_type();
+    if (type == DOUBLE) numbers.are_doubles = true;
+    else if (type != INT && type != BOOLEAN) return false;
+  }
+  if (numbers.are_doubles) {
+    numbers.double_buffer.reserve(elements.size());
+    for (const auto& element : elements) {
+      numbers.double_buffer.push_back(element->get_type() == DOUBLE ? static_cast<const DoubleValue&>(*element).get_actual_value() : static_cast<double>(element->get_type() == INT ? static_cast<const IntegerValue&>(*element).get_actual_value() : element->is_truthy()));
+    }
+    numbers.doubles = numbers.double_buffer.data();
+  } else {
+    numbers.integer_buffer.reserve(elements.size());
+    for (const auto& element : elements) {
+      numbers.integer_buffer.push_back(element->get_type() == INT ? static_cast<const IntegerValue&>(*element).get_actual_value() : element->is_truthy());
+    }
+    numbers.integers = numbers.integer_buffer.data();
+  }
+  return true;
+}
+
+/// @brief Converts integers into doubles, when they're combined with doubles.
+static void promote(numbers_t& numbers) {
+  if (numbers.are_doubles) return;
+  numbers.double_buffer.assign(numbers.integers, numbers.integers + numbers.size);
+  numbers.doubles = numbers.double_buffer.data();
+  numbers.are_doubles = true;
+}
+
+/// @brief Adds integers exactly, once their native sum has overflowed.
+static BigInteger exact_sum(const int64_t* a, size_t n) {
+  BigInteger total;
+  for (size_t i = 0; i < n; ++i) total = total + BigInteger(a[i]);
+  return total;
+}
+
+/*
+*
+* ListOperations
+*
+*/
+
+Value* ListOperations::sum(const ListValue& list) {
+  numbers_t numbers;
+  if (!read_numbers(list, numbers)) return nullptr;
+  if (numbers.are_doubles) return new DoubleValue(sum_doubles(numbers.doubles, numbers.size));
+  int64_t total;
+  if (sum_integers(numbers.integers, numbers.size, &total)) {
+    return BigIntValue::make(exact_sum(numbers.integers, numbers.size));
+  }
+  return new IntegerValue(total);
+}
+
+Value* ListOperations::min(const ListValue& list) {
+  numbers_t numbers;
+  if (!read_numbers(list, numbers) || numbers.size == 0) return nullptr;
+  if (numbers.are_doubles) return new DoubleValue(min_max(numbers.doubles, numbers.size, false));
+  return new IntegerValue(min_max(numbers.integers, numbers.size, false));
+}
+
+Value* ListOperations::max(const ListValue& list) {
+  numbers_t numbers;
+  if (!read_numbers(list, numbers) || numbers.size == 0) return nullptr;
+  if (numbers.are_doubles) return new DoubleValue(min_max(numbers.doubles, numbers.size, true));
+  return new IntegerValue(min_max(numbers.integers, numbers.size, true));
+}
+
+Value* ListOperations::mean(const ListValue& list) {
+  numbers_t numbers;
+  if (!read_numbers(list, numbers) || numbers.size == 0) return nullptr;
+  const double size = static_cast<double>(numbers.size);
+  if (numbers.are_doubles) return new DoubleValue(sum_doubles(numbers.doubles, numbers.size) / size);
+  int64_t total;
+  if (sum_integers(numbers.integers, numbers.size, &total)) {
+    return new DoubleValue(exact_sum(numbers.integers, numbers.size).to_double() / size);
+  }
+  return new DoubleValue(static_cast<double>(total) / size);
+}
+
+Value* ListOperations::dot(const ListValue& a, const ListValue& b) {
+  numbers_t x, y;
+  if (a.size() != b.size() || !read_numbers(a, x) || !read_numbers(b, y)) return nullptr;
+  if (x.are_doubles || y.are_doubles) {
+    promote(x);
+    promote(y);
+    return new DoubleValue(dot_doubles(x.doubles, y.doubles, x.size));
+  }
+  bool overflow = false;
+  int64_t total = 0;
+  for (size_t i = 0; i < x.size; ++i) {
+    int64_t product;
+    overflow |= __builtin_mul_overflow(x.integers[i], y.integers[i], &product);
+    overflow |= __builtin_add_overflow(total, product, &total);
+  }
+  if (overflow) {
+    BigInteger exact;
+    for (size_t i = 0; i < x.size; ++i) exact = exact + BigInteger(x.integers[i]) * BigInteger(y.integers[i]);
+    return BigIntValue::make(move(exact));
+  }
+  return new IntegerValue(total);
+}
+
+ListValue* ListOperations::add(const ListValue& a, const ListValue& b) {
+  numbers_t x, y;
+  if (a.size() != b.size() || !read_numbers(a, x) || !read_numbers(b, y)) return nullptr;
+  if (x.are_doubles || y.are_doubles) {
+    promote(x);
+    promote(y);
+    vector<double> result(x.size);
+    add_doubles(x.doubles, y.doubles, result.data(), x.size);
+    return ListValue::from_doubles(move(result));
+  }
+  vector<int64_t> result(x.size);
+  if (add_integers(x.integers, y.integers, result.data(), x.size)) return nullptr;
+  return ListValue::from_integers(move(result));
+}
+
+ListValue* ListOperations::multiply(const ListValue& list, const Value& factor) {
+  numbers_t x;
+  if ((factor.get_type() != INT && factor.get_type() != DOUBLE) || !read_numbers(list, x)) return nullptr;
+  if (x.are_doubles || factor.get_type() == DOUBLE) {
+    promote(x);
+    const double f = factor.get_type() == DOUBLE ? static_cast<const DoubleValue&>(factor).get_actual_value() : static_cast<double>(static_cast<const IntegerValue&>(factor).get_actual_value());
+    vector<double> result(x.size);
+    scale_doubles(x.doubles, f, result.data(), x.size);
+    return ListValue::from_doubles(move(result));
+  }
+  vector<int64_t> result(x.size);
+  if (scale_integers(x.integers, static_cast<const IntegerValue&>(factor).get_actual_value(), result.data(), x.size)) return nullptr;
+  return ListValue::from_integers(move(result));
+}
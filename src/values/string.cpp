@@ -1,30 +1,126 @@
 #include "../../include/values/string.hpp"
 #include "../../include/values/integer.hpp"
+#include "../../include/values/bigint.hpp"
+#include <algorithm>
+#include <vector>
+#include <utility>
+#include <shared_mutex>
 using namespace std;
 
-StringValue::StringValue(const string& v): Value(STRING) {
-  actual_value = any(v);
+/*
+*
+* Storage
+*
+*/
+
+/// @brief Guards the children of the ropes.
+/// They're read under a shared lock while the characters of a rope are gathered,
+/// and a rope only detaches its children under an exclusive lock,
+/// so that another thread never goes through children that are being released.
+static shared_mutex children_mutex;
+
+string_storage_t::string_storage_t(string characters): length(characters.length()), rope(false), characters(move(characters)) {}
+
+string_storage_t::string_storage_t(string_storage_t* left, string_storage_t* right):
+  left(left), right(right), length(left->length + right->length), rope(true) {}
+
+/// @brief Gives back the references of a rope to its children.
+/// A long chain of concatenations would overflow the stack if it was released recursively,
+/// so the storages that aren't referenced anymore are detached from their children before being deleted.
+static void release_children(string_storage_t* left, string_storage_t* right) {
+  vector<string_storage_t*> pending = { left, right };
+  while (!pending.empty()) {
+    string_storage_t* storage = pending.back();
+    pending.pop_back();
+    if (storage->references.fetch_sub(1, memory_order_acq_rel) == 1) {
+      if (storage->left != nullptr) {
+        pending.push_back(storage->left);
+        pending.push_back(storage->right);
+        storage->left = nullptr;
+        storage->right = nullptr;
+      }
+      delete storage;
+    }
+  }
+}
+
+string_storage_t::~string_storage_t() {
+  // a flat string, or a rope whose characters were gathered, has no children anymore
+  if (left != nullptr) release_children(left, right);
+}
+
+void string_storage_t::flatten() const {
+  // The leaves are appended from left to right, without any recursion.
+  // The ropes below this one aren't flattened, only the leaves (and the ropes already gathered) are read.
+  characters.reserve(length);
+  {
+    const shared_lock lock(children_mutex);
+    vector<const string_storage_t*> pending = { right, left };
+    while (!pending.empty()) {
+      const string_storage_t* storage = pending.back();
+      pending.pop_back();
+      if (storage->left != nullptr) {
+        pending.push_back(storage->right);
+        pending.push_back(storage->left);
+      } else {
+        characters += storage->characters;
+      }
+    }
+  }
+  // The children would keep a second copy of the characters alive
+  string_storage_t* detached_left;
+  string_storage_t* detached_right;
+  {
+    const unique_lock lock(children_mutex);
+    detached_left = exchange(left, nullptr);
+    detached_right = exchange(right, nullptr);
+  }
+  release_children(detached_left, detached_right);
+}
+
+/*
+*
+* StringValue
+*
+*/
+
+StringValue::StringValue(string v): Value(STRING) {
+  if (v.length() <= INLINE_CAPACITY) {
+    copy_n(v.data(), v.length(), payload.characters);
+    inline_length = static_cast<uint8_t>(v.length());
+  } else {
+    payload.heap = new string_storage_t(move(v));
+  }
 }
 
 StringValue::StringValue(): Value(STRING) {
-  actual_value = get_default_value();
+  inline_length = 0;
+}
+
+StringValue::StringValue(string_storage_t* storage): Value(STRING) {
+  payload.heap = storage;
+}
+
+string_storage_t* StringValue::share_storage() const {
+  if (inline_length != NOT_INLINE) {
+    return new string_storage_t(string(get_actual_value()));
+  }
+  payload.heap->references.fetch_add(1, memory_order_relaxed);
+  return const_cast<string_storage_t*>(&get_storage());
 }
 
 string StringValue::get_default_value() { return ""; }
-string StringValue::get_actual_value() const { return any_cast<string>(actual_value); }
 bool StringValue::is_truthy() const { return !get_actual_value().empty(); }
-string StringValue::to_string() const { return get_actual_value(); }
+string StringValue::to_string() const { return string(get_actual_value()); }
 StringValue* StringValue::copy() const { return new StringValue(*this); }
 
 unique_ptr<Value> StringValue::cast(const Type output_type) const {
   unique_ptr<Value> cast_value = nullptr;
   switch (output_type) {
-    case INT: cast_value = make_unique<IntegerValue>(get_actual_value().length()); break;
+    case INT: cast_value = make_unique<IntegerValue>(length()); break;
     default:
       return nullptr;
   }
-  cast_value->set_pos(pos_start, pos_end);
-  cast_value->set_ctx(context);
   return cast_value;
 } 
 
@@ -34,16 +130,52 @@ unique_ptr<Value> StringValue::cast(const Type output_type) const {
 *
 */
 
+StringValue* StringValue::concatenate(const StringValue& left, const StringValue& right) {
+  const size_t length = left.length() + right.length();
+  if (length < ROPE_THRESHOLD) {
+    string concatenation;
+    concatenation.reserve(length);
+    concatenation.append(left.get_actual_value());
+    concatenation.append(right.get_actual_value());
+    return new StringValue(move(concatenation));
+  }
+  return new StringValue(new string_storage_t(left.share_storage(), right.share_storage()));
+}
+
+StringValue* StringValue::concatenate(const vector<const Value*>& parts) {
+  // The values that aren't strings are converted first, so that the length of the result is known
+  vector<string> representations(parts.size());
+  size_t length = 0;
+  for (size_t i = 0; i < parts.size(); ++i) {
+    const Value* part = parts[i];
+    if (part->get_type() == STRING) {
+      length += static_cast<const StringValue*>(part)->length();
+    } else {
+      representations[i] = part->get_type() == BOOLEAN ? (part->is_truthy() ? "1" : "0") : part->to_string();
+      length += representations[i].length();
+    }
+  }
+  string concatenation;
+  concatenation.reserve(length);
+  for (size_t i = 0; i < parts.size(); ++i) {
+    if (parts[i]->get_type() == STRING) {
+      concatenation.append(static_cast<const StringValue*>(parts[i])->get_actual_value());
+    } else {
+      concatenation.append(representations[i]);
+    }
+  }
+  return new StringValue(move(concatenation));
+}
+
 StringValue* StringValue::operator+(const Value& other) const {
-  return new StringValue{
-    get_actual_value() + other.to_string()
-  };
+  if (other.get_type() == STRING) {
+    return concatenate(*this, static_cast<const StringValue&>(other));
+  }
+  return concatenate(*this, StringValue(other.to_string()));
 }
 
 StringValue* StringValue::make_concatenation_rtl(const Value* left, const StringValue* right) {
-  return new StringValue(
-    left->to_string() + right->get_actual_value()
-  );
+  return concatenate(StringValue(left->to_string()), *right);
 }
 
 /*
@@ -53,21 +185,31 @@ StringValue* StringValue::make_concatenation_rtl(const Value* left, const String
 */
 
 StringValue* StringValue::operator*(const IntegerValue& other) const {
-  if (other.get_actual_value() < 0) return nullptr; // a RuntimeError will get thrown for invalid operation
-  if (other.get_actual_value() == 0)  return new StringValue(); // empty string
-  if (get_actual_value().length() == 1) {
-    return new StringValue(
-      string(other.get_actual_value(), get_actual_value().front())
-    );
-  } else {
-    string new_str;
-    new_str.reserve(static_cast<unsigned int>(get_actual_value().length() * other.get_actual_value()));
-    for (int i = 0; i < other.get_actual_value(); i++) {
-      new_str.append(get_actual_value());
-    }
-    new_str.shrink_to_fit();
-    return new StringValue(
-      new_str
-    );
+  const int64_t times = other.get_actual_value();
+  if (times < 0) return nullptr; // a RuntimeError will get thrown for invalid operation
+  const string_view pattern = get_actual_value();
+  if (times == 0 || pattern.empty()) return new StringValue(); // empty string
+  // the overflow is checked before allocating anything (a TypeOverflowError will get thrown)
+  if (static_cast<uint64_t>(times) > MAX_LENGTH / pattern.length()) return nullptr;
+  const size_t length = pattern.length() * static_cast<size_t>(times);
+  if (pattern.length() == 1) {
+    return new StringValue(string(length, pattern.front()));
+  }
+  string repetition;
+  repetition.reserve(length);
+  repetition.append(pattern);
+  // The capacity is already there, so appending the prefix to itself never reallocates it
+  while (repetition.length() <= length - repetition.length()) {
+    repetition.append(repetition.data(), repetition.length());
   }
+  repetition.append(repetition.data(), length - repetition.length());
+  return new StringValue(move(repetition));
+}
+
+StringValue* StringValue::operator*(const BigIntValue& other) const {
+  const BigInteger& times = other.get_actual_value();
+  if (times.fits_in_int64()) return *this * IntegerValue(times.to_int64());
+  if (times.is_negative()) return nullptr; // a RuntimeError will get thrown for invalid operation
+  // a TypeOverflowError will get thrown
+  return get_actual_value().empty() ? new StringValue() : nullptr;
 }
@@ -1,19 +1,22 @@
 #include "../../include/values/value.hpp"
 using namespace std;
 
-const any* Value::get_model() const { return &actual_value; }
-
 Value::Value(
   const Type& t
-): type(t), pos_start(Position::getDefaultPos()), pos_end(Position::getDefaultPos()) {}
+): type(t), payload{} {}
+
+Value::Value(
+  const Value& other
+): type(other.type), inline_length(other.inline_length), payload(other.payload) {
+  if (has_heap_storage()) {
+    payload.heap->references.fetch_add(1, memory_order_relaxed);
+  }
+}
 
-void Value::set_pos(const Position& start, const Position& end) {
-  pos_start = start;
-  pos_end = end;
+Value::~Value() {
+  if (has_heap_storage() && payload.heap->references.fetch_sub(1, memory_order_acq_rel) == 1) {
+    delete payload.heap;
+  }
 }
 
-void Value::set_ctx(const shared_ptr<Context>& ctx) { context = ctx; }
-shared_ptr<Context> Value::get_ctx() { return context; }
 Type Value::get_type() const { return type; }
-const Position* Value::get_pos_start() const { return &pos_start; }
-const Position* Value::get_pos_end() const { return &pos_end; }
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include <new>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include "../../include/values/value_pool.hpp"
+using namespace std;
+
+/// @brief A freed block, which holds the address of the next freed block of the same size class.
+struct free_block_t {
+  free_block_t* next;
+};
+
+struct slab_t;
+
+/// @brief What a thread shares with the other threads about its pool.
+/// It's allocated on the heap, so that it outlives the thread as long as some of its values are alive.
+struct pool_owner_t {
+  /// @brief The blocks freed by the other threads, for each size class.
+  std::atomic<free_block_t*> remote_free_lists[ValuePool::NUMBER_OF_SIZE_CLASSES]{};
+
+  /// @brief Minus the number of blocks freed by the other threads.
+  /// When the thread ends, the number of its live values is added,
+  /// so that the thread freeing the last value knows it's the last one.
+  std::atomic<std::ptrdiff_t> balance{0};
+
+  slab_t* slabs = nullptr;
+};
+
+/// @brief The header at the beginning of each slab.
+/// The slabs are aligned on their size, so the header of a block is found by masking its address.
+struct alignas(16) slab_t {
+  slab_t* next;
+  pool_owner_t* owner;
+};
+
+/// @brief The blocks of a specific size.
+struct size_class_t {
+  free_block_t* free_list;
+  char* cursor; // the next block that was never allocated in the current slab
+  char* end;
+};
+
+// Trivially destructible, so that a value destroyed after the end of a thread
+// (a static value for example) can still be given back to the pool.
+struct pool_state_t {
+  size_class_t classes[ValuePool::NUMBER_OF_SIZE_CLASSES];
+  pool_owner_t* owner; // `nullptr` until the first slab
+  pool_stats_t stats; // `live_objects` only counts the values freed by this thread
+};
+
+static constinit thread_local pool_state_t pool{};
+
+/// @brief Releases the slabs of an owner, and the owner itself.
+static void release(pool_owner_t* owner) {
+  while (owner->slabs != nullptr) {
+    slab_t* next = owner->slabs->next;
+    free(owner->slabs);
+    owner->slabs = next;
+  }
+  delete owner;
+}
+
+/// @brief Hands the slabs of the thread over when it ends.
+/// They're released now if none of its values are still alive,
+/// otherwise by the thread that will destroy the last of them.
+struct slabs_owner_t {
+  void use() {}
+  ~slabs_owner_t() {
+    pool_owner_t* owner = pool.owner;
+    if (owner == nullptr) return;
+    const ptrdiff_t live_objects = pool.stats.live_objects;
+    // The values destroyed later by this thread are given back like the ones of another thread
+    pool = pool_state_t{};
+    if (owner->balance.fetch_add(live_objects, memory_order_acq_rel) + live_objects == 0) {
+      release(owner);
+    }
+  }
+};
+
+static thread_local slabs_owner_t slabs_owner;
+
+/// @brief Gets the index of the size class of a value.
+static constexpr size_t size_class_of(size_t size) {
+  return (size + ValuePool::GRANULARITY - 1) / ValuePool::GRANULARITY - 1;
+}
+
+/// @brief Allocates a new slab for the given size class.
+static void add_slab(size_class_t& size_class) {
+  slabs_owner.use(); // makes sure the owner is constructed, so that it's destroyed at the end of the thread
+  if (pool.owner == nullptr) pool.owner = new pool_owner_t();
+  slab_t* slab = static_cast<slab_t*>(aligned_alloc(ValuePool::SLAB_SIZE, ValuePool::SLAB_SIZE));
+  if (slab == nullptr) throw bad_alloc();
+  slab->next = pool.owner->slabs;
+  slab->owner = pool.owner;
+  pool.owner->slabs = slab;
+  ++pool.stats.slabs;
+  size_class.cursor = reinterpret_cast<char*>(slab + 1);
+  size_class.end = reinterpret_cast<char*>(slab) + ValuePool::SLAB_SIZE;
+}
+
+void* ValuePool::allocate(size_t size) {
+#ifdef BK_NO_VALUE_POOL
+  return ::operator new(size);
+#else
+  if (size == 0 || size > MAX_SIZE) return ::operator new(size);
+  const size_t index = size_class_of(size);
+  size_class_t& size_class = pool.classes[index];
+  if (size_class.free_list == nullptr && pool.owner != nullptr) {
+    // Takes back the blocks freed by the other threads, all at once
+    size_class.free_list = pool.owner->remote_free_lists[index].exchange(nullptr, memory_order_acquire);
+  }
+  if (size_class.free_list != nullptr) {
+    free_block_t* block = size_class.free_list;
+    size_class.free_list = block->next;
+    ++pool.stats.live_objects;
+    ++pool.stats.hits;
+    return block;
+  }
+  const size_t block_size = (index + 1) * GRANULARITY;
+  if (size_class.cursor == nullptr || size_class.cursor + block_size > size_class.end) {
+    add_slab(size_class);
+  }
+  void* block = size_class.cursor;
+  size_class.cursor += block_size;
+  ++pool.stats.live_objects;
+  ++pool.stats.misses;
+  return block;
+#endif
+}
+
+void ValuePool::deallocate(void* ptr, size_t size) noexcept {
+  if (ptr == nullptr) return;
+#ifdef BK_NO_VALUE_POOL
+  ::operator delete(ptr);
+#else
+  if (size == 0 || size > MAX_SIZE) {
+    ::operator delete(ptr);
+    return;
+  }
+  const size_t index = size_class_of(size);
+  free_block_t* block = static_cast<free_block_t*>(ptr);
+  pool_owner_t* owner = reinterpret_cast<const slab_t*>(reinterpret_cast<uintptr_t>(ptr) & ~(uintptr_t(SLAB_SIZE) - 1))->owner;
+  if (owner == pool.owner) {
+    size_class_t& size_class = pool.classes[index];
+    block->next = size_class.free_list;
+    size_class.free_list = block;
+    --pool.stats.live_objects;
+    return;
+  }
+  // The block belongs to another thread (or to this thread before its end)
+  atomic<free_block_t*>& remote_free_list = owner->remote_free_lists[index];
+  block->next = remote_free_list.load(memory_order_relaxed);
+  while (!remote_free_list.compare_exchange_weak(block->next, block, memory_order_release, memory_order_relaxed)) {}
+  // After the end of the owner, the balance is the number of its live values
+  if (owner->balance.fetch_sub(1, memory_order_acq_rel) == 1) {
+    release(owner);
+  }
+#endif
+}
+
+pool_stats_t ValuePool::get_stats() {
+  pool_stats_t stats = pool.stats;
+  if (pool.owner != nullptr) stats.live_objects += pool.owner->balance.load(memory_order_relaxed);
+  return stats;
+}
@@ -0,0 +1,91 @@
+#include <algorithm>
+#include "../../include/vm/bytecode.hpp"
+#include "../../include/builtins.hpp"
+using namespace std;
+
+string get_opcode_name(OpCode::Type op) {
+  switch (op) {
+    case OpCode::PUSH_CONST: return "PUSH_CONST";
+    case OpCode::LOAD: return "LOAD";
+    case OpCode::CHECK_DECLARE: return "CHECK_DECLARE";
+    case OpCode::DECLARE: return "DECLARE";
+    case OpCode::CHECK_DEFINE: return "CHECK_DEFINE";
+    case OpCode::DEFINE: return "DEFINE";
+    case OpCode::CHECK_STORE: return "CHECK_STORE";
+    case OpCode::STORE: return "STORE";
+    case OpCode::ADD: return "ADD";
+    case OpCode::SUBSTRACT: return "SUBSTRACT";
+    case OpCode::MULTIPLY: return "MULTIPLY";
+    case OpCode::DIVIDE: return "DIVIDE";
+    case OpCode::MODULO: return "MODULO";
+    case OpCode::POWER: return "POWER";
+    case OpCode::CONCAT: return "CONCAT";
+    case OpCode::JOIN: return "JOIN";
+    case OpCode::CALL: return "CALL";
+    case OpCode::INDEX: return "INDEX";
+    case OpCode::SLICE: return "SLICE";
+    case OpCode::STORE_ELEMENT: return "STORE_ELEMENT";
+    case OpCode::NEGATE: return "NEGATE";
+    case OpCode::POSITIVE: return "POSITIVE";
+    case OpCode::NOT: return "NOT";
+    case OpCode::AND_JUMP: return "AND_JUMP";
+    case OpCode::OR_JUMP: return "OR_JUMP";
+    case OpCode::TO_BOOLEAN: return "TO_BOOLEAN";
+    case OpCode::COPY: return "COPY";
+    case OpCode::MAKE_LIST: return "MAKE_LIST";
+    case OpCode::MAKE_DICT: return "MAKE_DICT";
+    case OpCode::LITERAL_OVERFLOW: return "LITERAL_OVERFLOW";
+    case OpCode::HALT: return "HALT";
+  }
+  return "UNKNOWN";
+}
+
+unsigned int Chunk::emit(OpCode::Type op, unsigned int arg, const Position& pos_start, const Position& pos_end) {
+  code.push_back(instruction_t{op, arg});
+  spans.push_back(span_t{pos_start, pos_end});
+  return code.size() - 1;
+}
+
+unsigned int BaseChunk::add_constant(shared_ptr<const Value> value) {
+  constants.push_back(move(value));
+  return constants.size() - 1;
+}
+
+unsigned int BaseChunk::resolve_name(const string& name) {
+  const auto it = find(names.begin(), names.end(), name);
+  if (it != names.end()) {
+    return it - names.begin();
+  }
+  names.push_back(name);
+  return names.size() - 1;
+}
+
+unsigned int BaseChunk::add_declaration(const declaration_t& declaration) {
+  declarations.push_back(declaration);
+  return declarations.size() - 1;
+}
+
+string Chunk::disassemble() const {
+  string output;
+  for (unsigned int i = 0; i < code.size(); ++i) {
+    output += std::to_string(i) + " " + get_opcode_name(code[i].op) + " " + std::to_string(code[i].arg);
+    switch (code[i].op) {
+      case OpCode::PUSH_CONST: output += " (" + constants[code[i].arg]->to_string() + ")"; break;
+      case OpCode::LOAD:
+      case OpCode::CHECK_STORE:
+      case OpCode::STORE:
+      case OpCode::STORE_ELEMENT:
+        output += " (" + names[code[i].arg] + ")"; break;
+      case OpCode::CHECK_DECLARE:
+      case OpCode::DECLARE:
+      case OpCode::CHECK_DEFINE:
+      case OpCode::DEFINE:
+        output += " (" + names[declarations[code[i].arg].name] + ")"; break;
+      case OpCode::CALL: output += " (" + get_builtin_name(static_cast<Builtin::Type>(code[i].arg)) + ")"; break;
+      default:
+        break;
+    }
+    output += "\n";
+  }
+  return output;
+}
@@ -0,0 +1,250 @@
+#include "../../include/vm/bytecode_compiler.hpp"
+#include "../../include/values/compositer.hpp"
+#include "../../include/miscellaneous.hpp"
+#include "../../include/exceptions/undefined_behavior.hpp"
+using namespace std;
+
+Chunk BytecodeCompiler::compile(unique_ptr<ListNode>&& tree) {
+  BytecodeCompiler compiler;
+  const Position pos_start = tree->getStartingPosition();
+  const Position pos_end = tree->getEndingPosition();
+  compiler.emit(move(tree));
+  compiler.chunk.emit(OpCode::HALT, 0, pos_start, pos_end);
+  return move(compiler.chunk);
+}
+
+void BytecodeCompiler::emit(unique_ptr<CustomNode>&& node) {
+  switch (node->getNodeType()) {
+    case NodeType::LIST: return emit_ListNode(cast_node<ListNode>(move(node)));
+    case NodeType::DICT: return emit_DictNode(cast_node<DictNode>(move(node)));
+    case NodeType::INTEGER: return emit_IntegerNode(cast_node<IntegerNode>(move(node)));
+    case NodeType::DOUBLE: return emit_DoubleNode(cast_node<DoubleNode>(move(node)));
+    case NodeType::NEGATIVE: return emit_MinusNode(cast_node<MinusNode>(move(node)));
+    case NodeType::POSITIVE: return emit_PlusNode(cast_node<PlusNode>(move(node)));
+    case NodeType::NOT: return emit_NotNode(cast_node<NotNode>(move(node)));
+    case NodeType::AND: return emit_AndNode(cast_node<AndNode>(move(node)));
+    case NodeType::OR: return emit_OrNode(cast_node<OrNode>(move(node)));
+    case NodeType::STRING: return emit_StringNode(cast_node<StringNode>(move(node)));
+    case NodeType::VAR_ASSIGNMENT: return emit_VarAssignmentNode(cast_node<VarAssignmentNode>(move(node)));
+    case NodeType::DEFINE_CONSTANT: return emit_DefineConstantNode(cast_node<DefineConstantNode>(move(node)));
+    case NodeType::VAR_ACCESS: return emit_VarAccessNode(cast_node<VarAccessNode>(move(node)));
+    case NodeType::VAR_MODIFY: return emit_VarModifyNode(cast_node<VarModifyNode>(move(node)));
+    case NodeType::BOOLEAN: return emit_BooleanNode(cast_node<BooleanNode>(move(node)));
+    case NodeType::ADD:
+    case NodeType::SUBSTRACT:
+    case NodeType::MULTIPLY:
+    case NodeType::DIVIDE:
+    case NodeType::MODULO:
+    case NodeType::POWER:
+      return emit_BinaryOperationNode(cast_node<BinaryOperationNode>(move(node)));
+    case NodeType::CONCAT: return emit_ConcatNode(cast_node<ConcatNode>(move(node)));
+    case NodeType::CALL: return emit_CallNode(cast_node<CallNode>(move(node)));
+    case NodeType::LIST_ACCESS: return emit_ListAccessNode(cast_node<ListAccessNode>(move(node)));
+    case NodeType::LIST_SLICE: return emit_ListSliceNode(cast_node<ListSliceNode>(move(node)));
+    case NodeType::LIST_ASSIGNMENT: return emit_ListAssignmentNode(cast_node<ListAssignmentNode>(move(node)));
+    default:
+      throw UndefinedBehaviorException("Unimplemented bytecode for input node '" + node->to_string() + "'");
+  }
+}
+
+void BytecodeCompiler::emit_ListNode(unique_ptr<ListNode>&& node) {
+  const unsigned int number_of_elements = node->get_number_of_nodes();
+  if (number_of_elements > 0) {
+    const auto nodes = node->get_element_nodes();
+    for (auto& element_node : *nodes) {
+      emit(move(element_node));
+    }
+  }
+  chunk.emit(OpCode::MAKE_LIST, number_of_elements, node->getStartingPosition(), node->getEndingPosition());
+}
+
+void BytecodeCompiler::emit_DictNode(unique_ptr<DictNode>&& node) {
+  const unsigned int number_of_entries = node->get_number_of_entries();
+  const auto entries = node->retrieve_entries();
+  for (auto& entry_node : *entries) {
+    emit(move(entry_node));
+  }
+  chunk.emit(OpCode::MAKE_DICT, number_of_entries, node->getStartingPosition(), node->getEndingPosition());
+}
+
+// The literals are turned into values once and for all,
+// during the compilation, instead of being parsed every time they're executed.
+// However, if a literal cannot be stored,
+// the error must still be thrown at runtime,
+// after the instructions that precede it.
+
+void BytecodeCompiler::emit_IntegerNode(unique_ptr<const IntegerNode>&& node) {
+  try {
+    shared_ptr<Value> value = make_shared<IntegerValue>(stoll(node->get_token().getStringValue()));
+    chunk.emit(OpCode::PUSH_CONST, chunk.add_constant(move(value)), node->getStartingPosition(), node->getEndingPosition());
+  } catch (std::out_of_range&) {
+    // the integers that don't fit in 64 bits are big integers
+    shared_ptr<Value> value = make_shared<BigIntValue>(BigInteger::from_string(node->get_token().getStringValue()));
+    chunk.emit(OpCode::PUSH_CONST, chunk.add_constant(move(value)), node->getStartingPosition(), node->getEndingPosition());
+  }
+}
+
+void BytecodeCompiler::emit_DoubleNode(unique_ptr<const DoubleNode>&& node) {
+  try {
+    shared_ptr<Value> value = make_shared<DoubleValue>(stod(node->get_token().getStringValue()));
+    chunk.emit(OpCode::PUSH_CONST, chunk.add_constant(move(value)), node->getStartingPosition(), node->getEndingPosition());
+  } catch (std::out_of_range&) {
+    chunk.emit(OpCode::LITERAL_OVERFLOW, Type::DOUBLE, node->getStartingPosition(), node->getEndingPosition());
+  }
+}
+
+void BytecodeCompiler::emit_StringNode(unique_ptr<const StringNode>&& node) {
+  shared_ptr<Value> value = make_shared<StringValue>(node->getValue());
+  chunk.emit(OpCode::PUSH_CONST, chunk.add_constant(move(value)), node->getStartingPosition(), node->getEndingPosition());
+}
+
+void BytecodeCompiler::emit_BooleanNode(unique_ptr<const BooleanNode>&& node) {
+  shared_ptr<Value> value = make_shared<BooleanValue>(node->is_true());
+  chunk.emit(OpCode::PUSH_CONST, chunk.add_constant(move(value)), node->getStartingPosition(), node->getEndingPosition());
+}
+
+void BytecodeCompiler::emit_MinusNode(unique_ptr<MinusNode>&& node) {
+  emit(node->retrieve_node());
+  chunk.emit(OpCode::NEGATE, 0, node->getStartingPosition(), node->getEndingPosition());
+}
+
+void BytecodeCompiler::emit_PlusNode(unique_ptr<PlusNode>&& node) {
+  emit(node->retrieve_node());
+  chunk.emit(OpCode::POSITIVE, 0, node->getStartingPosition(), node->getEndingPosition());
+}
+
+void BytecodeCompiler::emit_NotNode(unique_ptr<NotNode>&& node) {
+  emit(node->retrieve_node());
+  chunk.emit(OpCode::NOT, 0, node->getStartingPosition(), node->getEndingPosition());
+}
+
+// The right operand of "and" & "or" must not be executed
+// if the left operand is enough to know the result.
+// The jump is emitted before the right operand,
+// and its target is patched once the right operand has been emitted.
+
+void BytecodeCompiler::emit_AndNode(unique_ptr<AndNode>&& node) {
+  emit(node->retrieve_a());
+  const unsigned int jump = chunk.emit(OpCode::AND_JUMP, 0, node->getStartingPosition(), node->getEndingPosition());
+  emit(node->retrieve_b());
+  chunk.emit(OpCode::TO_BOOLEAN, 0, node->getStartingPosition(), node->getEndingPosition());
+  chunk.code[jump].arg = chunk.code.size();
+}
+
+void BytecodeCompiler::emit_OrNode(unique_ptr<OrNode>&& node) {
+  emit(node->retrieve_a());
+  const unsigned int jump = chunk.emit(OpCode::OR_JUMP, 0, node->getStartingPosition(), node->getEndingPosition());
+  emit(node->retrieve_b());
+  chunk.emit(OpCode::COPY, 0, node->getStartingPosition(), node->getEndingPosition());
+  chunk.code[jump].arg = chunk.code.size();
+}
+
+void BytecodeCompiler::emit_VarAssignmentNode(unique_ptr<VarAssignmentNode>&& node) {
+  const bool has_initial_value = node->has_value(); // because "retrieve_value_node()" will change the result of this method
+  const unsigned int declaration = chunk.add_declaration(declaration_t{
+    chunk.resolve_name(node->get_var_name()),
+    get_type_from_name(node->get_type_name()),
+    has_initial_value
+  });
+  chunk.emit(OpCode::CHECK_DECLARE, declaration, node->getStartingPosition(), node->getEndingPosition());
+  if (!has_initial_value) {
+    chunk.emit(OpCode::DECLARE, declaration, node->getStartingPosition(), node->getEndingPosition());
+    return;
+  }
+  unique_ptr<CustomNode> value_node = node->retrieve_value_node();
+  const span_t value_span{value_node->getStartingPosition(), value_node->getEndingPosition()};
+  emit(move(value_node));
+  const unsigned int instruction = chunk.emit(OpCode::DECLARE, declaration, node->getStartingPosition(), node->getEndingPosition());
+  chunk.value_spans.emplace(instruction, value_span);
+}
+
+void BytecodeCompiler::emit_DefineConstantNode(unique_ptr<DefineConstantNode>&& node) {
+  const unsigned int declaration = chunk.add_declaration(declaration_t{
+    chunk.resolve_name(node->get_var_name()),
+    node->get_type(),
+    true
+  });
+  chunk.emit(OpCode::CHECK_DEFINE, declaration, node->getStartingPosition(), node->getEndingPosition());
+  unique_ptr<CustomNode> value_node = node->retrieve_value_node();
+  const span_t value_span{value_node->getStartingPosition(), value_node->getEndingPosition()};
+  emit(move(value_node));
+  const unsigned int instruction = chunk.emit(OpCode::DEFINE, declaration, node->getStartingPosition(), node->getEndingPosition());
+  chunk.value_spans.emplace(instruction, value_span);
+}
+
+void BytecodeCompiler::emit_VarAccessNode(unique_ptr<VarAccessNode>&& node) {
+  chunk.emit(OpCode::LOAD, chunk.resolve_name(node->get_var_name()), node->getStartingPosition(), node->getEndingPosition());
+}
+
+void BytecodeCompiler::emit_VarModifyNode(unique_ptr<VarModifyNode>&& node) {
+  const unsigned int name = chunk.resolve_name(node->get_var_name());
+  chunk.emit(OpCode::CHECK_STORE, name, node->getStartingPosition(), node->getEndingPosition());
+  unique_ptr<CustomNode> value_node = node->retrieve_value_node();
+  const span_t value_span{value_node->getStartingPosition(), value_node->getEndingPosition()};
+  emit(move(value_node));
+  const unsigned int instruction = chunk.emit(OpCode::STORE, name, node->getStartingPosition(), node->getEndingPosition());
+  chunk.value_spans.emplace(instruction, value_span);
+}
+
+void BytecodeCompiler::emit_BinaryOperationNode(unique_ptr<BinaryOperationNode>&& node) {
+  unique_ptr<CustomNode> a = node->retrieve_a();
+
+  // If the left operand is a string literal,
+  // then the addition is necessarily a concatenation,
+  // so there is no need to look for the right permutation at runtime.
+  const bool is_concatenation = node->getNodeType() == NodeType::ADD && a->getNodeType() == NodeType::STRING;
+
+  emit(move(a));
+  emit(node->retrieve_b());
+
+  OpCode::Type op;
+  switch (node->getNodeType()) {
+    case NodeType::ADD: op = is_concatenation ? OpCode::CONCAT : OpCode::ADD; break;
+    case NodeType::SUBSTRACT: op = OpCode::SUBSTRACT; break;
+    case NodeType::MULTIPLY: op = OpCode::MULTIPLY; break;
+    case NodeType::DIVIDE: op = OpCode::DIVIDE; break;
+    case NodeType::MODULO: op = OpCode::MODULO; break;
+    default: op = OpCode::POWER; break;
+  }
+
+  chunk.emit(op, 0, node->getStartingPosition(), node->getEndingPosition());
+}
+
+
+void BytecodeCompiler::emit_ConcatNode(unique_ptr<ConcatNode>&& node) {
+  const auto parts = node->retrieve_parts();
+  const unsigned int number_of_parts = parts->size();
+  for (auto& part : *parts) {
+    emit(move(part));
+  }
+  chunk.emit(OpCode::JOIN, number_of_parts, node->getStartingPosition(), node->getEndingPosition());
+}
+
+void BytecodeCompiler::emit_CallNode(unique_ptr<CallNode>&& node) {
+  const auto args = node->retrieve_args();
+  for (auto& arg : *args) {
+    emit(move(arg));
+  }
+  chunk.emit(OpCode::CALL, node->get_builtin(), node->getStartingPosition(), node->getEndingPosition());
+}
+
+void BytecodeCompiler::emit_ListAccessNode(unique_ptr<ListAccessNode>&& node) {
+  emit(node->retrieve_list());
+  emit(node->retrieve_index());
+  chunk.emit(OpCode::INDEX, 0, node->getStartingPosition(), node->getEndingPosition());
+}
+
+void BytecodeCompiler::emit_ListSliceNode(unique_ptr<ListSliceNode>&& node) {
+  emit(node->retrieve_list());
+  emit(node->retrieve_start());
+  emit(node->retrieve_end());
+  chunk.emit(OpCode::SLICE, 0, node->getStartingPosition(), node->getEndingPosition());
+}
+
+void BytecodeCompiler::emit_ListAssignmentNode(unique_ptr<ListAssignmentNode>&& node) {
+  const unsigned int name = chunk.resolve_name(node->get_var_name());
+  chunk.emit(OpCode::CHECK_STORE, name, node->getStartingPosition(), node->getEndingPosition());
+  emit(node->retrieve_index_node());
+  emit(node->retrieve_value_node());
+  chunk.emit(OpCode::STORE_ELEMENT, name, node->getStartingPosition(), node->getEndingPosition());
+}
\ No newline at end of file
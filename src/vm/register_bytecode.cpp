@@ -0,0 +1,108 @@
+#include "../../include/vm/register_bytecode.hpp"
+#include "../../include/builtins.hpp"
+using namespace std;
+
+string get_opcode_name(RegOpCode::Type op) {
+  switch (op) {
+    case RegOpCode::MOVE: return "MOVE";
+    case RegOpCode::LOAD: return "LOAD";
+    case RegOpCode::CHECK_DECLARE: return "CHECK_DECLARE";
+    case RegOpCode::DECLARE: return "DECLARE";
+    case RegOpCode::CHECK_DEFINE: return "CHECK_DEFINE";
+    case RegOpCode::DEFINE: return "DEFINE";
+    case RegOpCode::CHECK_STORE: return "CHECK_STORE";
+    case RegOpCode::STORE: return "STORE";
+    case RegOpCode::ADD: return "ADD";
+    case RegOpCode::SUBSTRACT: return "SUBSTRACT";
+    case RegOpCode::MULTIPLY: return "MULTIPLY";
+    case RegOpCode::DIVIDE: return "DIVIDE";
+    case RegOpCode::MODULO: return "MODULO";
+    case RegOpCode::POWER: return "POWER";
+    case RegOpCode::CONCAT: return "CONCAT";
+    case RegOpCode::JOIN: return "JOIN";
+    case RegOpCode::CALL: return "CALL";
+    case RegOpCode::INDEX: return "INDEX";
+    case RegOpCode::SLICE: return "SLICE";
+    case RegOpCode::STORE_ELEMENT: return "STORE_ELEMENT";
+    case RegOpCode::NEGATE: return "NEGATE";
+    case RegOpCode::POSITIVE: return "POSITIVE";
+    case RegOpCode::NOT: return "NOT";
+    case RegOpCode::AND_JUMP: return "AND_JUMP";
+    case RegOpCode::OR_JUMP: return "OR_JUMP";
+    case RegOpCode::TO_BOOLEAN: return "TO_BOOLEAN";
+    case RegOpCode::COPY: return "COPY";
+    case RegOpCode::MAKE_LIST: return "MAKE_LIST";
+    case RegOpCode::MAKE_DICT: return "MAKE_DICT";
+    case RegOpCode::LITERAL_OVERFLOW: return "LITERAL_OVERFLOW";
+    case RegOpCode::HALT: return "HALT";
+  }
+  return "UNKNOWN";
+}
+
+unsigned int RegisterChunk::emit(RegOpCode::Type op, unsigned int a, unsigned int b, unsigned int c, const Position& pos_start, const Position& pos_end) {
+  code.push_back(three_address_t{op, a, b, c});
+  spans.push_back(span_t{pos_start, pos_end});
+  return code.size() - 1;
+}
+
+// Writes a source operand, which can be either a register or a constant.
+static string rk_to_string(const RegisterChunk& chunk, unsigned int operand) {
+  if (operand & RK_CONSTANT) {
+    const unsigned int k = operand & ~RK_CONSTANT;
+    return "k" + std::to_string(k) + "(" + chunk.constants[k]->to_string() + ")";
+  }
+  return "r" + std::to_string(operand);
+}
+
+string RegisterChunk::disassemble() const {
+  string output;
+  for (unsigned int i = 0; i < code.size(); ++i) {
+    const three_address_t& instruction = code[i];
+    output += std::to_string(i) + " " + get_opcode_name(instruction.op);
+    switch (instruction.op) {
+      case RegOpCode::LOAD:
+      case RegOpCode::CHECK_STORE:
+        output += " r" + std::to_string(instruction.a) + " " + names[instruction.b]; break;
+      case RegOpCode::STORE:
+        output += " r" + std::to_string(instruction.a) + " " + names[instruction.b] + " " + rk_to_string(*this, instruction.c); break;
+      case RegOpCode::CHECK_DECLARE:
+      case RegOpCode::CHECK_DEFINE:
+        output += " " + names[declarations[instruction.b].name]; break;
+      case RegOpCode::DECLARE:
+      case RegOpCode::DEFINE:
+        output += " r" + std::to_string(instruction.a) + " " + names[declarations[instruction.b].name];
+        if (declarations[instruction.b].has_value) output += " " + rk_to_string(*this, instruction.c);
+        break;
+      case RegOpCode::AND_JUMP:
+      case RegOpCode::OR_JUMP:
+        output += " r" + std::to_string(instruction.a) + " " + std::to_string(instruction.b); break;
+      case RegOpCode::MAKE_LIST:
+      case RegOpCode::MAKE_DICT:
+      case RegOpCode::JOIN:
+        output += " r" + std::to_string(instruction.a) + " r" + std::to_string(instruction.b) + " " + std::to_string(instruction.c); break;
+      case RegOpCode::CALL:
+        output += " r" + std::to_string(instruction.a) + " r" + std::to_string(instruction.b) + " " + get_builtin_name(static_cast<Builtin::Type>(instruction.c)); break;
+      case RegOpCode::INDEX:
+        output += " r" + std::to_string(instruction.a) + " " + rk_to_string(*this, instruction.b) + " " + rk_to_string(*this, instruction.c); break;
+      case RegOpCode::SLICE:
+        output += " r" + std::to_string(instruction.a) + " r" + std::to_string(instruction.b); break;
+      case RegOpCode::STORE_ELEMENT:
+        output += " r" + std::to_string(instruction.a) + " " + names[instruction.b] + " r" + std::to_string(instruction.c); break;
+      case RegOpCode::LITERAL_OVERFLOW:
+        break;
+      case RegOpCode::HALT:
+        output += " r" + std::to_string(instruction.a); break;
+      case RegOpCode::MOVE:
+      case RegOpCode::NEGATE:
+      case RegOpCode::POSITIVE:
+      case RegOpCode::NOT:
+      case RegOpCode::TO_BOOLEAN:
+      case RegOpCode::COPY:
+        output += " r" + std::to_string(instruction.a) + " " + rk_to_string(*this, instruction.b); break;
+      default:
+        output += " r" + std::to_string(instruction.a) + " " + rk_to_string(*this, instruction.b) + " " + rk_to_string(*this, instruction.c); break;
+    }
+    output += "\n";
+  }
+  return output;
+}
@@ -0,0 +1,313 @@
+#include "../../include/vm/register_compiler.hpp"
+#include "../../include/values/compositer.hpp"
+#include "../../include/miscellaneous.hpp"
+#include "../../include/exceptions/undefined_behavior.hpp"
+using namespace std;
+
+RegisterChunk RegisterCompiler::compile(unique_ptr<ListNode>&& tree) {
+  RegisterCompiler compiler;
+  const Position pos_start = tree->getStartingPosition();
+  const Position pos_end = tree->getEndingPosition();
+  const unsigned int result = compiler.allocate_register();
+  compiler.emit_into(move(tree), result);
+  compiler.chunk.emit(RegOpCode::HALT, result, 0, 0, pos_start, pos_end);
+  return move(compiler.chunk);
+}
+
+unsigned int RegisterCompiler::allocate_register() {
+  const unsigned int reg = free_register++;
+  if (free_register > chunk.number_of_registers) {
+    chunk.number_of_registers = free_register;
+  }
+  return reg;
+}
+
+optional<unsigned int> RegisterCompiler::make_constant(const CustomNode& node) {
+  shared_ptr<Value> value = nullptr;
+  try {
+    switch (node.getNodeType()) {
+      case NodeType::INTEGER: value = make_shared<IntegerValue>(stoll(static_cast<const IntegerNode&>(node).get_token().getStringValue())); break;
+      case NodeType::DOUBLE: value = make_shared<DoubleValue>(stod(static_cast<const DoubleNode&>(node).get_token().getStringValue())); break;
+      case NodeType::STRING: value = make_shared<StringValue>(static_cast<const StringNode&>(node).getValue()); break;
+      default: value = make_shared<BooleanValue>(static_cast<const BooleanNode&>(node).is_true()); break;
+    }
+  } catch (std::out_of_range&) {
+    if (node.getNodeType() != NodeType::INTEGER) return nullopt;
+    value = make_shared<BigIntValue>(BigInteger::from_string(static_cast<const IntegerNode&>(node).get_token().getStringValue()));
+  }
+  return chunk.add_constant(move(value)) | RK_CONSTANT;
+}
+
+unsigned int RegisterCompiler::emit_operand(unique_ptr<CustomNode>&& node) {
+  switch (node->getNodeType()) {
+    case NodeType::INTEGER:
+    case NodeType::DOUBLE:
+    case NodeType::STRING:
+    case NodeType::BOOLEAN: {
+      const optional<unsigned int> constant = make_constant(*node);
+      if (constant.has_value()) {
+        return constant.value();
+      }
+      break; // the error is emitted by `emit_into`
+    }
+    default:
+      break;
+  }
+  const unsigned int reg = allocate_register();
+  emit_into(move(node), reg);
+  return reg;
+}
+
+void RegisterCompiler::emit_into(unique_ptr<CustomNode>&& node, unsigned int target) {
+  const Position pos_start = node->getStartingPosition();
+  const Position pos_end = node->getEndingPosition();
+  switch (node->getNodeType()) {
+    case NodeType::LIST: return emit_ListNode(cast_node<ListNode>(move(node)), target);
+    case NodeType::DICT: return emit_DictNode(cast_node<DictNode>(move(node)), target);
+    case NodeType::CONCAT: return emit_ConcatNode(cast_node<ConcatNode>(move(node)), target);
+    case NodeType::CALL: return emit_CallNode(cast_node<CallNode>(move(node)), target);
+    case NodeType::LIST_ACCESS: return emit_ListAccessNode(cast_node<ListAccessNode>(move(node)), target);
+    case NodeType::LIST_SLICE: return emit_ListSliceNode(cast_node<ListSliceNode>(move(node)), target);
+    case NodeType::LIST_ASSIGNMENT: return emit_ListAssignmentNode(cast_node<ListAssignmentNode>(move(node)), target);
+    case NodeType::INTEGER:
+    case NodeType::DOUBLE:
+    case NodeType::STRING:
+    case NodeType::BOOLEAN: {
+      // The literals are turned into values once and for all, during the compilation.
+      // However, if a literal cannot be stored,
+      // the error must still be thrown at runtime,
+      // after the instructions that precede it.
+      const optional<unsigned int> constant = make_constant(*node);
+      if (constant.has_value()) {
+        chunk.emit(RegOpCode::MOVE, target, constant.value(), 0, pos_start, pos_end);
+      } else {
+        chunk.emit(RegOpCode::LITERAL_OVERFLOW, target, node->getNodeType() == NodeType::INTEGER ? Type::INT : Type::DOUBLE, 0, pos_start, pos_end);
+      }
+      return;
+    }
+    case NodeType::NEGATIVE: return emit_UnaryNode(RegOpCode::NEGATE, cast_node<MinusNode>(move(node))->retrieve_node(), pos_start, pos_end, target);
+    case NodeType::POSITIVE: return emit_UnaryNode(RegOpCode::POSITIVE, cast_node<PlusNode>(move(node))->retrieve_node(), pos_start, pos_end, target);
+    case NodeType::NOT: return emit_UnaryNode(RegOpCode::NOT, cast_node<NotNode>(move(node))->retrieve_node(), pos_start, pos_end, target);
+    case NodeType::AND: return emit_AndNode(cast_node<AndNode>(move(node)), target);
+    case NodeType::OR: return emit_OrNode(cast_node<OrNode>(move(node)), target);
+    case NodeType::VAR_ASSIGNMENT: return emit_VarAssignmentNode(cast_node<VarAssignmentNode>(move(node)), target);
+    case NodeType::DEFINE_CONSTANT: return emit_DefineConstantNode(cast_node<DefineConstantNode>(move(node)), target);
+    case NodeType::VAR_ACCESS:
+      chunk.emit(RegOpCode::LOAD, target, chunk.resolve_name(cast_node<VarAccessNode>(move(node))->get_var_name()), 0, pos_start, pos_end);
+      return;
+    case NodeType::VAR_MODIFY: return emit_VarModifyNode(cast_node<VarModifyNode>(move(node)), target);
+    case NodeType::ADD:
+    case NodeType::SUBSTRACT:
+    case NodeType::MULTIPLY:
+    case NodeType::DIVIDE:
+    case NodeType::MODULO:
+    case NodeType::POWER:
+      return emit_BinaryOperationNode(cast_node<BinaryOperationNode>(move(node)), target);
+    default:
+      throw UndefinedBehaviorException("Unimplemented bytecode for input node '" + node->to_string() + "'");
+  }
+}
+
+void RegisterCompiler::emit_ListNode(unique_ptr<ListNode>&& node, unsigned int target) {
+  // The elements must be in consecutive registers
+  const unsigned int number_of_elements = node->get_number_of_nodes();
+  const unsigned int first = free_register;
+  for (unsigned int i = 0; i < number_of_elements; ++i) {
+    allocate_register();
+  }
+  if (number_of_elements > 0) {
+    const auto nodes = node->get_element_nodes();
+    unsigned int i = 0;
+    for (auto& element_node : *nodes) {
+      emit_into(move(element_node), first + i++);
+    }
+  }
+  free_register = first;
+  chunk.emit(RegOpCode::MAKE_LIST, target, first, number_of_elements, node->getStartingPosition(), node->getEndingPosition());
+}
+
+void RegisterCompiler::emit_ConcatNode(unique_ptr<ConcatNode>&& node, unsigned int target) {
+  // The parts must be in consecutive registers, just like the elements of a list
+  const auto parts = node->retrieve_parts();
+  const unsigned int number_of_parts = parts->size();
+  const unsigned int first = free_register;
+  for (unsigned int i = 0; i < number_of_parts; ++i) {
+    allocate_register();
+  }
+  unsigned int i = 0;
+  for (auto& part : *parts) {
+    emit_into(move(part), first + i++);
+  }
+  free_register = first;
+  chunk.emit(RegOpCode::JOIN, target, first, number_of_parts, node->getStartingPosition(), node->getEndingPosition());
+}
+
+void RegisterCompiler::emit_DictNode(unique_ptr<DictNode>&& node, unsigned int target) {
+  // The keys and the values must be in consecutive registers, just like the elements of a list
+  const unsigned int number_of_entries = node->get_number_of_entries();
+  const unsigned int first = free_register;
+  for (unsigned int i = 0; i < 2 * number_of_entries; ++i) {
+    allocate_register();
+  }
+  const auto entries = node->retrieve_entries();
+  unsigned int i = 0;
+  for (auto& entry_node : *entries) {
+    emit_into(move(entry_node), first + i++);
+  }
+  free_register = first;
+  chunk.emit(RegOpCode::MAKE_DICT, target, first, number_of_entries, node->getStartingPosition(), node->getEndingPosition());
+}
+
+void RegisterCompiler::emit_CallNode(unique_ptr<CallNode>&& node, unsigned int target) {
+  // The arguments must be in consecutive registers, just like the elements of a list
+  const auto args = node->retrieve_args();
+  const unsigned int number_of_args = args->size();
+  const unsigned int first = free_register;
+  for (unsigned int i = 0; i < number_of_args; ++i) {
+    allocate_register();
+  }
+  unsigned int i = 0;
+  for (auto& arg : *args) {
+    emit_into(move(arg), first + i++);
+  }
+  free_register = first;
+  chunk.emit(RegOpCode::CALL, target, first, node->get_builtin(), node->getStartingPosition(), node->getEndingPosition());
+}
+
+void RegisterCompiler::emit_ListAccessNode(unique_ptr<ListAccessNode>&& node, unsigned int target) {
+  const unsigned int saved = free_register;
+  const unsigned int b = emit_operand(node->retrieve_list());
+  const unsigned int c = emit_operand(node->retrieve_index());
+  free_register = saved;
+  chunk.emit(RegOpCode::INDEX, target, b, c, node->getStartingPosition(), node->getEndingPosition());
+}
+
+void RegisterCompiler::emit_ListSliceNode(unique_ptr<ListSliceNode>&& node, unsigned int target) {
+  // The list and its bounds must be in consecutive registers
+  const unsigned int first = allocate_register();
+  allocate_register();
+  allocate_register();
+  emit_into(node->retrieve_list(), first);
+  emit_into(node->retrieve_start(), first + 1);
+  emit_into(node->retrieve_end(), first + 2);
+  free_register = first;
+  chunk.emit(RegOpCode::SLICE, target, first, 0, node->getStartingPosition(), node->getEndingPosition());
+}
+
+void RegisterCompiler::emit_ListAssignmentNode(unique_ptr<ListAssignmentNode>&& node, unsigned int target) {
+  const unsigned int name = chunk.resolve_name(node->get_var_name());
+  chunk.emit(RegOpCode::CHECK_STORE, 0, name, 0, node->getStartingPosition(), node->getEndingPosition());
+  // The index and the new element must be in consecutive registers
+  const unsigned int first = allocate_register();
+  allocate_register();
+  emit_into(node->retrieve_index_node(), first);
+  emit_into(node->retrieve_value_node(), first + 1);
+  free_register = first;
+  chunk.emit(RegOpCode::STORE_ELEMENT, target, name, first, node->getStartingPosition(), node->getEndingPosition());
+}
+
+void RegisterCompiler::emit_UnaryNode(RegOpCode::Type op, unique_ptr<CustomNode>&& operand, const Position& pos_start, const Position& pos_end, unsigned int target) {
+  const unsigned int saved = free_register;
+  const unsigned int b = emit_operand(move(operand));
+  free_register = saved;
+  chunk.emit(op, target, b, 0, pos_start, pos_end);
+}
+
+// The right operand of "and" & "or" must not be executed
+// if the left operand is enough to know the result.
+// The left operand is computed directly in the target register,
+// and the target of the jump is patched once the right operand has been emitted.
+
+void RegisterCompiler::emit_AndNode(unique_ptr<AndNode>&& node, unsigned int target) {
+  emit_into(node->retrieve_a(), target);
+  const unsigned int jump = chunk.emit(RegOpCode::AND_JUMP, target, 0, 0, node->getStartingPosition(), node->getEndingPosition());
+  const unsigned int saved = free_register;
+  const unsigned int b = emit_operand(node->retrieve_b());
+  free_register = saved;
+  chunk.emit(RegOpCode::TO_BOOLEAN, target, b, 0, node->getStartingPosition(), node->getEndingPosition());
+  chunk.code[jump].b = chunk.code.size();
+}
+
+void RegisterCompiler::emit_OrNode(unique_ptr<OrNode>&& node, unsigned int target) {
+  emit_into(node->retrieve_a(), target);
+  const unsigned int jump = chunk.emit(RegOpCode::OR_JUMP, target, 0, 0, node->getStartingPosition(), node->getEndingPosition());
+  const unsigned int saved = free_register;
+  const unsigned int b = emit_operand(node->retrieve_b());
+  free_register = saved;
+  chunk.emit(RegOpCode::COPY, target, b, 0, node->getStartingPosition(), node->getEndingPosition());
+  chunk.code[jump].b = chunk.code.size();
+}
+
+void RegisterCompiler::emit_VarAssignmentNode(unique_ptr<VarAssignmentNode>&& node, unsigned int target) {
+  const bool has_initial_value = node->has_value(); // because "retrieve_value_node()" will change the result of this method
+  const unsigned int declaration = chunk.add_declaration(declaration_t{
+    chunk.resolve_name(node->get_var_name()),
+    get_type_from_name(node->get_type_name()),
+    has_initial_value
+  });
+  chunk.emit(RegOpCode::CHECK_DECLARE, 0, declaration, 0, node->getStartingPosition(), node->getEndingPosition());
+  if (!has_initial_value) {
+    chunk.emit(RegOpCode::DECLARE, target, declaration, 0, node->getStartingPosition(), node->getEndingPosition());
+    return;
+  }
+  unique_ptr<CustomNode> value_node = node->retrieve_value_node();
+  const span_t value_span{value_node->getStartingPosition(), value_node->getEndingPosition()};
+  const unsigned int saved = free_register;
+  const unsigned int c = emit_operand(move(value_node));
+  free_register = saved;
+  const unsigned int instruction = chunk.emit(RegOpCode::DECLARE, target, declaration, c, node->getStartingPosition(), node->getEndingPosition());
+  chunk.value_spans.emplace(instruction, value_span);
+}
+
+void RegisterCompiler::emit_DefineConstantNode(unique_ptr<DefineConstantNode>&& node, unsigned int target) {
+  const unsigned int declaration = chunk.add_declaration(declaration_t{
+    chunk.resolve_name(node->get_var_name()),
+    node->get_type(),
+    true
+  });
+  chunk.emit(RegOpCode::CHECK_DEFINE, 0, declaration, 0, node->getStartingPosition(), node->getEndingPosition());
+  unique_ptr<CustomNode> value_node = node->retrieve_value_node();
+  const span_t value_span{value_node->getStartingPosition(), value_node->getEndingPosition()};
+  const unsigned int saved = free_register;
+  const unsigned int c = emit_operand(move(value_node));
+  free_register = saved;
+  const unsigned int instruction = chunk.emit(RegOpCode::DEFINE, target, declaration, c, node->getStartingPosition(), node->getEndingPosition());
+  chunk.value_spans.emplace(instruction, value_span);
+}
+
+void RegisterCompiler::emit_VarModifyNode(unique_ptr<VarModifyNode>&& node, unsigned int target) {
+  const unsigned int name = chunk.resolve_name(node->get_var_name());
+  chunk.emit(RegOpCode::CHECK_STORE, 0, name, 0, node->getStartingPosition(), node->getEndingPosition());
+  unique_ptr<CustomNode> value_node = node->retrieve_value_node();
+  const span_t value_span{value_node->getStartingPosition(), value_node->getEndingPosition()};
+  const unsigned int saved = free_register;
+  const unsigned int c = emit_operand(move(value_node));
+  free_register = saved;
+  const unsigned int instruction = chunk.emit(RegOpCode::STORE, target, name, c, node->getStartingPosition(), node->getEndingPosition());
+  chunk.value_spans.emplace(instruction, value_span);
+}
+
+void RegisterCompiler::emit_BinaryOperationNode(unique_ptr<BinaryOperationNode>&& node, unsigned int target) {
+  unique_ptr<CustomNode> a = node->retrieve_a();
+
+  // If the left operand is a string literal,
+  // then the addition is necessarily a concatenation.
+  const bool is_concatenation = node->getNodeType() == NodeType::ADD && a->getNodeType() == NodeType::STRING;
+
+  const unsigned int saved = free_register;
+  const unsigned int b = emit_operand(move(a));
+  const unsigned int c = emit_operand(node->retrieve_b());
+  free_register = saved;
+
+  RegOpCode::Type op;
+  switch (node->getNodeType()) {
+    case NodeType::ADD: op = is_concatenation ? RegOpCode::CONCAT : RegOpCode::ADD; break;
+    case NodeType::SUBSTRACT: op = RegOpCode::SUBSTRACT; break;
+    case NodeType::MULTIPLY: op = RegOpCode::MULTIPLY; break;
+    case NodeType::DIVIDE: op = RegOpCode::DIVIDE; break;
+    case NodeType::MODULO: op = RegOpCode::MODULO; break;
+    default: op = RegOpCode::POWER; break;
+  }
+
+  chunk.emit(op, target, b, c, node->getStartingPosition(), node->getEndingPosition());
+}
@@ -0,0 +1,270 @@
+#include "../../include/vm/register_vm.hpp"
+#include "../../include/interpreter.hpp"
+#include "../../include/values/compositer.hpp"
+#include "../../include/exceptions/type_overflow_error.hpp"
+using namespace std;
+
+RegisterVirtualMachine::RegisterVirtualMachine(const RegisterChunk& chunk, const shared_ptr<Context>& ctx, const inputs_t* inputs): chunk(chunk), ctx(ctx), inputs(inputs), registers(chunk.number_of_registers) {}
+
+RuntimeResult RegisterVirtualMachine::run(const RegisterChunk& chunk, const shared_ptr<Context>& ctx, const inputs_t* inputs) {
+  RegisterVirtualMachine vm(chunk, ctx, inputs);
+  const shared_ptr<const Value> result = vm.execute();
+  RuntimeResult res;
+  res.success(unique_ptr<Value>(result->copy()));
+  return res;
+}
+
+shared_ptr<const Value> RegisterVirtualMachine::take(unsigned int operand) {
+  if (operand & RK_CONSTANT) {
+    return chunk.constants[operand & ~RK_CONSTANT];
+  }
+  return move(registers[operand]);
+}
+
+/// @brief Concatenates a string with any value.
+/// @param left The string on the left.
+/// @param right The value on the right (a boolean is considered as an integer in a binary operation).
+/// @return The new string.
+static unique_ptr<Value> concatenate(const Value& left, const Value& right) {
+  const StringValue& str = static_cast<const StringValue&>(left);
+  if (right.get_type() == Type::BOOLEAN) {
+    return unique_ptr<Value>(str + *right.cast(Type::INT));
+  }
+  return unique_ptr<Value>(str + right);
+}
+
+/// @brief Concatenates the consecutive registers of a JOIN instruction into R(a).
+/// It's a function because the body of an instruction cannot declare a variable that needs to be destroyed.
+static void join(vector<shared_ptr<const Value>>& registers, const three_address_t& instruction) {
+  vector<const Value*> parts;
+  parts.reserve(instruction.c);
+  for (unsigned int i = 0; i < instruction.c; ++i) {
+    parts.push_back(registers[instruction.b + i].get());
+  }
+  registers[instruction.a] = shared_ptr<const Value>(StringValue::concatenate(parts));
+}
+
+/// @brief Calls the built-in function of a CALL instruction, with the consecutive registers as arguments, into R(a).
+static void call(vector<shared_ptr<const Value>>& registers, const three_address_t& instruction, const span_t& span, const shared_ptr<Context>& ctx) {
+  const Builtin::Type builtin = static_cast<Builtin::Type>(instruction.c);
+  vector<const Value*> args;
+  args.reserve(get_builtin_arity(builtin));
+  for (unsigned int i = 0; i < get_builtin_arity(builtin); ++i) {
+    args.push_back(registers[instruction.b + i].get());
+  }
+  registers[instruction.a] = Interpreter::interpret_call(builtin, args, span.start, span.end, ctx);
+}
+
+/// @brief Slices the list of a SLICE instruction into R(a), the list and its bounds being in consecutive registers.
+static void slice(vector<shared_ptr<const Value>>& registers, const three_address_t& instruction, const span_t& span, const shared_ptr<Context>& ctx) {
+  const unsigned int first = instruction.b;
+  registers[instruction.a] = Interpreter::interpret_list_slice(*registers[first], *registers[first + 1], *registers[first + 2], span.start, span.end, ctx);
+}
+
+/// @brief Modifies the element of a list stored in a variable, the index and the element being in consecutive registers.
+static void store_element(vector<shared_ptr<const Value>>& registers, const string& name, const three_address_t& instruction, const span_t& span, const shared_ptr<Context>& ctx) {
+  registers[instruction.a] = Interpreter::assign_list_element(name, *registers[instruction.c], *registers[instruction.c + 1], span.start, span.end, ctx);
+}
+
+/// @brief Creates the dictionary of a MAKE_DICT instruction into R(a), its keys and its values being in consecutive registers.
+static void make_dictionary(vector<shared_ptr<const Value>>& registers, const three_address_t& instruction, const span_t& span, const shared_ptr<Context>& ctx) {
+  vector<const Value*> keys_and_values;
+  keys_and_values.reserve(2 * instruction.c);
+  for (unsigned int i = 0; i < 2 * instruction.c; ++i) {
+    keys_and_values.push_back(registers[instruction.b + i].get());
+  }
+  registers[instruction.a] = Interpreter::make_dictionary(keys_and_values, span.start, span.end, ctx);
+}
+
+// The body of each instruction is written once,
+// and these macros turn it either into a label of the dispatch table (computed goto)
+// or into a case of the switch.
+// A computed goto doesn't call the destructors of the local variables it jumps out of,
+// so the body of an instruction must not declare a variable that needs to be destroyed
+// (the temporaries are fine, they're destroyed at the end of their statement).
+#ifdef BK_COMPUTED_GOTO
+#define VM_CASE(name) op_##name
+#define VM_DISPATCH() \
+  instruction = &code[ip]; \
+  span = &spans[ip]; \
+  ++ip; \
+  goto *dispatch_table[instruction->op]
+#else
+#define VM_CASE(name) case RegOpCode::name
+#define VM_DISPATCH() goto dispatch
+#endif
+
+// The binary operations that don't have a dedicated fast path
+#define VM_BINARY_OPERATION(name) \
+  VM_CASE(name): { \
+    registers[instruction->a] = Interpreter::interpret_binary_operation(NodeType::name, *take(instruction->b), *take(instruction->c), span->start, span->end, ctx); \
+    VM_DISPATCH(); \
+  }
+
+shared_ptr<const Value> RegisterVirtualMachine::execute() {
+  const three_address_t* code = chunk.code.data();
+  const span_t* spans = chunk.spans.data();
+  const three_address_t* instruction = nullptr;
+  const span_t* span = nullptr;
+  unsigned int ip = 0;
+
+#ifdef BK_COMPUTED_GOTO
+  // Must follow the exact order of the RegOpCode enum
+  static const void* dispatch_table[] = {
+    &&op_MOVE, &&op_LOAD,
+    &&op_CHECK_DECLARE, &&op_DECLARE, &&op_CHECK_DEFINE, &&op_DEFINE, &&op_CHECK_STORE, &&op_STORE,
+    &&op_ADD, &&op_SUBSTRACT, &&op_MULTIPLY, &&op_DIVIDE, &&op_MODULO, &&op_POWER, &&op_CONCAT, &&op_JOIN, &&op_CALL,
+    &&op_INDEX, &&op_SLICE, &&op_STORE_ELEMENT,
+    &&op_NEGATE, &&op_POSITIVE, &&op_NOT,
+    &&op_AND_JUMP, &&op_OR_JUMP, &&op_TO_BOOLEAN, &&op_COPY,
+    &&op_MAKE_LIST, &&op_MAKE_DICT, &&op_LITERAL_OVERFLOW, &&op_HALT
+  };
+  static_assert(sizeof(dispatch_table) / sizeof(dispatch_table[0]) == RegOpCode::HALT + 1, "The dispatch table doesn't match RegOpCode");
+  VM_DISPATCH();
+#else
+dispatch:
+  instruction = &code[ip];
+  span = &spans[ip];
+  ++ip;
+  switch (instruction->op) {
+#endif
+
+  VM_CASE(MOVE): {
+    registers[instruction->a] = read(instruction->b);
+    VM_DISPATCH();
+  }
+  VM_CASE(LOAD): {
+    if (inputs != nullptr && (*inputs)[instruction->b] != nullptr) {
+      registers[instruction->a] = (*inputs)[instruction->b];
+    } else {
+      registers[instruction->a] = Interpreter::access_variable(chunk.names[instruction->b], span->start, span->end, ctx);
+    }
+    VM_DISPATCH();
+  }
+  VM_CASE(CHECK_DECLARE): {
+    const declaration_t& declaration = chunk.declarations[instruction->b];
+    Interpreter::check_variable_declaration(chunk.names[declaration.name], declaration.type, span->start, span->end, ctx);
+    VM_DISPATCH();
+  }
+  VM_CASE(DECLARE): {
+    const declaration_t& declaration = chunk.declarations[instruction->b];
+    if (!declaration.has_value) {
+      registers[instruction->a] = Interpreter::declare_variable(chunk.names[declaration.name], declaration.type, nullptr, span->start, span->end, span->start, span->end, ctx);
+      VM_DISPATCH();
+    }
+    const span_t& value_span = chunk.value_spans.at(ip - 1);
+    registers[instruction->a] = Interpreter::declare_variable(chunk.names[declaration.name], declaration.type, take(instruction->c).get(), span->start, span->end, value_span.start, value_span.end, ctx);
+    VM_DISPATCH();
+  }
+  VM_CASE(CHECK_DEFINE): {
+    const declaration_t& declaration = chunk.declarations[instruction->b];
+    Interpreter::check_constant_definition(chunk.names[declaration.name], span->start, span->end, ctx);
+    VM_DISPATCH();
+  }
+  VM_CASE(DEFINE): {
+    const declaration_t& declaration = chunk.declarations[instruction->b];
+    const span_t& value_span = chunk.value_spans.at(ip - 1);
+    registers[instruction->a] = Interpreter::define_constant(chunk.names[declaration.name], declaration.type, *take(instruction->c), value_span.start, value_span.end, ctx);
+    VM_DISPATCH();
+  }
+  VM_CASE(CHECK_STORE): {
+    Interpreter::check_variable_modification(chunk.names[instruction->b], span->start, span->end, ctx);
+    VM_DISPATCH();
+  }
+  VM_CASE(STORE): {
+    const span_t& value_span = chunk.value_spans.at(ip - 1);
+    registers[instruction->a] = Interpreter::modify_variable(chunk.names[instruction->b], *take(instruction->c), value_span.start, value_span.end, ctx);
+    VM_DISPATCH();
+  }
+  VM_BINARY_OPERATION(ADD)
+  VM_BINARY_OPERATION(SUBSTRACT)
+  VM_BINARY_OPERATION(MULTIPLY)
+  VM_BINARY_OPERATION(DIVIDE)
+  VM_BINARY_OPERATION(MODULO)
+  VM_BINARY_OPERATION(POWER)
+  VM_CASE(CONCAT): {
+    registers[instruction->a] = concatenate(*take(instruction->b), *take(instruction->c));
+    VM_DISPATCH();
+  }
+  VM_CASE(JOIN): {
+    join(registers, *instruction);
+    VM_DISPATCH();
+  }
+  VM_CASE(CALL): {
+    call(registers, *instruction, *span, ctx);
+    VM_DISPATCH();
+  }
+  VM_CASE(INDEX): {
+    registers[instruction->a] = Interpreter::interpret_list_access(*take(instruction->b), *take(instruction->c), span->start, span->end, ctx);
+    VM_DISPATCH();
+  }
+  VM_CASE(SLICE): {
+    slice(registers, *instruction, *span, ctx);
+    VM_DISPATCH();
+  }
+  VM_CASE(STORE_ELEMENT): {
+    store_element(registers, chunk.names[instruction->b], *instruction, *span, ctx);
+    VM_DISPATCH();
+  }
+  VM_CASE(NEGATE): {
+    registers[instruction->a] = Interpreter::interpret_negation(*take(instruction->b), span->start, span->end, ctx);
+    VM_DISPATCH();
+  }
+  VM_CASE(POSITIVE): {
+    registers[instruction->a] = Interpreter::interpret_positive(*take(instruction->b), span->start, span->end, ctx);
+    VM_DISPATCH();
+  }
+  VM_CASE(NOT): {
+    registers[instruction->a] = make_unique<BooleanValue>(!take(instruction->b)->is_truthy());
+    VM_DISPATCH();
+  }
+  VM_CASE(AND_JUMP): {
+    if (!registers[instruction->a]->is_truthy()) { // do not execute the right operand if the left one is false
+      registers[instruction->a] = make_unique<BooleanValue>(false);
+      ip = instruction->b;
+    }
+    VM_DISPATCH();
+  }
+  VM_CASE(OR_JUMP): {
+    if (registers[instruction->a]->is_truthy()) {
+      ip = instruction->b;
+    }
+    VM_DISPATCH();
+  }
+  VM_CASE(TO_BOOLEAN): {
+    registers[instruction->a] = make_unique<BooleanValue>(take(instruction->b)->is_truthy());
+    VM_DISPATCH();
+  }
+  VM_CASE(COPY): {
+    registers[instruction->a] = unique_ptr<Value>(take(instruction->b)->copy());
+    VM_DISPATCH();
+  }
+  VM_CASE(MAKE_LIST): {
+    const auto first = registers.begin() + instruction->b;
+    registers[instruction->a] = make_unique<ListValue>(list_of_values_ptr(make_move_iterator(first), make_move_iterator(first + instruction->c)));
+    VM_DISPATCH();
+  }
+  VM_CASE(MAKE_DICT): {
+    make_dictionary(registers, *instruction, *span, ctx);
+    VM_DISPATCH();
+  }
+  VM_CASE(LITERAL_OVERFLOW): {
+    throw TypeOverflowError(
+      span->start, span->end,
+      instruction->b == Type::INT ? "Cannot store such a big integer" : "Cannot store such a big double",
+      ctx
+    );
+  }
+  VM_CASE(HALT): {
+    return move(registers[instruction->a]);
+  }
+
+#ifndef BK_COMPUTED_GOTO
+  }
+  return nullptr; // never reached
+#endif
+}
+
+#undef VM_BINARY_OPERATION
+#undef VM_DISPATCH
+#undef VM_CASE
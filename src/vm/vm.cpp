@@ -0,0 +1,215 @@
+#include "../../include/vm/vm.hpp"
+#include "../../include/interpreter.hpp"
+#include "../../include/values/compositer.hpp"
+#include "../../include/exceptions/type_overflow_error.hpp"
+using namespace std;
+
+VirtualMachine::VirtualMachine(const Chunk& chunk, const shared_ptr<Context>& ctx): chunk(chunk), ctx(ctx) {
+  stack.reserve(64);
+}
+
+RuntimeResult VirtualMachine::run(const Chunk& chunk, const shared_ptr<Context>& ctx) {
+  VirtualMachine vm(chunk, ctx);
+  const shared_ptr<const Value> result = vm.execute();
+  RuntimeResult res;
+  res.success(unique_ptr<Value>(result->copy()));
+  return res;
+}
+
+shared_ptr<const Value> VirtualMachine::pop() {
+  shared_ptr<const Value> value = move(stack.back());
+  stack.pop_back();
+  return value;
+}
+
+shared_ptr<const Value> VirtualMachine::execute() {
+  const instruction_t* code = chunk.code.data();
+  unsigned int ip = 0;
+  while (true) {
+    const instruction_t& instruction = code[ip];
+    const span_t& span = chunk.spans[ip];
+    ++ip;
+    switch (instruction.op) {
+      case OpCode::PUSH_CONST:
+        stack.push_back(chunk.constants[instruction.arg]);
+        break;
+      case OpCode::LOAD:
+        stack.push_back(Interpreter::access_variable(chunk.names[instruction.arg], span.start, span.end, ctx));
+        break;
+      case OpCode::CHECK_DECLARE: {
+        const declaration_t& declaration = chunk.declarations[instruction.arg];
+        Interpreter::check_variable_declaration(chunk.names[declaration.name], declaration.type, span.start, span.end, ctx);
+        break;
+      }
+      case OpCode::DECLARE: {
+        const declaration_t& declaration = chunk.declarations[instruction.arg];
+        if (!declaration.has_value) {
+          stack.push_back(Interpreter::declare_variable(chunk.names[declaration.name], declaration.type, nullptr, span.start, span.end, span.start, span.end, ctx));
+          break;
+        }
+        const shared_ptr<const Value> initial_value = pop();
+        const span_t& value_span = chunk.value_spans.at(ip - 1);
+        stack.push_back(Interpreter::declare_variable(chunk.names[declaration.name], declaration.type, initial_value.get(), span.start, span.end, value_span.start, value_span.end, ctx));
+        break;
+      }
+      case OpCode::CHECK_DEFINE: {
+        const declaration_t& declaration = chunk.declarations[instruction.arg];
+        Interpreter::check_constant_definition(chunk.names[declaration.name], span.start, span.end, ctx);
+        break;
+      }
+      case OpCode::DEFINE: {
+        const declaration_t& declaration = chunk.declarations[instruction.arg];
+        const shared_ptr<const Value> value = pop();
+        const span_t& value_span = chunk.value_spans.at(ip - 1);
+        stack.push_back(Interpreter::define_constant(chunk.names[declaration.name], declaration.type, *value, value_span.start, value_span.end, ctx));
+        break;
+      }
+      case OpCode::CHECK_STORE:
+        Interpreter::check_variable_modification(chunk.names[instruction.arg], span.start, span.end, ctx);
+        break;
+      case OpCode::STORE: {
+        const shared_ptr<const Value> new_value = pop();
+        const span_t& value_span = chunk.value_spans.at(ip - 1);
+        stack.push_back(Interpreter::modify_variable(chunk.names[instruction.arg], *new_value, value_span.start, value_span.end, ctx));
+        break;
+      }
+      case OpCode::ADD:
+      case OpCode::SUBSTRACT:
+      case OpCode::MULTIPLY:
+      case OpCode::DIVIDE:
+      case OpCode::MODULO:
+      case OpCode::POWER: {
+        NodeType::Type op;
+        switch (instruction.op) {
+          case OpCode::ADD: op = NodeType::ADD; break;
+          case OpCode::SUBSTRACT: op = NodeType::SUBSTRACT; break;
+          case OpCode::MULTIPLY: op = NodeType::MULTIPLY; break;
+          case OpCode::DIVIDE: op = NodeType::DIVIDE; break;
+          case OpCode::MODULO: op = NodeType::MODULO; break;
+          default: op = NodeType::POWER; break;
+        }
+        const shared_ptr<const Value> right = pop();
+        const shared_ptr<const Value> left = pop();
+        stack.push_back(Interpreter::interpret_binary_operation(op, *left, *right, span.start, span.end, ctx));
+        break;
+      }
+      case OpCode::CONCAT: {
+        shared_ptr<const Value> right = pop();
+        const shared_ptr<const Value> left = pop();
+        // A boolean is considered as an integer in a binary operation.
+        if (right->get_type() == Type::BOOLEAN) right = right->cast(Type::INT);
+        unique_ptr<StringValue> concatenation = unique_ptr<StringValue>(*static_cast<const StringValue*>(left.get()) + *right);
+        stack.push_back(move(concatenation));
+        break;
+      }
+      case OpCode::JOIN: {
+        vector<const Value*> parts;
+        parts.reserve(instruction.arg);
+        for (auto part = stack.end() - instruction.arg; part != stack.end(); ++part) {
+          parts.push_back(part->get());
+        }
+        unique_ptr<StringValue> concatenation = unique_ptr<StringValue>(StringValue::concatenate(parts));
+        stack.resize(stack.size() - instruction.arg);
+        stack.push_back(move(concatenation));
+        break;
+      }
+      case OpCode::CALL: {
+        const Builtin::Type builtin = static_cast<Builtin::Type>(instruction.arg);
+        const unsigned int arity = get_builtin_arity(builtin);
+        vector<const Value*> args;
+        args.reserve(arity);
+        for (auto arg = stack.end() - arity; arg != stack.end(); ++arg) {
+          args.push_back(arg->get());
+        }
+        unique_ptr<Value> result = Interpreter::interpret_call(builtin, args, span.start, span.end, ctx);
+        stack.resize(stack.size() - arity);
+        stack.push_back(move(result));
+        break;
+      }
+      case OpCode::INDEX: {
+        const shared_ptr<const Value> index = pop();
+        const shared_ptr<const Value> list = pop();
+        stack.push_back(Interpreter::interpret_list_access(*list, *index, span.start, span.end, ctx));
+        break;
+      }
+      case OpCode::SLICE: {
+        const shared_ptr<const Value> end = pop();
+        const shared_ptr<const Value> start = pop();
+        const shared_ptr<const Value> list = pop();
+        stack.push_back(Interpreter::interpret_list_slice(*list, *start, *end, span.start, span.end, ctx));
+        break;
+      }
+      case OpCode::STORE_ELEMENT: {
+        const shared_ptr<const Value> element = pop();
+        const shared_ptr<const Value> index = pop();
+        stack.push_back(Interpreter::assign_list_element(chunk.names[instruction.arg], *index, *element, span.start, span.end, ctx));
+        break;
+      }
+      case OpCode::NEGATE:
+        stack.push_back(Interpreter::interpret_negation(*pop(), span.start, span.end, ctx));
+        break;
+      case OpCode::POSITIVE:
+        stack.push_back(Interpreter::interpret_positive(*pop(), span.start, span.end, ctx));
+        break;
+      case OpCode::NOT: {
+        unique_ptr<BooleanValue> value = make_unique<BooleanValue>(!pop()->is_truthy());
+        stack.push_back(move(value));
+        break;
+      }
+      case OpCode::AND_JUMP: {
+        if (!stack.back()->is_truthy()) { // do not execute the right operand if the left one is false
+          unique_ptr<BooleanValue> bool_false = make_unique<BooleanValue>(false);
+          stack.back() = move(bool_false);
+          ip = instruction.arg;
+        } else {
+          stack.pop_back();
+        }
+        break;
+      }
+      case OpCode::OR_JUMP: {
+        if (stack.back()->is_truthy()) {
+          ip = instruction.arg;
+        } else {
+          stack.pop_back();
+        }
+        break;
+      }
+      case OpCode::TO_BOOLEAN: {
+        unique_ptr<BooleanValue> answer = make_unique<BooleanValue>(stack.back()->is_truthy());
+        stack.back() = move(answer);
+        break;
+      }
+      case OpCode::COPY: {
+        unique_ptr<Value> right_copy = unique_ptr<Value>(stack.back()->copy());
+        stack.back() = move(right_copy);
+        break;
+      }
+      case OpCode::MAKE_DICT: {
+        vector<const Value*> keys_and_values;
+        keys_and_values.reserve(2 * instruction.arg);
+        for (auto value = stack.end() - 2 * instruction.arg; value != stack.end(); ++value) {
+          keys_and_values.push_back(value->get());
+        }
+        unique_ptr<Value> dictionary = Interpreter::make_dictionary(keys_and_values, span.start, span.end, ctx);
+        stack.resize(stack.size() - 2 * instruction.arg);
+        stack.push_back(move(dictionary));
+        break;
+      }
+      case OpCode::MAKE_LIST: {
+        list_of_values_ptr elements(make_move_iterator(stack.end() - instruction.arg), make_move_iterator(stack.end()));
+        stack.resize(stack.size() - instruction.arg);
+        unique_ptr<ListValue> list_value = make_unique<ListValue>(move(elements));
+        stack.push_back(move(list_value));
+        break;
+      }
+      case OpCode::LITERAL_OVERFLOW:
+        throw TypeOverflowError(
+          span.start, span.end,
+          instruction.arg == Type::INT ? "Cannot store such a big integer" : "Cannot store such a big double",
+          ctx
+        );
+      case OpCode::HALT:
+        return pop();
+    }
+  }
+}
@@ -84,6 +84,35 @@ DOCTEST_TEST_SUITE("Symbol Table") {
     CHECK(table->get("a") == nullptr);
   }
 
+  SCENARIO("many variables") {
+    unique_ptr<SymbolTable> table = make_unique<SymbolTable>();
+    for (int i = 0; i < 1000; ++i) {
+      table->set("v" + to_string(i), make_unique<IntegerValue>(i), i % 2 == 0);
+    }
+    for (int i = 0; i < 1000; i += 3) {
+      table->remove("v" + to_string(i));
+    }
+    table->modify("v1", make_unique<IntegerValue>(-1));
+
+    for (int i = 0; i < 1000; ++i) {
+      const string name = "v" + to_string(i);
+      if (i % 3 == 0) {
+        CHECK(!table->exists(name));
+        CHECK(table->find(name) == nullptr);
+      } else {
+        CHECK(table->exists(name));
+        CHECK(table->is_constant(name) == (i % 2 == 0));
+        CHECK(cast_value<IntegerValue>(table->get(name))->get_actual_value() == (i == 1 ? -1 : i));
+      }
+    }
+    CHECK(!table->exists("v1000"));
+
+    // A removed variable can be created again
+    table->set("v0", make_unique<IntegerValue>(0), false);
+    CHECK(table->exists("v0"));
+    CHECK(!table->is_constant("v0"));
+  }
+
   SCENARIO("nested tables") {
     shared_ptr<SymbolTable> global = make_shared<SymbolTable>(); // it's shared, so it can be used even after the creation of `nested`
     unique_ptr<SymbolTable> nested = make_unique<SymbolTable>(global); // expects a shared_ptr to another table as parent
@@ -104,5 +133,13 @@ DOCTEST_TEST_SUITE("Symbol Table") {
     CHECK(nested->exists_globally("constant"));
     CHECK(nested->get_highest_level_table().get() == global.get());
     CHECK(nested->does_constant_exist("constant"));
+
+    // Modifying or removing a variable of the parent context from the nested context
+    nested->modify("constant", make_unique<IntegerValue>(20));
+    CHECK(cast_value<IntegerValue>(global->get("constant"))->get_actual_value() == 20);
+    CHECK(&nested->find("constant")->get_value() == &global->find("constant")->get_value());
+    nested->remove("constant");
+    CHECK(!global->exists("constant"));
+    CHECK(!nested->exists_globally("constant"));
   }
 }
\ No newline at end of file
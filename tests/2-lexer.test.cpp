@@ -282,6 +282,26 @@ DOCTEST_TEST_SUITE("Lexer") {
     CHECK(tokens[2]->getStringValue() == "c'est");
   }
 
+  SCENARIO("string interpolation") {
+    const auto tokens = list_to_vector(get_tokens_from(R"("I'm $age years old, $_name2!" '$age' "\$age $ $true")"));
+    CHECK(tokens.size() == 3);
+    CHECK(tokens[0]->getStringValue() == "I'm $age years old, $_name2!");
+    const auto& interpolations = tokens[0]->getInterpolations();
+    CHECK(interpolations.size() == 2);
+    CHECK(interpolations[0].offset == 4);
+    CHECK(interpolations[0].name == "age");
+    CHECK(interpolations[0].pos_start.get_idx() == 5);
+    CHECK(interpolations[0].pos_end.get_idx() == 9);
+    CHECK(interpolations[1].offset == 20);
+    CHECK(interpolations[1].name == "_name2");
+
+    // Simple quotes don't allow interpolation
+    CHECK(tokens[1]->getInterpolations().empty());
+    // An escaped dollar, a lonely dollar and a keyword stay in the string
+    CHECK(tokens[2]->getStringValue() == "$age $ $true");
+    CHECK(tokens[2]->getInterpolations().empty());
+  }
+
   SCENARIO("illegal char") {
     CHECK_THROWS_AS(get_tokens_from("é"), IllegalCharError);
   }
@@ -306,6 +326,32 @@ DOCTEST_TEST_SUITE("Lexer") {
     CHECK(tokens[5]->ofType(TokenType::NUMBER));
   }
 
+  SCENARIO("list") {
+    const auto tokens = list_to_vector(get_tokens_from("[1, a]"));
+    CHECK(tokens.size() == 5);
+    CHECK(tokens[0]->ofType(TokenType::LSQUARE));
+    CHECK(tokens[1]->ofType(TokenType::NUMBER));
+    CHECK(tokens[2]->ofType(TokenType::COMMA));
+    CHECK(tokens[3]->ofType(TokenType::IDENTIFIER));
+    CHECK(tokens[4]->ofType(TokenType::RSQUARE));
+  }
+
+  SCENARIO("dictionary") {
+    const auto tokens = list_to_vector(get_tokens_from("{'a': 1}"));
+    CHECK(tokens.size() == 5);
+    CHECK(tokens[0]->ofType(TokenType::LBRACK));
+    CHECK(tokens[2]->ofType(TokenType::COLON));
+    CHECK(tokens[4]->ofType(TokenType::RBRACK));
+  }
+
+  SCENARIO("slice") {
+    const auto tokens = list_to_vector(get_tokens_from("a[1:2]"));
+    CHECK(tokens.size() == 6);
+    CHECK(tokens[1]->ofType(TokenType::LSQUARE));
+    CHECK(tokens[3]->ofType(TokenType::COLON));
+    CHECK(tokens[5]->ofType(TokenType::RSQUARE));
+  }
+
   SCENARIO("boolean operators") {
     const auto tokens = list_to_vector(get_tokens_from("and or not !"));
     CHECK(tokens.size() == 4);
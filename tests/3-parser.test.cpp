@@ -350,6 +350,107 @@ DOCTEST_TEST_SUITE("Parser") {
     CHECK(escaped_backslash->getValue() == "C'EST");
   }
 
+  SCENARIO("string interpolation") {
+    const auto interpolation = cast_node<ConcatNode>(move(get_element_nodes_from(R"("I'm $age years old")")->front()));
+    CHECK(interpolation->get_parts().size() == 3);
+    auto part = interpolation->get_parts().begin();
+    CHECK(static_cast<const StringNode&>(**part).getValue() == "I'm ");
+    CHECK(static_cast<const VarAccessNode&>(**++part).get_var_name() == "age");
+    CHECK(static_cast<const StringNode&>(**++part).getValue() == " years old");
+    CHECK(interpolation->getStartingPosition().get_idx() == 0);
+    CHECK(interpolation->getEndingPosition().get_idx() == 20);
+
+    // The empty segments are skipped
+    const auto variables = cast_node<ConcatNode>(move(get_element_nodes_from(R"("$a$b")")->front()));
+    CHECK(variables->get_parts().size() == 2);
+    CHECK(variables->get_parts().front()->getNodeType() == NodeType::VAR_ACCESS);
+
+    CHECK(get_element_nodes_from(R"("no variable")")->front()->getNodeType() == NodeType::STRING);
+  }
+
+  SCENARIO("list literal") {
+    const auto list = cast_node<ListNode>(move(get_element_nodes_from("[1, 'a',\n  2 + 3]")->front()));
+    CHECK(list->get_number_of_nodes() == 3);
+    CHECK(list->get_elements().back()->getNodeType() == NodeType::ADD);
+    CHECK(list->getStartingPosition().get_idx() == 0);
+    CHECK(list->getEndingPosition().get_idx() == 17);
+    CHECK(cast_node<ListNode>(move(get_element_nodes_from("[]")->front()))->get_number_of_nodes() == 0);
+    CHECK_THROWS_AS(get_element_nodes_from("[1, 2"), InvalidSyntaxError);
+    CHECK_THROWS_AS(get_element_nodes_from("[1 2]"), InvalidSyntaxError);
+  }
+
+  SCENARIO("dictionary literal") {
+    const auto dict = cast_node<DictNode>(move(get_element_nodes_from("{'a': 1,\n  'b': 2 + 3}")->front()));
+    CHECK(dict->get_number_of_entries() == 2);
+    CHECK(dict->get_entries().front()->getNodeType() == NodeType::STRING);
+    CHECK(dict->get_entries().back()->getNodeType() == NodeType::ADD);
+    CHECK(dict->getStartingPosition().get_idx() == 0);
+    CHECK(dict->getEndingPosition().get_idx() == 22);
+    CHECK(cast_node<DictNode>(move(get_element_nodes_from("{}")->front()))->get_number_of_entries() == 0);
+    CHECK(get_element_nodes_from("{'a': 1}['a']")->front()->getNodeType() == NodeType::LIST_ACCESS);
+    CHECK_THROWS_AS(get_element_nodes_from("{'a': 1"), InvalidSyntaxError);
+    CHECK_THROWS_AS(get_element_nodes_from("{'a' 1}"), InvalidSyntaxError);
+    CHECK_THROWS_AS(get_element_nodes_from("{'a': 1 'b': 2}"), InvalidSyntaxError);
+    CHECK_THROWS_AS(get_element_nodes_from("{'a'}"), InvalidSyntaxError);
+  }
+
+  SCENARIO("call to a built-in function") {
+    const auto call = cast_node<CallNode>(move(get_element_nodes_from("dot([1, 2], a)")->front()));
+    CHECK(call->get_builtin() == Builtin::DOT);
+    CHECK(call->get_args().size() == 2);
+    CHECK(call->get_args().front()->getNodeType() == NodeType::LIST);
+    CHECK(call->getEndingPosition().get_idx() == 14);
+    CHECK(get_element_nodes_from("sum(a) * 2")->front()->getNodeType() == NodeType::MULTIPLY);
+    CHECK_THROWS_AS(get_element_nodes_from("unknown(a)"), InvalidSyntaxError);
+    CHECK_THROWS_AS(get_element_nodes_from("sum(a, b)"), InvalidSyntaxError);
+    CHECK_THROWS_AS(get_element_nodes_from("dot(a)"), InvalidSyntaxError);
+    CHECK_THROWS_AS(get_element_nodes_from("sum(a"), InvalidSyntaxError);
+  }
+
+  SCENARIO("access to the elements of a list") {
+    const auto access = cast_node<ListAccessNode>(move(get_element_nodes_from("a[1 + 2]")->front()));
+    CHECK(access->get_list().getNodeType() == NodeType::VAR_ACCESS);
+    CHECK(access->get_index().getNodeType() == NodeType::ADD);
+    CHECK(access->getStartingPosition().get_idx() == 0);
+    CHECK(access->getEndingPosition().get_idx() == 8);
+
+    const auto slice = cast_node<ListSliceNode>(move(get_element_nodes_from("[1, 2, 3][0:2]")->front()));
+    CHECK(slice->get_list().getNodeType() == NodeType::LIST);
+    CHECK(slice->get_start().getNodeType() == NodeType::INTEGER);
+    CHECK(slice->get_end().getNodeType() == NodeType::INTEGER);
+    // The accesses can be chained
+    const auto chained = cast_node<ListAccessNode>(move(get_element_nodes_from("a[0:2][1]")->front()));
+    CHECK(chained->get_list().getNodeType() == NodeType::LIST_SLICE);
+
+    const auto assignment = cast_node<ListAssignmentNode>(move(get_element_nodes_from("a[0] = 5")->front()));
+    CHECK(assignment->get_var_name() == "a");
+    CHECK(assignment->get_index_node().getNodeType() == NodeType::INTEGER);
+    CHECK(assignment->get_value_node().getNodeType() == NodeType::INTEGER);
+
+    CHECK_THROWS_AS(get_element_nodes_from("a[1"), InvalidSyntaxError);
+    CHECK_THROWS_AS(get_element_nodes_from("a[1:2"), InvalidSyntaxError);
+    CHECK_THROWS_AS(get_element_nodes_from("a[1 2]"), InvalidSyntaxError);
+    CHECK_THROWS_AS(get_element_nodes_from("[1, 2][0] = 5"), InvalidSyntaxError);
+  }
+
+  SCENARIO("concatenation chain") {
+    const auto chain = cast_node<ConcatNode>(move(get_element_nodes_from("'a' + 5 + true + 'b'")->front()));
+    CHECK(chain->get_parts().size() == 4);
+    CHECK(chain->get_parts().front()->getNodeType() == NodeType::STRING);
+    CHECK(chain->get_parts().back()->getNodeType() == NodeType::STRING);
+    CHECK(chain->getStartingPosition().get_idx() == 0);
+    CHECK(chain->getEndingPosition().get_idx() == 20);
+
+    // A single addition is already optimized, it's not turned into a chain
+    CHECK(get_element_nodes_from("'a' + 5")->front()->getNodeType() == NodeType::ADD);
+    // The left operand must be statically known to be a string
+    CHECK(get_element_nodes_from("5 + 'a' + 'b'")->front()->getNodeType() == NodeType::ADD);
+    // Only the additions are concatenated, the other operators keep their precedence
+    const auto mixed = cast_node<ConcatNode>(move(get_element_nodes_from("'a' + 2 * 3 + 'b'")->front()));
+    CHECK(mixed->get_parts().size() == 3);
+    CHECK((*next(mixed->get_parts().begin()))->getNodeType() == NodeType::MULTIPLY);
+  }
+
   SCENARIO("boolean") {
     const auto t = cast_node<BooleanNode>(move(get_element_nodes_from("true")->front()));
     const auto f = cast_node<BooleanNode>(move(get_element_nodes_from("false")->front()));
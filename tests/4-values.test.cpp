@@ -1,10 +1,16 @@
 #include <iostream>
 #include <list>
+#include <numeric>
+#include <thread>
+#include <algorithm>
 #include "doctest.h"
 #include "../include/parser.hpp"
 #include "../include/types.hpp"
 #include "../include/miscellaneous.hpp"
 #include "../include/values/compositer.hpp"
+#include "../include/values/list_operations.hpp"
+#include "../include/utils/persistent_vector.hpp"
+#include "../include/exceptions/exception.hpp"
 using namespace std;
 
 DOCTEST_TEST_SUITE("Values") {
@@ -12,17 +18,68 @@ DOCTEST_TEST_SUITE("Values") {
     unique_ptr<IntegerValue> integer = make_unique<IntegerValue>(5);
     unique_ptr<IntegerValue> copy = unique_ptr<IntegerValue>(integer->copy());
 
-    const Position* copy_pos_start = copy->get_pos_start();
-    const Position* copy_pos_end = copy->get_pos_end();
-
     CHECK(integer->get_actual_value() == copy->get_actual_value());
-    CHECK(integer->get_pos_start() != copy_pos_start);
-    CHECK(integer->get_pos_end() != copy_pos_end);
-    CHECK(integer->get_pos_start()->equals(*copy_pos_start));
-    CHECK(integer->get_pos_end()->equals(*copy_pos_end));
     CHECK(integer.get() != copy.get());
   }
 
+  SCENARIO("values are allocated from the pool") {
+    const pool_stats_t before = ValuePool::get_stats();
+    IntegerValue* integer = new IntegerValue(5);
+    CHECK(ValuePool::get_stats().live_objects == before.live_objects + 1);
+    CHECK(ValuePool::get_stats().slabs >= 1);
+    const void* address = integer;
+    delete integer;
+    CHECK(ValuePool::get_stats().live_objects == before.live_objects);
+
+    // The freed block is reused by the next value of the same size
+    const pool_stats_t after_delete = ValuePool::get_stats();
+    DoubleValue* number = new DoubleValue(3.14);
+    CHECK(static_cast<const void*>(number) == address);
+    CHECK(ValuePool::get_stats().hits == after_delete.hits + 1);
+    delete number;
+  }
+
+  SCENARIO("values destroyed by another thread") {
+    // Created by a thread that ends before they're destroyed
+    vector<IntegerValue*> from_worker;
+    thread([&from_worker]() {
+      for (int i = 0; i < 10000; ++i) from_worker.push_back(new IntegerValue(i));
+      delete new IntegerValue(-1); // freed locally, the slab stays alive for the other values
+    }).join();
+    int64_t total = 0;
+    for (const IntegerValue* integer : from_worker) total += integer->get_actual_value();
+    CHECK(total == 49995000);
+    for (const IntegerValue* integer : from_worker) delete integer;
+
+    // Created by this thread, destroyed by a worker, and then reused by this thread
+    const pool_stats_t before = ValuePool::get_stats();
+    vector<IntegerValue*> from_main;
+    for (int i = 0; i < 100; ++i) from_main.push_back(new IntegerValue(i));
+    CHECK(ValuePool::get_stats().live_objects == before.live_objects + 100);
+    thread([&from_main]() {
+      for (const IntegerValue* integer : from_main) delete integer;
+    }).join();
+    CHECK(ValuePool::get_stats().live_objects == before.live_objects);
+    const unique_ptr<IntegerValue> reused = make_unique<IntegerValue>(5);
+    CHECK(reused->get_actual_value() == 5);
+  }
+
+  SCENARIO("copies share the heap storage") {
+    unique_ptr<StringValue> str = make_unique<StringValue>("hello world");
+    unique_ptr<StringValue> str_copy = unique_ptr<StringValue>(str->copy());
+    CHECK(str->get_actual_value().data() == str_copy->get_actual_value().data());
+    str.reset(); // the storage must survive as long as a copy exists
+    CHECK(str_copy->get_actual_value() == "hello world");
+
+    list_of_values_ptr elements;
+    elements.push_back(make_shared<IntegerValue>(5));
+    unique_ptr<ListValue> list_value = make_unique<ListValue>(elements);
+    unique_ptr<ListValue> list_copy = unique_ptr<ListValue>(list_value->copy());
+    CHECK(list_value->get_elements().data() == list_copy->get_elements().data());
+    list_value.reset();
+    CHECK(list_copy->get_elements().size() == 1);
+  }
+
   SCENARIO("integer") {
     unique_ptr<IntegerValue> integer = make_unique<IntegerValue>(5);
     unique_ptr<IntegerValue> default_integer = make_unique<IntegerValue>();
@@ -33,6 +90,66 @@ DOCTEST_TEST_SUITE("Values") {
     CHECK(!default_integer->is_truthy());
   }
 
+  SCENARIO("big integer") {
+    const BigIntValue big(BigInteger::from_string("-123456789012345678901234567890"));
+    CHECK(big.get_type() == Type::BIGINT);
+    CHECK(get_type_name(big.get_type()) == "int");
+    CHECK(big.to_string() == "-123456789012345678901234567890");
+    CHECK(big.is_truthy());
+    CHECK(cast_value<DoubleValue>(big.cast(Type::DOUBLE))->get_actual_value() == doctest::Approx(-1.2345678901234568e29));
+    CHECK(big.cast(Type::INT)->to_string() == big.to_string());
+
+    // the results that fit in 64 bits are native integers again
+    const unique_ptr<Value> sum(big + BigIntValue(BigInteger::from_string("123456789012345678901234567891")));
+    CHECK(sum->get_type() == Type::INT);
+    CHECK(sum->to_string() == "1");
+
+    CHECK(BigInteger(INT64_MIN).to_string() == "-9223372036854775808");
+    CHECK(BigInteger(INT64_MIN).fits_in_int64());
+    CHECK(!(-BigInteger(INT64_MIN)).fits_in_int64());
+    CHECK(BigInteger(0).to_string() == "0");
+    CHECK(BigInteger::from_string("-0") == BigInteger(0));
+    CHECK(BigInteger::from_string("1" + string(500, '0')).to_string() == "1" + string(500, '0'));
+    CHECK(BigInteger(10).pow(500) == BigInteger::from_string("1" + string(500, '0')));
+    CHECK_THROWS_AS(BigInteger::from_string("12a"), Exception);
+
+    // the decimal conversion splits the number recursively, so the zeros in the middle must be kept
+    string digits;
+    for (int i = 0; i < 3000; ++i) digits += static_cast<char>('1' + (i * 7919) % 9);
+    digits.replace(1000, 60, string(60, '0'));
+    CHECK(BigInteger::from_string(digits).to_string() == digits);
+    CHECK(BigInteger::from_string("-" + digits).to_string() == "-" + digits);
+  }
+
+  SCENARIO("big integer multiplications and divisions") {
+    // 3^5000 with Karatsuba's multiplications (the squares are big enough)
+    // and with the schoolbook multiplications (one of the operands is a single limb)
+    BigInteger product(1);
+    for (int i = 0; i < 5000; ++i) product = product * BigInteger(3);
+    const BigInteger power = BigInteger(3).pow(5000);
+    CHECK(power == product);
+    CHECK(power.bit_length() == 7925);
+
+    // (a + 1)(a - 1) = a^2 - 1, with unbalanced operands as well
+    const BigInteger a = BigInteger(7).pow(3000) + BigInteger(12345);
+    const BigInteger b = BigInteger(-11).pow(401);
+    CHECK((a + BigInteger(1)) * (a - BigInteger(1)) == a * a - BigInteger(1));
+    CHECK((a * b) * (b * a) == (a * a) * (b * b));
+
+    BigInteger quotient, remainder;
+    BigInteger::divide(a * b + BigInteger(-42), b, quotient, remainder);
+    CHECK(quotient == a);
+    CHECK(remainder == BigInteger(-42));
+    BigInteger::divide(-power, a, quotient, remainder);
+    CHECK(quotient * a + remainder == -power);
+    CHECK(remainder.is_negative());
+    CHECK(-remainder < a);
+    BigInteger::divide(BigInteger(17), BigInteger(-5), quotient, remainder);
+    CHECK(quotient == BigInteger(-3)); // just like C++
+    CHECK(remainder == BigInteger(2));
+    CHECK_THROWS_AS(BigInteger::divide(a, BigInteger(0), quotient, remainder), Exception);
+  }
+
   SCENARIO("double") {
     unique_ptr<DoubleValue> d = make_unique<DoubleValue>(3.14);
     unique_ptr<DoubleValue> double_default = make_unique<DoubleValue>();
@@ -57,6 +174,17 @@ DOCTEST_TEST_SUITE("Values") {
     CHECK(default_str.to_string().empty());
     CHECK(!default_str.is_truthy());
 
+    // The small strings are stored in the value itself, so each copy has its own characters
+    const StringValue small("12345678");
+    const unique_ptr<StringValue> small_copy(small.copy());
+    CHECK(StringValue::INLINE_CAPACITY == 8);
+    CHECK(small_copy->get_actual_value() == "12345678");
+    CHECK(small_copy->get_actual_value().data() != small.get_actual_value().data());
+    const StringValue large(string(1000, 'a') + "b");
+    CHECK(large.get_actual_value().length() == 1001);
+    CHECK(large.get_actual_value().back() == 'b');
+    CHECK(cast_value<IntegerValue>(large.cast(Type::INT))->get_actual_value() == 1001);
+
     // Test the possible casts from StringValue to another type
     unique_ptr<IntegerValue> cast_int = cast_value<IntegerValue>(hello.cast(Type::INT));
     CHECK(cast_int->get_actual_value() == static_cast<int>(hello.get_actual_value().length()));
@@ -97,6 +225,345 @@ DOCTEST_TEST_SUITE("Values") {
     delete empty;
     delete invalid_str;
     delete hellohellohello;
+
+    // The repetitions double the filled prefix, whatever the number of times
+    for (const int64_t times : {1, 2, 5, 8, 31, 64, 1000, 1025}) {
+      string expected;
+      for (int64_t i = 0; i < times; ++i) expected += "abc";
+      const unique_ptr<StringValue> repetition(StringValue("abc") * IntegerValue(times));
+      CHECK(repetition->get_actual_value() == expected);
+    }
+    const unique_ptr<StringValue> empty_repetition(default_str * IntegerValue(INT64_MAX));
+    CHECK(empty_repetition->get_actual_value().empty());
+    // A repetition longer than the maximum isn't allocated at all
+    CHECK(StringValue("ab") * IntegerValue(StringValue::MAX_LENGTH / 2 + 1) == nullptr);
+    CHECK(hello * IntegerValue(INT64_MAX) == nullptr);
+  }
+
+  SCENARIO("string ropes") {
+    // the short concatenations stay flat
+    const unique_ptr<StringValue> short_string(StringValue::concatenate(StringValue("hello "), StringValue("world")));
+    CHECK(!short_string->is_rope());
+    CHECK(short_string->get_actual_value() == "hello world");
+
+    // appending pieces to a long string doesn't copy it
+    unique_ptr<StringValue> rope = make_unique<StringValue>(string(StringValue::ROPE_THRESHOLD, '-'));
+    string expected = rope->to_string();
+    for (int i = 0; i < 1000; ++i) {
+      const StringValue piece(std::to_string(i));
+      rope = unique_ptr<StringValue>(i % 2 == 0 ? *rope + piece : StringValue::make_concatenation_rtl(&piece, rope.get()));
+      expected = i % 2 == 0 ? expected + std::to_string(i) : std::to_string(i) + expected;
+    }
+    const unique_ptr<StringValue> copy(rope->copy());
+    const unique_ptr<StringValue> with_integer(*rope + IntegerValue(5));
+    CHECK(rope->is_rope());
+    CHECK(rope->length() == expected.length());
+    CHECK(cast_value<IntegerValue>(rope->cast(Type::INT))->get_actual_value() == static_cast<int64_t>(expected.length()));
+    CHECK(rope->is_rope()); // the length doesn't need the characters
+    CHECK(rope->get_actual_value() == expected);
+    CHECK(copy->get_actual_value().data() == rope->get_actual_value().data()); // flattened once for all the copies
+    CHECK(with_integer->to_string() == expected + "5");
+
+    // once gathered, a rope releases its children, so that its characters aren't kept twice
+    string_storage_t* gathered = new string_storage_t(new string_storage_t(string(300, 'a')), new string_storage_t(string(300, 'b')));
+    CHECK(gathered->is_rope());
+    CHECK(gathered->left != nullptr);
+    CHECK(gathered->view() == string(300, 'a') + string(300, 'b'));
+    CHECK(gathered->left == nullptr);
+    CHECK(gathered->right == nullptr);
+    CHECK(gathered->view().length() == 600);
+    const unique_ptr<StringValue> appended(*rope + StringValue("!"));
+    CHECK(appended->get_actual_value() == expected + "!"); // goes through a rope that was gathered
+    delete gathered;
+
+    // a very long chain is released without any recursion
+    unique_ptr<StringValue> chain = make_unique<StringValue>(string(StringValue::ROPE_THRESHOLD, 'a'));
+    for (int i = 0; i < 200000; ++i) {
+      chain = unique_ptr<StringValue>(*chain + StringValue("b"));
+    }
+    CHECK(chain->length() == StringValue::ROPE_THRESHOLD + 200000);
+    CHECK(chain->get_actual_value().back() == 'b');
+    chain.reset();
+  }
+
+  SCENARIO("list") {
+    // A large homogeneous list is unboxed
+    list_of_values_ptr integers;
+    for (int i = 0; i < 1000; ++i) integers.push_back(make_shared<IntegerValue>(i));
+    const ListValue integer_list(integers);
+    CHECK(integer_list.get_kind() == ListKind::INTEGERS);
+    CHECK(integer_list.size() == 1000);
+    CHECK(integer_list.get_integers()[999] == 999);
+    CHECK(cast_value<IntegerValue>(integer_list.cast(Type::INT))->get_actual_value() == 1000);
+    CHECK(integer_list.to_string().starts_with("[0, 1, 2, "));
+    CHECK(integer_list.to_string().ends_with(", 999]"));
+    // its elements are boxed when they're read as values
+    CHECK(integer_list.get_elements().size() == 1000);
+    CHECK(integer_list.get_elements()[500]->to_string() == "500");
+    CHECK(integer_list.get_elements().data() == integer_list.get_elements().data()); // boxed once
+
+    list_of_values_ptr doubles;
+    list_of_values_ptr booleans;
+    for (int i = 0; i < 100; ++i) {
+      doubles.push_back(make_shared<DoubleValue>(i + 0.5));
+      booleans.push_back(make_shared<BooleanValue>(i % 2 == 0));
+    }
+    const ListValue double_list(doubles);
+    const ListValue boolean_list(booleans);
+    CHECK(double_list.get_kind() == ListKind::DOUBLES);
+    CHECK(double_list.get_doubles().back() == 99.5);
+    CHECK(boolean_list.get_kind() == ListKind::BOOLEANS);
+    CHECK(boolean_list.to_string().starts_with("[1, 0, 1, "));
+    CHECK(!boolean_list.get_elements()[1]->is_truthy());
+
+    // A mixed list, or a small one, keeps its handles
+    list_of_values_ptr mixed = integers;
+    mixed.push_back(make_shared<DoubleValue>(0.5));
+    const ListValue mixed_list(mixed);
+    CHECK(mixed_list.get_kind() == ListKind::VALUES);
+    CHECK(mixed_list.get_elements().back().get() == mixed.back().get());
+    const ListValue small_list(list_of_values_ptr(integers.begin(), integers.begin() + 3));
+    CHECK(small_list.get_kind() == ListKind::VALUES);
+    CHECK(small_list.to_string() == "[0, 1, 2]");
+    CHECK(ListValue(list_of_values_ptr()).to_string() == "[]");
+    CHECK(!ListValue(list_of_values_ptr()).is_truthy());
+
+    // The lists created from native numbers are unboxed whatever their length
+    const unique_ptr<ListValue> native(ListValue::from_doubles({ 1.5, 2.5 }));
+    CHECK(native->get_kind() == ListKind::DOUBLES);
+    CHECK(native->to_string() == "[1.5, 2.5]");
+    const unique_ptr<ListValue> native_copy(native->copy());
+    CHECK(native_copy->get_doubles().data() == native->get_doubles().data());
+  }
+
+  SCENARIO("list operations") {
+    const auto integer = [](Value* value) { const unique_ptr<Value> owner(value); return static_cast<const IntegerValue&>(*owner).get_actual_value(); };
+    const auto real = [](Value* value) { const unique_ptr<Value> owner(value); return static_cast<const DoubleValue&>(*owner).get_actual_value(); };
+
+    // 103 elements, so that the last ones don't fill the 4 lanes of the kernels
+    vector<int64_t> integers;
+    vector<double> doubles;
+    for (int64_t i = 0; i < 103; ++i) {
+      integers.push_back((i * 37) % 101 - 50);
+      doubles.push_back(static_cast<double>(i) * 0.25 - 7);
+    }
+    const unique_ptr<ListValue> a(ListValue::from_integers(integers));
+    const unique_ptr<ListValue> b(ListValue::from_doubles(doubles));
+    CHECK(integer(ListOperations::sum(*a)) == accumulate(integers.begin(), integers.end(), int64_t(0)));
+    CHECK(integer(ListOperations::min(*a)) == *min_element(integers.begin(), integers.end()));
+    CHECK(integer(ListOperations::max(*a)) == *max_element(integers.begin(), integers.end()));
+    CHECK(real(ListOperations::mean(*a)) == doctest::Approx(accumulate(integers.begin(), integers.end(), 0.0) / 103));
+    CHECK(real(ListOperations::sum(*b)) == doctest::Approx(accumulate(doubles.begin(), doubles.end(), 0.0)));
+    CHECK(real(ListOperations::min(*b)) == -7);
+    CHECK(real(ListOperations::max(*b)) == 18.5);
+    CHECK(real(ListOperations::dot(*a, *b)) == doctest::Approx(inner_product(integers.begin(), integers.end(), doubles.begin(), 0.0)));
+    const int64_t squares = inner_product(integers.begin(), integers.end(), integers.begin(), int64_t(0));
+    CHECK(integer(ListOperations::dot(*a, *a)) == squares);
+
+    // The element-wise operations produce unboxed lists
+    const unique_ptr<ListValue> sum(ListOperations::add(*a, *a));
+    CHECK(sum->get_kind() == ListKind::INTEGERS);
+    CHECK(sum->get_integers()[102] == 2 * integers[102]);
+    const unique_ptr<ListValue> promoted(ListOperations::add(*a, *b));
+    CHECK(promoted->get_kind() == ListKind::DOUBLES);
+    CHECK(promoted->get_doubles()[101] == integers[101] + doubles[101]);
+    const unique_ptr<ListValue> tripled(ListOperations::multiply(*a, IntegerValue(3)));
+    CHECK(tripled->get_integers()[100] == 3 * integers[100]);
+    const unique_ptr<ListValue> halved(ListOperations::multiply(*a, DoubleValue(0.5)));
+    CHECK(halved->get_doubles()[102] == integers[102] * 0.5);
+
+    // The overflows of integers
+    const unique_ptr<ListValue> big(ListValue::from_integers(vector<int64_t>(21, INT64_MAX)));
+    const unique_ptr<Value> big_sum(ListOperations::sum(*big));
+    CHECK(big_sum->get_type() == Type::BIGINT);
+    CHECK(big_sum->to_string() == "193690812773950291947");
+    CHECK(unique_ptr<Value>(ListOperations::dot(*big, *big))->get_type() == Type::BIGINT);
+    CHECK(real(ListOperations::mean(*big)) == doctest::Approx(static_cast<double>(INT64_MAX)));
+    CHECK(ListOperations::add(*big, *big) == nullptr); // the interpreter adds them one by one
+    CHECK(ListOperations::multiply(*big, IntegerValue(2)) == nullptr);
+    CHECK(ListOperations::multiply(*a, BigIntValue(BigInteger(2))) == nullptr);
+
+    // The small lists, and the lists of booleans, are converted first
+    const ListValue mixed({ make_shared<IntegerValue>(1), make_shared<DoubleValue>(2.5), make_shared<BooleanValue>(true) });
+    CHECK(real(ListOperations::sum(mixed)) == 4.5);
+    CHECK(real(ListOperations::min(mixed)) == 1);
+    const unique_ptr<ListValue> booleans(ListOperations::multiply(ListValue({ make_shared<BooleanValue>(true), make_shared<BooleanValue>(false) }), IntegerValue(5)));
+    CHECK(booleans->to_string() == "[5, 0]");
+
+    // The errors
+    const ListValue strings({ make_shared<StringValue>("a") });
+    const ListValue empty(list_of_values_ptr{});
+    CHECK(ListOperations::sum(strings) == nullptr);
+    CHECK(integer(ListOperations::sum(empty)) == 0);
+    CHECK(ListOperations::min(empty) == nullptr);
+    CHECK(ListOperations::mean(empty) == nullptr);
+    CHECK(ListOperations::dot(*a, mixed) == nullptr);
+    CHECK(ListOperations::add(*a, mixed) == nullptr);
+  }
+
+  SCENARIO("list slices") {
+    vector<int64_t> integers(100);
+    iota(integers.begin(), integers.end(), 0);
+    const unique_ptr<ListValue> list(ListValue::from_integers(integers));
+
+    // A slice shares the elements of its list
+    const unique_ptr<ListValue> slice(list->slice(10, 20));
+    CHECK(slice->is_slice());
+    CHECK(!list->is_slice());
+    CHECK(slice->size() == 10);
+    CHECK(slice->get_kind() == ListKind::INTEGERS);
+    CHECK(slice->get_integers().data() == list->get_integers().data() + 10);
+    CHECK(slice->to_string() == "[10, 11, 12, 13, 14, 15, 16, 17, 18, 19]");
+    CHECK(unique_ptr<Value>(ListOperations::sum(*slice))->to_string() == "145");
+
+    // A slice of a slice shares the elements of the same list
+    const unique_ptr<ListValue> sub(slice->slice(2, 5));
+    CHECK(sub->get_integers().data() == list->get_integers().data() + 12);
+    CHECK(unique_ptr<Value>(sub->get_element(0))->to_string() == "12");
+    CHECK(unique_ptr<ListValue>(slice->slice(3, 3))->size() == 0);
+
+    // The slice keeps the elements alive
+    ListValue* orphan = list->slice(90, 100);
+    const unique_ptr<ListValue> copy(orphan->copy());
+    delete orphan;
+    CHECK(copy->to_string() == "[90, 91, 92, 93, 94, 95, 96, 97, 98, 99]");
+
+    // Boxing a slice only boxes its own elements
+    CHECK(sub->get_elements().size() == 3);
+    CHECK(sub->get_elements()[2]->to_string() == "14");
+
+    // A slice of handles reads the handles of its list
+    const ListValue mixed({ make_shared<IntegerValue>(1), make_shared<StringValue>("a"), make_shared<BooleanValue>(true) });
+    const unique_ptr<ListValue> mixed_slice(mixed.slice(1, 3));
+    CHECK(mixed_slice->get_elements().data() == mixed.get_elements().data() + 1);
+    CHECK(mixed_slice->to_string() == "[a, 1]");
+
+    // Modifying an element copies the elements (copy-on-write)
+    const unique_ptr<ListValue> modified(slice->with_element(0, IntegerValue(-1)));
+    CHECK(!modified->is_slice());
+    CHECK(modified->get_kind() == ListKind::INTEGERS);
+    CHECK(modified->get_integers()[0] == -1);
+    CHECK(slice->get_integers()[0] == 10);
+    CHECK(list->get_integers()[10] == 10);
+    const unique_ptr<ListValue> boxed(slice->with_element(1, StringValue("b")));
+    CHECK(boxed->get_kind() == ListKind::VALUES);
+    CHECK(boxed->to_string() == "[10, b, 12, 13, 14, 15, 16, 17, 18, 19]");
+  }
+
+  SCENARIO("persistent vector") {
+    // Enough elements for a trie of three levels
+    vector<int64_t> integers(2000);
+    iota(integers.begin(), integers.end(), 0);
+    const PersistentVector<int64_t> vector_a(integers);
+    CHECK(vector_a.size() == 2000);
+    CHECK(vector_a[0] == 0);
+    CHECK(vector_a[1999] == 1999);
+
+    const PersistentVector<int64_t> vector_b = vector_a.set(1500, -1);
+    CHECK(vector_b[1500] == -1);
+    CHECK(vector_a[1500] == 1500); // the original vector is left untouched
+    CHECK(vector_b[1499] == 1499);
+
+    // The elements are gathered across the boundaries of the leaves, the last one being partial
+    vector<int64_t> gathered;
+    vector_b.append_to(gathered);
+    integers[1500] = -1;
+    CHECK(gathered == integers);
+    CHECK(PersistentVector<int64_t>().empty());
+  }
+
+  SCENARIO("persistent lists") {
+    vector<int64_t> integers(1000);
+    iota(integers.begin(), integers.end(), 0);
+    const unique_ptr<ListValue> list(ListValue::from_integers(integers));
+
+    // Modifying an element of a large list makes it persistent
+    const unique_ptr<ListValue> first(list->with_element(500, IntegerValue(-1)));
+    CHECK(first->is_persistent());
+    CHECK(first->get_kind() == ListKind::INTEGERS);
+    CHECK(first->size() == 1000);
+    const unique_ptr<ListValue> second(first->with_element(999, IntegerValue(-2)));
+    CHECK(unique_ptr<Value>(second->get_element(500))->to_string() == "-1");
+    CHECK(unique_ptr<Value>(second->get_element(999))->to_string() == "-2");
+    CHECK(unique_ptr<Value>(first->get_element(999))->to_string() == "999");
+    CHECK(list->get_integers()[500] == 500);
+
+    // The elements are gathered when they're read contiguously
+    CHECK(second->get_integers().size() == 1000);
+    CHECK(second->get_integers()[500] == -1);
+    CHECK(unique_ptr<Value>(ListOperations::sum(*second))->to_string() == to_string(499500 - 500 - 1 - 999 - 2));
+    const unique_ptr<ListValue> slice(second->slice(499, 502));
+    CHECK(slice->to_string() == "[499, -1, 501]");
+    CHECK(second->get_elements()[999]->to_string() == "-2");
+
+    // An element of another type boxes the elements
+    const unique_ptr<ListValue> mixed(second->with_element(0, StringValue("a")));
+    CHECK(mixed->is_persistent());
+    CHECK(mixed->get_kind() == ListKind::VALUES);
+    CHECK(unique_ptr<Value>(mixed->get_element(0))->to_string() == "a");
+    CHECK(unique_ptr<Value>(mixed->get_element(500))->to_string() == "-1");
+    const unique_ptr<ListValue> remixed(mixed->with_element(1, DoubleValue(0.5)));
+    CHECK(remixed->get_elements()[1]->to_string() == "0.5");
+    CHECK(mixed->get_elements()[1]->to_string() == "1");
+
+    // A small list is copied
+    const ListValue small({ make_shared<IntegerValue>(1), make_shared<IntegerValue>(2) });
+    const unique_ptr<ListValue> small_copy(small.with_element(1, BooleanValue(true)));
+    CHECK(!small_copy->is_persistent());
+    CHECK(small_copy->to_string() == "[1, 1]");
+  }
+
+  SCENARIO("dictionary") {
+    const DictionaryValue empty;
+    CHECK(empty.get_type() == Type::DICT);
+    CHECK(!empty.is_truthy());
+    CHECK(empty.to_string() == "{}");
+    CHECK(empty.get("a") == nullptr);
+
+    // The entries keep the order of their insertion, a repeated key keeps its first position
+    const DictionaryValue dict({
+      { "b", make_shared<IntegerValue>(1) },
+      { "a", make_shared<StringValue>("x") },
+      { "b", make_shared<IntegerValue>(2) }
+    });
+    CHECK(dict.size() == 2);
+    CHECK(dict.is_truthy());
+    CHECK(dict.to_string() == "{b: 2, a: x}");
+    CHECK(dict.get("a")->to_string() == "x");
+    CHECK(dict.get("c") == nullptr);
+    CHECK(dict.cast(Type::INT)->to_string() == "2");
+    CHECK(dict.get_entries()[1].hash == dictionary_storage_t::hash("a"));
+
+    // Modifying an entry copies the entries
+    const unique_ptr<DictionaryValue> modified(dict.with_entry("c", BooleanValue(true)));
+    CHECK(modified->to_string() == "{b: 2, a: x, c: 1}");
+    CHECK(dict.get("c") == nullptr);
+    const unique_ptr<DictionaryValue> copy(dict.copy());
+    CHECK(copy->get_entries().data() == dict.get_entries().data());
+
+    // Setting an entry copies the entries only if they're shared
+    DictionaryValue owner(*modified);
+    owner.set("b", IntegerValue(3));
+    CHECK(owner.to_string() == "{b: 3, a: x, c: 1}");
+    CHECK(modified->to_string() == "{b: 2, a: x, c: 1}");
+    const dictionary_entry_t* owned_entries = owner.get_entries().data();
+    owner.set("a", IntegerValue(4));
+    CHECK(owner.get_entries().data() == owned_entries);
+    CHECK(owner.to_string() == "{b: 3, a: 4, c: 1}");
+
+    // Enough entries to fill several groups and to grow the table several times
+    vector<pair<string, shared_ptr<const Value>>> entries;
+    for (int i = 0; i < 5000; ++i) entries.emplace_back("key" + to_string(i), make_shared<IntegerValue>(i));
+    const DictionaryValue big(move(entries));
+    CHECK(big.size() == 5000);
+    bool found = true;
+    for (int i = 0; i < 5000; ++i) {
+      const Value* value = big.get("key" + to_string(i));
+      found = found && value != nullptr && static_cast<const IntegerValue*>(value)->get_actual_value() == i;
+    }
+    CHECK(found);
+    CHECK(big.get("key5000") == nullptr);
+    CHECK(big.get_entries()[4999].key == "key4999");
   }
 
   SCENARIO("boolean") {
@@ -0,0 +1,214 @@
+#include <fstream>
+#include <filesystem>
+#include "doctest.h"
+#include "../include/batch/batch_evaluator.hpp"
+#include "../include/batch/column_loader.hpp"
+#include "../include/program.hpp"
+#include "../include/exceptions/exception.hpp"
+#include "../include/exceptions/runtime_error.hpp"
+#include "../include/exceptions/type_error.hpp"
+#include "../include/exceptions/arithmetic_error.hpp"
+#include "../include/exceptions/type_overflow_error.hpp"
+using namespace std;
+
+/// @brief Evaluates the expression for each row with the register VM,
+/// so as to make sure that the batch evaluation gives the same results.
+static vector<string> evaluate_rows(const string& source, const vector<int64_t>& x, const vector<double>& y) {
+  Program prog = bk::compile(source);
+  vector<string> results;
+  for (size_t i = 0; i < x.size(); ++i) {
+    prog.bind("x", x[i]);
+    prog.bind("y", y[i]);
+    results.push_back(prog.eval()->to_string());
+  }
+  return results;
+}
+
+/// @brief Writes a temporary file.
+/// @return The path to the file.
+static string write_temporary_file(const string& name, const string& content) {
+  const string path = (filesystem::temp_directory_path() / name).string();
+  ofstream file(path, ios::binary);
+  file << content;
+  return path;
+}
+
+DOCTEST_TEST_SUITE("Batch") {
+  SCENARIO("evaluating an expression over columns") {
+    BatchEvaluator evaluator("price * quantity - 1");
+    evaluator.bind("price", make_shared<Column>(Column::from_doubles({ 1.5, 2.0, 0.5 })));
+    evaluator.bind("quantity", make_shared<Column>(Column::from_integers({ 4, 3, 2 })));
+    const Column result = evaluator.eval();
+    REQUIRE(result.get_type() == Type::DOUBLE);
+    REQUIRE(result.size() == 3);
+    CHECK(result.to_string(0) == "5");
+    CHECK(result.to_string(1) == "5");
+    CHECK(result.to_string(2) == "0");
+  }
+
+  SCENARIO("same semantics as the register VM") {
+    // more rows than a single batch, to go through several of them
+    vector<int64_t> x;
+    vector<double> y;
+    for (int i = 0; i < 2500; ++i) {
+      x.push_back(i - 1250);
+      y.push_back(i * 0.25 + 1);
+    }
+    const auto xs = make_shared<Column>(Column::from_integers(x));
+    const auto ys = make_shared<Column>(Column::from_doubles(y));
+
+    const vector<string> sources = {
+      "x + 2 * x - 7",
+      "x / 3 + x % 7",
+      "x ** 2",
+      "-x + +x",
+      "y % 3 + x / y",
+      "(x + y) ** 2 - y * 1.5",
+      "x",
+      "-(x * 3) % 5"
+    };
+    for (const string& source : sources) {
+      CAPTURE(source);
+      BatchEvaluator evaluator(source);
+      evaluator.bind("x", xs);
+      evaluator.bind("y", ys);
+      const Column result = evaluator.eval();
+      const vector<string> expected = evaluate_rows(source, x, y);
+      REQUIRE(result.size() == expected.size());
+      for (size_t i = 0; i < expected.size(); ++i) {
+        CHECK(result.to_string(i) == expected[i]);
+      }
+    }
+  }
+
+  SCENARIO("expression without any variable") {
+    BatchEvaluator evaluator("5 + 2 * 3");
+    const Column result = evaluator.eval();
+    REQUIRE(result.size() == 1);
+    CHECK(result.get_type() == Type::INT);
+    CHECK(result.to_string(0) == "11");
+  }
+
+  SCENARIO("empty columns") {
+    BatchEvaluator evaluator("x * 2.0");
+    evaluator.bind("x", make_shared<Column>(Column::from_integers({})));
+    const Column result = evaluator.eval();
+    CHECK(result.size() == 0);
+    CHECK(result.get_type() == Type::DOUBLE);
+  }
+
+  SCENARIO("errors") {
+    BatchEvaluator division("10 / x");
+    division.bind("x", make_shared<Column>(Column::from_integers({ 1, 2, 0, 4 })));
+    CHECK_THROWS_AS(division.eval(), ArithmeticError);
+    division.bind("x", make_shared<Column>(Column::from_doubles({ 1.0, 0.0 })));
+    CHECK_THROWS_AS(division.eval(), ArithmeticError);
+    division.bind("x", make_shared<Column>(Column::from_integers({ 1, 2 })));
+    CHECK(division.eval().to_string(1) == "5");
+
+    BatchEvaluator undefined("x + 1");
+    CHECK_THROWS_AS(undefined.eval(), RuntimeError);
+    // The error shows its own source code, not the one of the last evaluator
+    BatchEvaluator other("some_other_expression * 1000");
+    try {
+      undefined.eval();
+    } catch (const RuntimeError& e) {
+      CHECK(e.to_string().find("x + 1") != string::npos);
+      CHECK(e.to_string().find("some_other_expression") == string::npos);
+    }
+
+    BatchEvaluator unsupported("x + 'a'");
+    unsupported.bind("x", make_shared<Column>(Column::from_integers({ 1 })));
+    CHECK_THROWS_AS(unsupported.eval(), TypeError);
+
+    BatchEvaluator mismatch("x + y");
+    mismatch.bind("x", make_shared<Column>(Column::from_integers({ 1, 2 })));
+    mismatch.bind("y", make_shared<Column>(Column::from_integers({ 1 })));
+    CHECK_THROWS_AS(mismatch.eval(), Exception);
+
+    BatchEvaluator overflow("x * 2");
+    overflow.bind("x", make_shared<Column>(Column::from_integers({ 1, INT64_MAX / 2 + 1 })));
+    CHECK_THROWS_AS(overflow.eval(), TypeOverflowError);
+    BatchEvaluator power_overflow("x ** 40");
+    power_overflow.bind("x", make_shared<Column>(Column::from_integers({ 10, 3 })));
+    CHECK_THROWS_AS(power_overflow.eval(), TypeOverflowError);
+    BatchEvaluator power("x ** 39");
+    power.bind("x", make_shared<Column>(Column::from_integers({ 3, -1, 0 })));
+    const Column powers = power.eval();
+    CHECK(powers.to_string(0) == "4052555153018976267");
+    CHECK(powers.to_string(1) == "-1");
+    CHECK(powers.to_string(2) == "0");
+
+    CHECK_THROWS_AS(BatchEvaluator("1\n2"), Exception);
+    CHECK_THROWS_AS(BatchEvaluator(""), Exception);
+    CHECK_THROWS_AS(Column::of_type(Type::STRING), Exception);
+  }
+
+  SCENARIO("loading a CSV file") {
+    const string path = write_temporary_file("bk_batch.csv", "price, quantity\r\n1.5, 4\r\n2,3\n\n0.5,+2\n");
+    const table_t table = ColumnLoader::load(path);
+    REQUIRE(table.rows == 3);
+    REQUIRE(table.names == vector<string>{ "price", "quantity" });
+    CHECK(table.columns[0]->get_type() == Type::DOUBLE);
+    CHECK(table.columns[1]->get_type() == Type::INT);
+    CHECK(table.columns[1]->get_integers() == vector<int64_t>{ 4, 3, 2 });
+
+    BatchEvaluator evaluator("price * quantity");
+    evaluator.bind(table);
+    CHECK(evaluator.eval().get_doubles() == vector<double>{ 6, 6, 1 });
+
+    CHECK_THROWS_AS(ColumnLoader::load(write_temporary_file("bk_batch_invalid.csv", "a,b\n1,2\n3,x\n")), Exception);
+    CHECK_THROWS_AS(ColumnLoader::load(write_temporary_file("bk_batch_missing.csv", "a,b\n1\n")), Exception);
+    CHECK_THROWS_AS(ColumnLoader::load(write_temporary_file("bk_batch_empty.csv", "")), Exception);
+    CHECK_THROWS_AS(ColumnLoader::load("this_file_doesnt_exist.csv"), Exception);
+  }
+
+  SCENARIO("parsing a CSV file in parallel") {
+    // big enough to be split between several threads
+    string content = "x,y\n";
+    for (int i = 0; i < 100000; ++i) {
+      content += to_string(i) + "," + to_string(i % 10) + ".5\n";
+    }
+    const string path = write_temporary_file("bk_batch_parallel.csv", content);
+    const table_t sequential = ColumnLoader::load_csv(path, 1);
+    const table_t parallel = ColumnLoader::load_csv(path, 4);
+    REQUIRE(parallel.rows == 100000);
+    CHECK(parallel.columns[0]->get_integers() == sequential.columns[0]->get_integers());
+    CHECK(parallel.columns[1]->get_doubles() == sequential.columns[1]->get_doubles());
+    CHECK(parallel.columns[0]->get_integers()[99999] == 99999);
+    CHECK(parallel.columns[1]->get_doubles()[12345] == 5.5);
+  }
+
+  SCENARIO("binary columnar files") {
+    table_t table;
+    table.names = { "id", "amount" };
+    table.columns = {
+      make_shared<Column>(Column::from_integers({ 1, 2, 3 })),
+      make_shared<Column>(Column::from_doubles({ 0.25, -1.5, 1e10 }))
+    };
+    table.rows = 3;
+    const string path = (filesystem::temp_directory_path() / "bk_batch.bkc").string();
+    ColumnLoader::write_binary(path, table);
+    const table_t loaded = ColumnLoader::load(path);
+    REQUIRE(loaded.names == table.names);
+    REQUIRE(loaded.rows == 3);
+    CHECK(loaded.columns[0]->get_integers() == table.columns[0]->get_integers());
+    CHECK(loaded.columns[1]->get_doubles() == table.columns[1]->get_doubles());
+
+    BatchEvaluator evaluator("id + amount");
+    evaluator.bind(loaded);
+    vector<double> results;
+    evaluator.eval([&results](const Column& batch) {
+      results.insert(results.end(), batch.get_doubles().begin(), batch.get_doubles().end());
+    });
+    CHECK(results == vector<double>{ 1.25, 0.5, 1e10 + 3 });
+
+    CHECK_THROWS_AS(ColumnLoader::load_binary(write_temporary_file("bk_batch_invalid.bkc", "BKCOLUMN\x01")), Exception);
+    // 2**61 rows of 8 bytes would overflow the size of the column
+    const string huge_rows("BKCOLUMN\x01\0\0\0\0\0\0\0\0\0\0\x20\0\x01\0a", 24);
+    CHECK_THROWS_AS(ColumnLoader::load_binary(write_temporary_file("bk_batch_huge.bkc", huge_rows)), Exception);
+
+    table.names[0] = string(UINT16_MAX + 1, 'a');
+    CHECK_THROWS_AS(ColumnLoader::write_binary(path, table), Exception);
+  }
+}
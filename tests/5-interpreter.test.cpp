@@ -20,7 +20,7 @@ shared_ptr<Context> common_ctx = make_shared<Context>("<tests>");
 /// @param code The code to interpret.
 /// @param clear_ctx Whether or not the global context should be cleared before interpreting the given source code. Defaults to `true`.
 /// @return The values that the interpreter calculated.
-list<shared_ptr<const Value>> get_values(const string& code, bool clear_ctx = true) {
+list_of_values_ptr get_values(const string& code, bool clear_ctx = true) {
   if (clear_ctx) common_ctx->get_symbol_table()->clear();
 
   READ_FILES.insert({ "<stdin>", make_shared<string>(code) });
@@ -28,8 +28,8 @@ list<shared_ptr<const Value>> get_values(const string& code, bool clear_ctx = tr
   unique_ptr<ListNode> tree = parser.parse();
 
   Interpreter::set_shared_ctx(common_ctx);
-  unique_ptr<RuntimeResult> result = Interpreter::visit(move(tree));
-  shared_ptr<Value> v = result->get_value();
+  RuntimeResult result = Interpreter::visit(move(tree));
+  shared_ptr<Value> v = result.take_value();
   if (v == nullptr) {
     throw Exception("Fatal", "Segmentation fault happened during interpretation of this code : " + code + " because the result is a `nullptr`.");
   }
@@ -37,7 +37,8 @@ list<shared_ptr<const Value>> get_values(const string& code, bool clear_ctx = tr
   if (values == nullptr) {
     throw Exception("Fatal", "Invalid cast of interpreter result. It did not return a valid instance of ListValue.");
   }
-  return values->get_elements();
+  const list_of_values_view elements = values->get_elements();
+  return list_of_values_ptr(elements.begin(), elements.end());
 }
 
 void execute(const string& code) {
@@ -55,7 +56,7 @@ shared_ptr<const V> get_custom_value_from(const string& code, bool clear_ctx = t
 
 template <typename V, typename N>
 N get_actual_value_from(const string& code, bool clear_ctx = true) {
-  return get_custom_value_from<V>(code, clear_ctx)->get_actual_value();
+  return N(get_custom_value_from<V>(code, clear_ctx)->get_actual_value());
 }
 
 template <typename V, typename N>
@@ -138,6 +139,59 @@ DOCTEST_TEST_SUITE("Interpreter") {
     CHECK(compare_actual_value<IntegerValue>(half + " + " + half, (INT_MAX - 1))); // (-1 because INT_MAX is not even, and so is rounded down)
   }
 
+  SCENARIO("integers are stored on 64 bits") {
+    CHECK(compare_actual_value<IntegerValue>(std::to_string(INT_MAX) + " * 4", int64_t{INT_MAX} * 4));
+    CHECK(compare_actual_value<IntegerValue>("9223372036854775807", INT64_MAX));
+    CHECK(compare_actual_value<IntegerValue>("-9223372036854775807 - 1", INT64_MIN));
+    CHECK(compare_actual_value<IntegerValue>("(-9223372036854775807 - 1) % -1", int64_t{0}));
+  }
+
+  SCENARIO("integer powers are exact") {
+    CHECK(compare_actual_value<IntegerValue>("3**39", int64_t{4052555153018976267}));
+    CHECK(compare_actual_value<IntegerValue>("(-3)**39", int64_t{-4052555153018976267}));
+    CHECK(compare_actual_value<IntegerValue>("7**22", int64_t{3909821048582988049}));
+    CHECK(compare_actual_value<IntegerValue>("2**62", int64_t{1} << 62));
+    CHECK(compare_actual_value<IntegerValue>("(-2)**63", INT64_MIN));
+    CHECK(compare_actual_value<IntegerValue>("3037000499**2", int64_t{9223372030926249001}));
+    CHECK(compare_actual_value<IntegerValue>("0**0", 1));
+    CHECK(compare_actual_value<IntegerValue>("0**5", 0));
+    CHECK(compare_actual_value<IntegerValue>("1**1000000000000", 1));
+    CHECK(compare_actual_value<IntegerValue>("(-1)**1000000000001", -1));
+    CHECK(compare_actual_value<IntegerValue>("5**1", 5));
+    CHECK(compare_actual_value<IntegerValue>("10**-2", 0)); // truncated, just like before
+    CHECK(get_values("2**63").front()->to_string() == "9223372036854775808");
+    CHECK(get_values("3037000500**2").front()->to_string() == "9223372037000250000");
+    CHECK(get_values("3**40").front()->to_string() == "12157665459056928801");
+  }
+
+  SCENARIO("integers are promoted to big integers when they overflow") {
+    const auto evaluate = [](const string& code) { return get_values(code).front(); };
+    CHECK(evaluate("9223372036854775807 + 1")->get_type() == Type::BIGINT);
+    CHECK(evaluate("9223372036854775807 + 1")->to_string() == "9223372036854775808");
+    CHECK(evaluate("-9223372036854775807 - 2")->to_string() == "-9223372036854775809");
+    CHECK(evaluate("4611686018427387904 * 2")->to_string() == "9223372036854775808");
+    CHECK(evaluate("(-9223372036854775807 - 1) / -1")->to_string() == "9223372036854775808");
+    CHECK(evaluate("-(-9223372036854775807 - 1)")->to_string() == "9223372036854775808");
+    CHECK(evaluate("+(-9223372036854775807 - 1)")->to_string() == "9223372036854775808");
+    CHECK(evaluate("554**23")->to_string() == "1261027590452044953962614699228037827876778641399199717144920064");
+    CHECK(evaluate("2**64 - 2**64 + 5")->get_type() == Type::INT); // back to a native integer
+    CHECK(evaluate("-(2**63)")->get_type() == Type::INT);
+    CHECK(evaluate("(2**100 + 7) % (2**50)")->to_string() == "7");
+    CHECK(evaluate("(2**100) / (2**98)")->to_string() == "4");
+    CHECK(evaluate("-(3**50) / 7")->to_string() == "-102556855384550369824321");
+    CHECK(evaluate("-(3**50) % 7")->to_string() == "-2");
+    CHECK_THROWS_AS(execute("2**64 * 'a'"), TypeOverflowError); // way too long
+    CHECK_THROWS_AS(execute("2**64 - 'a'"), RuntimeError);
+    CHECK(evaluate("99999999999999999999 + 0.5")->get_type() == Type::DOUBLE);
+    CHECK(evaluate("'n = ' + 2**64")->to_string() == "n = 18446744073709551616");
+    CHECK(evaluate("2**64 and 1")->to_string() == "1");
+    CHECK(evaluate("(1 - 2) ** (2**70 + 1)")->to_string() == "-1");
+    CHECK(evaluate("2 ** -1")->to_string() == "0");
+    CHECK_THROWS_AS(execute("2**64 / 0"), ArithmeticError);
+    CHECK_THROWS_AS(execute("2**64 % (5 - 5)"), ArithmeticError);
+    CHECK_THROWS_AS(execute("3 ** (2**64)"), TypeOverflowError); // way too big
+  }
+
   SCENARIO("mathematical operation without parenthesis") {
     CHECK(compare_actual_value<IntegerValue>("5 * 2 -2 / 2", 9));
   }
@@ -284,6 +338,13 @@ DOCTEST_TEST_SUITE("Interpreter") {
     CHECK((compare_actual_value<StringValue, string>("3+'hello'", "3hello")));
     CHECK((compare_actual_value<StringValue, string>("'hello'+3.14", "hello3.14")));
     CHECK((compare_actual_value<StringValue, string>(R"('c\'est'+' \'ouf\'')", "c'est 'ouf'")));
+    CHECK((compare_actual_value<StringValue, string>("'a' + 1 + true + 2.5 + 'c'", "a112.5c")));
+    CHECK((compare_actual_value<StringValue, string>("'a' + 1 + 2", "a12")));
+
+    execute("store age as int = 24\nstore name as string = 'Tom'");
+    CHECK((compare_actual_value<StringValue, string>(R"("I'm $age years old")", "I'm 24 years old", false)));
+    CHECK((compare_actual_value<StringValue, string>(R"("$name$name, \$name" + 1)", "TomTom, $name1", false)));
+    CHECK_THROWS_AS(execute(R"("$undefined_variable")"), RuntimeError);
 
     CHECK((compare_actual_value<StringValue, string>("'hello'*2", "hellohello")));
     CHECK((compare_actual_value<StringValue, string>("2*'hello'", "hellohello")));
@@ -300,6 +361,13 @@ DOCTEST_TEST_SUITE("Interpreter") {
     CHECK_THROWS_AS(execute(R"("hello"*-1)"), RuntimeError); // invalid operation
     CHECK_THROWS_AS(execute(R"("hello"*2.45)"), RuntimeError); // invalid operation
     CHECK_THROWS_AS(execute(R"("hello"*-3.14)"), RuntimeError); // invalid operation
+    CHECK_THROWS_AS(execute(R"("hello"*(2**40))"), TypeOverflowError); // way too long
+    CHECK_THROWS_AS(execute(R"(9223372036854775807*"ab")"), TypeOverflowError);
+    CHECK_THROWS_AS(execute(R"("ab"*(2**70))"), TypeOverflowError);
+    CHECK_THROWS_AS(execute(R"((2**70)*"ab")"), TypeOverflowError);
+    CHECK_THROWS_AS(execute(R"("ab"*(-(2**70)))"), RuntimeError);
+    CHECK(get_custom_value_from<StringValue>(R"(""*(2**70))")->get_actual_value().empty());
+    CHECK(get_custom_value_from<StringValue>(R"("ab"*(2**70 - 2**70 + 2))")->get_actual_value() == "abab");
   }
 
   SCENARIO("unclosed string") {
@@ -346,6 +414,24 @@ DOCTEST_TEST_SUITE("Interpreter") {
     CHECK_THROWS_AS(execute("5.0%0.0"), ArithmeticError);
   }
 
+  SCENARIO("illegal binary operations") {
+    CHECK_THROWS_AS(execute("'a'-'b'"), RuntimeError);
+    CHECK_THROWS_AS(execute("5-'a'"), RuntimeError);
+    CHECK_THROWS_AS(execute("'a'/2"), RuntimeError);
+    CHECK_THROWS_AS(execute("2%'a'"), RuntimeError);
+    CHECK_THROWS_AS(execute("'a'**2"), RuntimeError);
+    CHECK_THROWS_AS(execute("'a'*'b'"), RuntimeError);
+    CHECK_THROWS_AS(execute("2.5*'a'"), RuntimeError);
+  }
+
+  SCENARIO("binary operations mixing booleans and strings") {
+    // the boolean is considered as an integer
+    CHECK((compare_actual_value<StringValue, string>("'a'+true", "a1")));
+    CHECK((compare_actual_value<StringValue, string>("false+'a'", "0a")));
+    CHECK((compare_actual_value<StringValue, string>("true*'ab'", "ab")));
+    CHECK((compare_actual_value<StringValue, string>("'ab'*false", "")));
+  }
+
   SCENARIO("max integer in variable") {
     common_ctx->get_symbol_table()->clear();
     
@@ -357,9 +443,11 @@ DOCTEST_TEST_SUITE("Interpreter") {
     CHECK(common_ctx->get_symbol_table()->exists("b"));
     CHECK(cast_value<DoubleValue>(common_ctx->get_symbol_table()->get("b"))->get_actual_value() == numeric_limits<double>::max());
     
-    const string code = "store c as int = " + std::to_string(LONG_MAX);
-    CHECK_THROWS_AS(execute(code), TypeOverflowError);
-    CHECK(!common_ctx->get_symbol_table()->exists("c"));
+    const string code = "store c as int = 9223372036854775808"; // INT64_MAX + 1, a big integer
+    CHECK_NOTHROW(execute(code));
+    CHECK(common_ctx->get_symbol_table()->get("c")->to_string() == "9223372036854775808");
+    CHECK_NOTHROW(execute("c = 5"));
+    CHECK(common_ctx->get_symbol_table()->get("c")->get_type() == Type::INT);
 
     const string code2 = "store d as double = 179769313486231570814527423731704356798070567525844996598917476803157260780028538760589558632766878171540458953514382464234321326889464182768467546703537516986049910576551282076245490090389328944075868508455133942304583236903222948165808559332123348274797826204144723168738177180919299881250404026184124858368555555555.000000";
     CHECK_THROWS_AS(execute(code2), TypeOverflowError);
@@ -424,4 +512,126 @@ DOCTEST_TEST_SUITE("Interpreter") {
     const string code = "store a as int = (store b as int = 2) or (store c as int = 3)";
     CHECK(compare_actual_value<IntegerValue>(code, 2));
   }
+
+  SCENARIO("lists") {
+    CHECK(get_custom_value_from<ListValue>("[1, 2.5, 'a']")->to_string() == "[1, 2.5, a]");
+    CHECK(get_custom_value_from<ListValue>("[]")->size() == 0);
+
+    CHECK(compare_actual_value<IntegerValue>("sum([1, 2, 3])", 6));
+    CHECK(compare_actual_value<IntegerValue>("sum([])", 0));
+    CHECK(compare_actual_value<DoubleValue>("sum([1, 2.5, true])", 4.5));
+    CHECK(compare_actual_value<IntegerValue>("min([3, -1, 2])", -1));
+    CHECK(compare_actual_value<DoubleValue>("max([3, -1, 4.5])", 4.5));
+    CHECK(compare_actual_value<DoubleValue>("mean([1, 2])", 1.5));
+    CHECK(compare_actual_value<IntegerValue>("dot([1, 2, 3], [4, 5, 6])", 32));
+    CHECK(get_custom_value_from<BigIntValue>("sum([9223372036854775807, 1])")->to_string() == "9223372036854775808");
+    // The lists holding a big integer are folded element by element
+    CHECK(get_custom_value_from<BigIntValue>("sum([2**70, 1])")->to_string() == "1180591620717411303425");
+    CHECK(get_custom_value_from<BigIntValue>("max([1, 2**70, true])")->to_string() == "1180591620717411303424");
+    CHECK(compare_actual_value<IntegerValue>("min([2**70, -3, 1])", -3));
+    CHECK(get_custom_value_from<BigIntValue>("min([2**70, 2**71])")->to_string() == "1180591620717411303424");
+    CHECK(compare_actual_value<DoubleValue>("mean([2**70, 2**70])", 1180591620717411303424.0));
+    CHECK(get_custom_value_from<BigIntValue>("dot([2**70, 1], [2, 3])")->to_string() == "2361183241434822606851");
+    CHECK_THROWS_AS(execute("sum([2**70, 'a'])"), RuntimeError);
+
+    CHECK(get_custom_value_from<ListValue>("[1, 2] + [3, 4.5]")->to_string() == "[4, 6.5]");
+    CHECK(get_custom_value_from<ListValue>("[1, 2] * 3")->to_string() == "[3, 6]");
+    CHECK(get_custom_value_from<ListValue>("0.5 * [1, 2]")->to_string() == "[0.5, 1]");
+    CHECK(get_custom_value_from<ListValue>("true * [1, 2]")->to_string() == "[1, 2]");
+    // The elements that aren't native numbers are combined one by one
+    CHECK(get_custom_value_from<ListValue>("[9223372036854775807] + [1]")->to_string() == "[9223372036854775808]");
+    CHECK(get_custom_value_from<ListValue>("[1, 2] * (2**64)")->to_string() == "[18446744073709551616, 36893488147419103232]");
+    CHECK(get_custom_value_from<ListValue>("['a', 'b'] * 2")->to_string() == "[aa, bb]");
+
+    execute("store numbers as list = [1, 2, 3]");
+    CHECK(compare_actual_value<IntegerValue>("sum(numbers * 2)", 12, false));
+    CHECK(compare_actual_value<IntegerValue>("dot(numbers, numbers + numbers)", 28, false));
+
+    CHECK_THROWS_AS(execute("sum(5)"), TypeError);
+    CHECK_THROWS_AS(execute("sum(['a'])"), RuntimeError);
+    CHECK_THROWS_AS(execute("min([])"), RuntimeError);
+    CHECK_THROWS_AS(execute("dot([1], [1, 2])"), RuntimeError);
+    CHECK_THROWS_AS(execute("[1] + [1, 2]"), RuntimeError);
+    CHECK_THROWS_AS(execute("[1] - [1]"), RuntimeError);
+    CHECK_THROWS_AS(execute("[1] * 'a'"), RuntimeError);
+  }
+
+  SCENARIO("elements and slices of lists") {
+    CHECK(compare_actual_value<IntegerValue>("[1, 2, 3][1]", 2));
+    CHECK(get_custom_value_from<StringValue>("[1, 'a'][2 - 1]")->to_string() == "a");
+    CHECK(get_custom_value_from<ListValue>("[1, 2, 3, 4][1:3]")->to_string() == "[2, 3]");
+    CHECK(get_custom_value_from<ListValue>("[1, 2, 3, 4][1:3][1:5]")->to_string() == "[3]");
+    CHECK(compare_actual_value<IntegerValue>("[1, 2, 3, 4][1:3][0]", 2));
+    // The bounds of a slice are clamped
+    CHECK(get_custom_value_from<ListValue>("[1, 2, 3][1:100]")->to_string() == "[2, 3]");
+    CHECK(get_custom_value_from<ListValue>("[1, 2, 3][2:1]")->size() == 0);
+    CHECK(get_custom_value_from<ListValue>("[1, 2, 3][1:3]")->is_slice());
+
+    common_ctx->get_symbol_table()->clear();
+    execute("store numbers as list = [1, 2, 3, 4]");
+    execute("store middle as list = numbers[1:3]");
+    CHECK(compare_actual_value<IntegerValue>("numbers[0] = 5", 5, false));
+    CHECK(get_custom_value_from<ListValue>("numbers", false)->to_string() == "[5, 2, 3, 4]");
+    CHECK(get_custom_value_from<ListValue>("middle", false)->to_string() == "[2, 3]"); // the slice is left untouched
+    CHECK(compare_actual_value<IntegerValue>("middle[1] = numbers[0] * 2", 10, false));
+    CHECK(get_custom_value_from<ListValue>("middle", false)->to_string() == "[2, 10]");
+    CHECK(!get_custom_value_from<ListValue>("middle", false)->is_slice());
+    CHECK(compare_actual_value<IntegerValue>("sum(numbers[1:4])", 9, false));
+
+    CHECK_THROWS_AS(execute("5[0]"), TypeError);
+    CHECK_THROWS_AS(execute("numbers['a']"), TypeError);
+    CHECK_THROWS_AS(execute("numbers[4]"), RuntimeError);
+    CHECK_THROWS_AS(execute("numbers[-1]"), RuntimeError);
+    CHECK_THROWS_AS(execute("numbers[-1:2]"), RuntimeError);
+    CHECK_THROWS_AS(execute("numbers[10] = 1"), RuntimeError);
+    CHECK_THROWS_AS(execute("unknown[0] = 1"), RuntimeError);
+    execute("define constant as list = [1]");
+    CHECK_THROWS_AS(execute("constant[0] = 2"), TypeError);
+  }
+
+  SCENARIO("dictionaries") {
+    CHECK(get_custom_value_from<DictionaryValue>("{'a': 1, 'b': [1, 2]}")->to_string() == "{a: 1, b: [1, 2]}");
+    CHECK(get_custom_value_from<DictionaryValue>("{}")->size() == 0);
+    CHECK(compare_actual_value<IntegerValue>("{'a': 1, 'b': 2}['b']", 2));
+    CHECK(compare_actual_value<IntegerValue>("{'a': [1, 2]}['a'][1]", 2));
+
+    common_ctx->get_symbol_table()->clear();
+    execute("store ages as dict = {'Thomas': 24}");
+    execute("store copy as dict = ages");
+    CHECK(compare_actual_value<IntegerValue>("ages['Thomas'] = 25", 25, false));
+    CHECK(compare_actual_value<IntegerValue>("ages['Bob'] = ages['Thomas'] * 2", 50, false));
+    CHECK(get_custom_value_from<DictionaryValue>("ages", false)->to_string() == "{Thomas: 25, Bob: 50}");
+    CHECK(get_custom_value_from<DictionaryValue>("copy", false)->to_string() == "{Thomas: 24}");
+    execute("copy['self'] = copy");
+    CHECK(get_custom_value_from<DictionaryValue>("copy", false)->to_string() == "{Thomas: 24, self: {Thomas: 24}}");
+    CHECK(compare_actual_value<IntegerValue>("store size as int = ages", 2, false));
+
+    CHECK_THROWS_AS(execute("{1: 'a'}"), TypeError);
+    CHECK_THROWS_AS(execute("ages[0]"), TypeError);
+    CHECK_THROWS_AS(execute("ages['unknown']"), RuntimeError);
+    CHECK_THROWS_AS(execute("ages[0:1]"), TypeError);
+    CHECK_THROWS_AS(execute("ages[true] = 1"), TypeError);
+    CHECK_THROWS_AS(execute("ages + ages"), RuntimeError);
+    CHECK_THROWS_AS(execute("store d as dict"), RuntimeError);
+  }
+
+  SCENARIO("executing the same tree several times") {
+    const string code = "store a as int = 5\na = a * 2 + 1\n'a' + a";
+    READ_FILES.insert({ "<stdin>", make_shared<string>(code) });
+    Parser parser = Parser::initCLI(code);
+    const unique_ptr<ListNode> tree = parser.parse();
+    const string representation = tree->to_string();
+
+    for (int i = 0; i < 3; ++i) {
+      // the variable "a" is declared again in each new context
+      Interpreter::set_shared_ctx(make_shared<Context>("<tests>"));
+      const RuntimeResult result = Interpreter::visit(*tree);
+      const list_of_values_view values = static_cast<const ListValue*>(result.get_value())->get_elements();
+      CHECK(values.back()->to_string() == "a11");
+    }
+
+    // The tree is left intact
+    CHECK(tree->to_string() == representation);
+    Interpreter::set_shared_ctx(common_ctx);
+  }
 }
\ No newline at end of file
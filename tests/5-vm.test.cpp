@@ -0,0 +1,252 @@
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <list>
+#include "doctest.h"
+#include "../include/parser.hpp"
+#include "../include/interpreter.hpp"
+#include "../include/run.hpp"
+#include "../include/symbol_table.hpp"
+#include "../include/values/compositer.hpp"
+#include "../include/vm/bytecode_compiler.hpp"
+#include "../include/vm/vm.hpp"
+#include "../include/vm/register_compiler.hpp"
+#include "../include/vm/register_vm.hpp"
+#include "../include/exceptions/custom_error.hpp"
+#include "../include/exceptions/runtime_error.hpp"
+#include "../include/exceptions/type_overflow_error.hpp"
+using namespace std;
+
+/// @brief Executes the given code in a new context with the chosen engine,
+/// and describes what happened: the type and the value of each statement,
+/// or the error that was thrown.
+/// Two engines are equivalent if they give the same description for the same code.
+/// @param code The code to execute.
+/// @param engine The engine executing the code.
+/// @return The description of the execution.
+string describe_execution(const string& code, Engine::Type engine) {
+  const shared_ptr<Context> ctx = make_shared<Context>("<tests>");
+  READ_FILES["<stdin>"] = make_shared<string>(code);
+  try {
+    Parser parser = Parser::initCLI(code);
+    unique_ptr<ListNode> tree = parser.parse();
+    RuntimeResult result;
+    if (engine == Engine::VM) {
+      result = VirtualMachine::run(BytecodeCompiler::compile(move(tree)), ctx);
+    } else if (engine == Engine::REGISTER_VM) {
+      result = RegisterVirtualMachine::run(RegisterCompiler::compile(move(tree)), ctx);
+    } else {
+      Interpreter::set_shared_ctx(ctx);
+      result = Interpreter::visit(move(tree));
+    }
+    string description;
+    for (const auto& element : static_cast<const ListValue*>(result.get_value())->get_elements()) {
+      description += get_type_name(element->get_type()) + " " + element->to_string() + "\n";
+    }
+    return description;
+  } catch (CustomError& e) {
+    return e.to_string();
+  }
+}
+
+/// @brief Checks that both virtual machines and the interpreter produce the same result.
+bool same_as_interpreter(const string& code) {
+  const string expected = describe_execution(code, Engine::TREE_WALKER);
+  return describe_execution(code, Engine::VM) == expected && describe_execution(code, Engine::REGISTER_VM) == expected;
+}
+
+DOCTEST_TEST_SUITE("Virtual Machine") {
+  SCENARIO("same values as the interpreter") {
+    const list<string> snippets = {
+      "\n\n", "5", "+5", "-5", "3.14", "-3.14", "+3.14",
+      "5+2", "10-5", "2*2", "10**2", "10/3", "-10/3", "-10%3", "10%-3", "-10**2", "5+-2",
+      "(-2.5 * 2 / -5.0) * 10 ** 2", "5 * (2 - 2) / 2", "5 * 2 -2 / 2",
+      "0.1+0.2", "1+0.2", "2.5*0.1", "10**2.0", "10.0**-2.0", "5.0%-2.0", "2.0/2",
+      "true", "false", "true+true", "true-false", "true*2", "true/2", "true%2", "true**2",
+      "'hello'", "'a'+'b'", "'hello'+3", "'hello'+3.14", "3+'hello'", "'hello'+true", "'hello'*2", "2*'hello'", "'hello'*0",
+      "\"hello \" + 'world'", "('c\\'est'+' \\'ouf\\'')",
+      "not true", "!false", "!!(false)", "true and true", "true and false", "false and true", "5 and 'a'",
+      "true or false", "false or false", "0 or 5", "0 or ''", "'' or 0",
+      "store a as int = 5\na\n", "store b as int", "store c as int = 5.6", "store a as double = 5",
+      "store c as double", "store a as string", "store a as string = 5",
+      "define a as int = 5", "define b as int = 5.5",
+      "store a as int = 5\na = 6\na", "store a as int = 5\nstore b as int = 10\na = b\na+b",
+      "store a as int = 5\na = 3.9", "store a as double = 1\na = 5",
+      "0 and (store a as int = 5)", "store a as int = (store b as int = 2) or (store c as int = 3)",
+      "store a as int = 1 and (a = 8)",
+      "5+5\n6+7\n", "store a as int = 5\na+5\n-a\n+a\nnot a",
+      "store c as int = 9223372036854775808", "9223372036854775807 + 1", "4611686018427387904 * 2",
+      "-(-9223372036854775807 - 1)", "554**23", "3**39", "3**40", "(-2)**63", "2**63", "0**0", "(-1)**7", "2**64 - 2**64", "-(2**64) % 7", "2**64 + 0.5",
+      "'a' + 1 + true + 2.5 + 'c'", "store a as int = 5\n'a' + a + 'b' + (a + 1)", "'a' + 2 * 3 + 'b' + 2**64",
+      "[1, 2.5, 'a']", "[]", "sum([1, 2, 3])", "dot([1, 2], [3, 4.5])", "mean([1, 2])", "min([3, -1])", "max([true, 0])",
+      "[1, 2] + [3, 4]", "2 * [1, 2] * 0.5", "sum([9223372036854775807, 1])", "store a as list = [1, 2]\nmax(a + a)",
+      "[1, 2, 3][1]", "[1, 2, 3, 4][1:3]", "[1, 2, 3][2:1]", "[1, 2, 3, 4][1:10][0:2][1]",
+      "store a as list = [1, 2, 3]\nstore b as list = a[0:2]\na[0] = 5\na + b", "store a as list = [1, 'a']\na[1] = a[0] * 2\na",
+      "{'a': 1, 'b': 'c', 'a': 2}", "{}", "{'a': [1, 2]}['a'][0]", "store d as dict = {'x': 1}\nd['y'] = d['x'] + 1\nd",
+      "store age as int = 24\n\"I'm $age years old\"", "store a as double = 2.5\n\"$a$a\" + true", "\"$ \\$a\"",
+    };
+    for (const auto& snippet : snippets) {
+      INFO(snippet);
+      CHECK(same_as_interpreter(snippet));
+    }
+  }
+
+  SCENARIO("same errors as the interpreter") {
+    const list<string> snippets = {
+      "5/0", "5%0", "5.0/0.0", "5/0.0", "5.0%0",
+      "'hello'*-1", "'hello'-2", "-'hello'", "+'hello'", "'a'/'b'",
+      "a", "a = 5", "store a as zzz", "store a as int = 4\nstore a as int = 1",
+      "store a as double = 'hello'", "store a as bool",
+      "define a as int = 5\na = 6", "define a as int = 5\ndefine a as int = 6",
+      "5\nstore c as double = 1" + string(400, '0') + ".0", "2**64 / 0", "3 ** (2**64)",
+      "true and (b = 5)", "false or (b = 5)", "\"hello $b\"", "'ab' * (2**40)", "(2**62) * 'ab'",
+      "sum(5)", "min([])", "sum(['a'])", "[1] + [1, 2]", "dot([1], [])",
+      "{1: 2}", "{'a': 1}['b']", "{'a': 1}[0]", "store d as dict = {}\nd[1] = 2",
+      "5[0]", "[1]['a']", "[1][1]", "[1][-1:1]", "a[0] = 1", "store a as list = [1]\na[1] = 2", "define a as list = [1]\na[0] = (b = 2)",
+    };
+    for (const auto& snippet : snippets) {
+      INFO(snippet);
+      CHECK(same_as_interpreter(snippet));
+    }
+  }
+
+  SCENARIO("errors are thrown after the previous statements") {
+    const shared_ptr<Context> ctx = make_shared<Context>("<tests>");
+    const string code = "store a as int = 5\nstore b as double = 1" + string(400, '0') + ".0";
+    READ_FILES["<stdin>"] = make_shared<string>(code);
+    const Chunk chunk = BytecodeCompiler::compile(Parser::initCLI(code).parse());
+    CHECK_THROWS_AS(VirtualMachine::run(chunk, ctx), TypeOverflowError);
+    CHECK(ctx->get_symbol_table()->exists("a"));
+    CHECK(!ctx->get_symbol_table()->exists("b"));
+  }
+
+  SCENARIO("bytecode") {
+    const Chunk concatenation = BytecodeCompiler::compile(Parser::initCLI("'a' + 5").parse());
+    CHECK(concatenation.code.size() == 5);
+    CHECK(concatenation.code[2].op == OpCode::CONCAT);
+    CHECK(concatenation.code[3].op == OpCode::MAKE_LIST);
+    CHECK(concatenation.code[4].op == OpCode::HALT);
+    CHECK(concatenation.constants.size() == 2);
+    CHECK(concatenation.spans.size() == concatenation.code.size());
+
+    const Chunk join = BytecodeCompiler::compile(Parser::initCLI("'a' + 5 + 'b'").parse());
+    CHECK(join.code[3].op == OpCode::JOIN);
+    CHECK(join.code[3].arg == 3);
+
+    const Chunk call = BytecodeCompiler::compile(Parser::initCLI("dot(a, b)").parse());
+    CHECK(call.code[2].op == OpCode::CALL);
+    CHECK(call.code[2].arg == Builtin::DOT);
+
+    // The new element is evaluated after the verification of the variable
+    const Chunk assignment = BytecodeCompiler::compile(Parser::initCLI("a[0] = 1").parse());
+    CHECK(assignment.code[0].op == OpCode::CHECK_STORE);
+    CHECK(assignment.code[3].op == OpCode::STORE_ELEMENT);
+    CHECK(assignment.code[3].arg == assignment.code[0].arg);
+
+    const Chunk addition = BytecodeCompiler::compile(Parser::initCLI("5 + 'a'").parse());
+    CHECK(addition.code[2].op == OpCode::ADD);
+
+    const Chunk short_circuit = BytecodeCompiler::compile(Parser::initCLI("a and b").parse());
+    CHECK(short_circuit.code[1].op == OpCode::AND_JUMP);
+    CHECK(short_circuit.code[1].arg == 4); // just after TO_BOOLEAN
+    CHECK(short_circuit.code[3].op == OpCode::TO_BOOLEAN);
+
+    const Chunk variables = BytecodeCompiler::compile(Parser::initCLI("store a as int = 5\na = a + 1\na").parse());
+    CHECK(variables.names.size() == 1);
+    CHECK(variables.declarations.size() == 1);
+  }
+
+  SCENARIO("three-address bytecode") {
+    // The literals are read from the table of constants directly
+    const RegisterChunk arithmetic = RegisterCompiler::compile(Parser::initCLI("5 + 6 * 2").parse());
+    CHECK(arithmetic.code.size() == 4); // MULTIPLY, ADD, MAKE_LIST, HALT
+    CHECK(arithmetic.code[0].op == RegOpCode::MULTIPLY);
+    CHECK((arithmetic.code[0].b & RK_CONSTANT) != 0);
+    CHECK((arithmetic.code[0].c & RK_CONSTANT) != 0);
+    CHECK(arithmetic.code[1].op == RegOpCode::ADD);
+    CHECK((arithmetic.code[1].b & RK_CONSTANT) != 0);
+    CHECK(arithmetic.code[1].c == arithmetic.code[0].a);
+    CHECK(arithmetic.code[2].op == RegOpCode::MAKE_LIST);
+    CHECK(arithmetic.code[2].c == 1);
+
+    // The stack-based bytecode needs more instructions for the same program
+    const Chunk stack_arithmetic = BytecodeCompiler::compile(Parser::initCLI("5 + 6 * 2").parse());
+    CHECK(stack_arithmetic.code.size() == 7);
+
+    const RegisterChunk short_circuit = RegisterCompiler::compile(Parser::initCLI("a or b").parse());
+    CHECK(short_circuit.code[1].op == RegOpCode::OR_JUMP);
+    CHECK(short_circuit.code[1].a == short_circuit.code[0].a);
+    CHECK(short_circuit.code[1].b == 4); // just after COPY
+    CHECK(short_circuit.code[3].op == RegOpCode::COPY);
+
+    // The arguments of a call are in consecutive registers
+    const RegisterChunk call = RegisterCompiler::compile(Parser::initCLI("dot(a, b)").parse());
+    CHECK(call.code[2].op == RegOpCode::CALL);
+    CHECK(call.code[2].b == call.code[0].a);
+    CHECK(call.code[2].b + 1 == call.code[1].a);
+    CHECK(call.code[2].c == Builtin::DOT);
+
+    // The keys and the values of a dictionary are in consecutive registers
+    const RegisterChunk dictionary = RegisterCompiler::compile(Parser::initCLI("{'a': b, 'c': d}").parse());
+    const three_address_t& make_dict = dictionary.code[dictionary.code.size() - 3]; // followed by MAKE_LIST and HALT
+    CHECK(make_dict.op == RegOpCode::MAKE_DICT);
+    CHECK(make_dict.c == 2);
+    CHECK(make_dict.b == dictionary.code[0].a);
+
+    // The index of an element can be a constant
+    const RegisterChunk index = RegisterCompiler::compile(Parser::initCLI("a[0]").parse());
+    CHECK(index.code[1].op == RegOpCode::INDEX);
+    CHECK(index.code[1].b == index.code[0].a);
+    CHECK((index.code[1].c & RK_CONSTANT) != 0);
+
+    // The registers of the statements are consecutive, and the temporary registers are reused
+    const RegisterChunk statements = RegisterCompiler::compile(Parser::initCLI("1+2+3\n4+5+6").parse());
+    CHECK(statements.number_of_registers == 4);
+  }
+
+  SCENARIO("the same chunk in different contexts") {
+    const string code = "store a as int = 5\na = a * 2";
+    READ_FILES["<stdin>"] = make_shared<string>(code);
+    const Chunk chunk = BytecodeCompiler::compile(Parser::initCLI(code).parse());
+    const shared_ptr<Context> first = make_shared<Context>("<first>");
+    const shared_ptr<Context> second = make_shared<Context>("<second>");
+    VirtualMachine::run(chunk, first);
+    VirtualMachine::run(chunk, second);
+    CHECK(cast_value<IntegerValue>(first->get_symbol_table()->get("a"))->get_actual_value() == 10);
+    CHECK(cast_value<IntegerValue>(second->get_symbol_table()->get("a"))->get_actual_value() == 10);
+    CHECK_THROWS_AS(VirtualMachine::run(chunk, first), RuntimeError); // "a" already exists
+  }
+
+  SCENARIO("run with the VM engine") {
+    const shared_ptr<Context> ctx = make_shared<Context>("<tests>");
+    unique_ptr<const RuntimeResult> res = runLine("5+5", ctx, Engine::VM);
+    CHECK(res != nullptr);
+    CHECK(res->get_error() == nullptr);
+    auto elements = static_cast<const ListValue*>(res->get_value())->get_elements();
+    CHECK(cast_const_value<IntegerValue>(elements.front())->get_actual_value() == 10);
+
+    const char* test_filename = "tests_runfile_vm.bk";
+    ofstream file = ofstream(test_filename);
+    CHECK(file.is_open());
+    file << "store a as int = 6\na+6";
+    file.close();
+
+    unique_ptr<const RuntimeResult> file_res = runFile(test_filename, ctx, Engine::VM);
+    CHECK(file_res != nullptr);
+    auto file_elements = static_cast<const ListValue*>(file_res->get_value())->get_elements();
+    CHECK(cast_const_value<IntegerValue>(file_elements.back())->get_actual_value() == 12);
+
+    remove(test_filename);
+  }
+
+  SCENARIO("engine names") {
+    Engine::Type engine = Engine::TREE_WALKER;
+    CHECK(get_engine_from_name("vm", engine));
+    CHECK(engine == Engine::VM);
+    CHECK(get_engine_from_name("tree", engine));
+    CHECK(engine == Engine::TREE_WALKER);
+    CHECK(get_engine_from_name("regvm", engine));
+    CHECK(engine == Engine::REGISTER_VM);
+    CHECK(!get_engine_from_name("jit", engine));
+  }
+}
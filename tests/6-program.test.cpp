@@ -0,0 +1,109 @@
+#include <thread>
+#include <vector>
+#include <optional>
+#include "doctest.h"
+#include "../include/program.hpp"
+#include "../include/values/compositer.hpp"
+#include "../include/exceptions/exception.hpp"
+#include "../include/exceptions/runtime_error.hpp"
+#include "../include/exceptions/type_error.hpp"
+using namespace std;
+
+DOCTEST_TEST_SUITE("Program") {
+  SCENARIO("binding variables") {
+    Program prog = bk::compile("age * 2 + 1");
+    prog.bind("age", 19);
+    CHECK(prog.eval()->to_string() == "39");
+    prog.bind("age", 20);
+    CHECK(prog.eval()->to_string() == "41");
+    prog.bind("age", 1.5);
+    CHECK(prog.eval()->to_string() == "4");
+    prog.bind("unused", 5); // does nothing
+    CHECK(prog.eval()->to_string() == "4");
+
+    Program greeting = bk::compile("'hello ' + name");
+    greeting.bind("name", "world");
+    CHECK(greeting.eval()->to_string() == "hello world");
+  }
+
+  SCENARIO("unbound variables") {
+    Program prog = bk::compile("age + 1");
+    CHECK_THROWS_AS(prog.eval(), RuntimeError);
+    prog.bind("age", 1);
+    CHECK(prog.eval()->to_string() == "2");
+    prog.unbind_all();
+    CHECK_THROWS_AS(prog.eval(), RuntimeError);
+  }
+
+  SCENARIO("declaring variables in a program") {
+    // The variables declared by an evaluation are forgotten by the next one
+    Program prog = bk::compile("store total as int = price * 2\ntotal + 1");
+    prog.bind("price", 5);
+    CHECK(prog.eval()->to_string() == "11");
+    prog.bind("price", 6);
+    CHECK(prog.eval()->to_string() == "13");
+
+    // A variable assigned by the program cannot be bound
+    CHECK_THROWS_AS(prog.bind("total", 1), Exception);
+
+    Program modification = bk::compile("price = 5");
+    CHECK_THROWS_AS(modification.bind("price", 1), Exception);
+    Program definition = bk::compile("price + 1\ndefine price as int = 5");
+    CHECK_THROWS_AS(definition.bind("price", 1), Exception);
+    Program element_assignment = bk::compile("l[0] = 5\nl");
+    CHECK_THROWS_AS(element_assignment.bind("l", make_unique<ListValue>(list_of_values_ptr{ make_shared<IntegerValue>(1) })), Exception);
+  }
+
+  SCENARIO("errors show the source code of their program") {
+    Program a = bk::compile("age + 1");
+    Program b = bk::compile("some_other_program * 1000");
+    string message;
+    try {
+      a.eval();
+    } catch (const RuntimeError& e) {
+      message = e.to_string();
+    }
+    CHECK(message.find("Undefined variable 'age'") != string::npos);
+    CHECK(message.find("age + 1") != string::npos);
+    CHECK(message.find("some_other_program") == string::npos);
+
+    // The error keeps the source code even after its program is destroyed
+    optional<RuntimeError> error;
+    {
+      Program c = bk::compile("unknown");
+      try {
+        c.eval();
+      } catch (const RuntimeError& e) {
+        error.emplace(e);
+      }
+    }
+    REQUIRE(error.has_value());
+    CHECK(error->to_string().find("unknown\n^^^^^^^") != string::npos);
+  }
+
+  SCENARIO("empty program") {
+    Program prog = bk::compile("");
+    CHECK(prog.eval() == nullptr);
+  }
+
+  SCENARIO("evaluating from several threads") {
+    const Program prog = bk::compile("x * x");
+    vector<int> results(4);
+    vector<thread> threads;
+    for (int i = 0; i < 4; ++i) {
+      threads.emplace_back([&prog, &results, i]() {
+        Program copy = prog; // shares the compiled code, but not the bindings
+        int sum = 0;
+        for (int x = 0; x < 1000; ++x) {
+          copy.bind("x", i);
+          sum += static_cast<const IntegerValue&>(*copy.eval()).get_actual_value();
+        }
+        results[i] = sum;
+      });
+    }
+    for (auto& t : threads) t.join();
+    for (int i = 0; i < 4; ++i) {
+      CHECK(results[i] == i * i * 1000);
+    }
+  }
+}
@@ -18,10 +18,10 @@ DOCTEST_TEST_SUITE("run method") {
     CHECK(*READ_FILES["<stdin>"] == input);
     CHECK(res->get_value() != nullptr);
     CHECK(res->get_error() == nullptr);
-    shared_ptr<Value> res_value = res->get_value();
-    shared_ptr<ListValue> list_value = cast_value<ListValue>(res_value);
+    const ListValue* list_value = dynamic_cast<const ListValue*>(res->get_value());
+    CHECK(list_value != nullptr);
 
-    list<shared_ptr<const Value>> elements = list_value->get_elements();
+    const list_of_values_view elements = list_value->get_elements();
     shared_ptr<const Value> front = elements.front();
     shared_ptr<const IntegerValue> integer = cast_const_value<IntegerValue>(front);
     CHECK(integer->get_actual_value() == 10);
@@ -41,10 +41,10 @@ DOCTEST_TEST_SUITE("run method") {
     CHECK(res != nullptr);
     CHECK(res->get_value() != nullptr);
     CHECK(res->get_error() == nullptr);
-    shared_ptr<Value> res_value = res->get_value();
-    shared_ptr<ListValue> list_value = cast_value<ListValue>(res_value);
+    const ListValue* list_value = dynamic_cast<const ListValue*>(res->get_value());
+    CHECK(list_value != nullptr);
 
-    list<shared_ptr<const Value>> elements = list_value->get_elements();
+    const list_of_values_view elements = list_value->get_elements();
     shared_ptr<const Value> front = elements.front();
     shared_ptr<const IntegerValue> integer = cast_const_value<IntegerValue>(front);
     CHECK(integer->get_actual_value() == 12);
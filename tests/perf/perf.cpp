@@ -1,6 +1,18 @@
 #include <iostream>
 #include <fstream>
+#include <chrono>
+#include <filesystem>
+#include <list>
+#include <cstdlib>
+#include <new>
+#include <numeric>
+#include <map>
+#include <unordered_map>
+#ifdef __APPLE__
 #include <mach/mach.h>
+#else
+#include <unistd.h>
+#endif
 #include "../../include/token.hpp"
 #include "../../include/lexer.hpp"
 #include "../../include/parser.hpp"
@@ -8,6 +20,16 @@
 #include "../../include/utils/read_entire_file.hpp"
 #include "../../include/nodes/compositer.hpp"
 #include "../../include/interpreter.hpp"
+#include "../../include/vm/bytecode_compiler.hpp"
+#include "../../include/vm/vm.hpp"
+#include "../../include/vm/register_compiler.hpp"
+#include "../../include/vm/register_vm.hpp"
+#include "../../include/values/value_pool.hpp"
+#include "../../include/batch/batch_evaluator.hpp"
+#include "../../include/program.hpp"
+#include "../../include/symbol_table.hpp"
+#include "../../include/values/list_operations.hpp"
+#include "../../include/utils/big_integer.hpp"
 #include "../../include/utils/double_to_string.hpp"
 using namespace std;
 
@@ -32,12 +54,27 @@ struct measurements_t {
   double memory;
 };
 
+// Every allocation of the program goes through these operators,
+// so that the number of allocations made by a specific part of the program can be measured.
+static size_t number_of_allocations = 0;
+
+void* operator new(size_t size) {
+  ++number_of_allocations;
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
+
 constexpr double treshold = 5.0; // above this amount of milliseconds, I consider that there is a performance issue.
 const string ANSI_RED = "\e[0;31m";
 const string ANSI_GREEN = "\e[0;32m";
 const string ANSI_RESET = "\e[0m";
 
-double get_milliseconds(const chrono::steady_clock::time_point& t1, const chrono::steady_clock::time_point& t2) {
+double get_milliseconds(const high_resolution_clock::time_point& t1, const high_resolution_clock::time_point& t2) {
   const duration<double, std::milli> ms_double = t2 - t1;
   return ms_double.count();
 }
@@ -87,12 +124,23 @@ nice_time_t get_localtime() {
 }
 
 size_t get_current_memory_usage() {
+#ifdef __APPLE__
   task_vm_info_data_t vmInfo;
   mach_msg_type_number_t infoCount = TASK_VM_INFO_COUNT;
   if (task_info(mach_task_self(), TASK_VM_INFO, (task_info_t)&vmInfo, &infoCount) == KERN_SUCCESS) {
     return vmInfo.phys_footprint;
   }
   return 0; // Failed to read memory usage
+#else
+  // On Linux, the second number of /proc/self/statm is the resident set size, in pages.
+  ifstream statm("/proc/self/statm");
+  size_t total_pages = 0;
+  size_t resident_pages = 0;
+  if (statm >> total_pages >> resident_pages) {
+    return resident_pages * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  }
+  return 0; // Failed to read memory usage
+#endif
 }
 
 measurements_t measure_lexer(const string& source_code, int* number_of_tokens) {
@@ -142,6 +190,498 @@ measurements_t measure_interpreter(const string& source_code) {
   return results;
 }
 
+measurements_t measure_vm(const string& source_code) {
+  const auto vm_musage1 = get_current_memory_usage();
+  const auto v1 = high_resolution_clock::now();
+  const shared_ptr<Context> ctx = make_shared<Context>("<perf>");
+  Parser parser = Parser::initCLI(source_code);
+  const Chunk chunk = BytecodeCompiler::compile(parser.parse());
+  VirtualMachine::run(chunk, ctx);
+  const auto v2 = high_resolution_clock::now();
+  const auto vm_musage2 = get_current_memory_usage();
+  measurements_t results{};
+  results.time = get_milliseconds(v1, v2);
+  results.memory = static_cast<double>(vm_musage2 - vm_musage1);
+  return results;
+}
+
+// The tree walker leaves the tree intact and the bytecode doesn't change once it's been compiled,
+// so all the engines reuse a single parse for all their executions.
+// They're measured on the execution alone (the parsing is excluded from the timer).
+measurements_t measure_tree_walker_executions(const string& source_code, const int iterations) {
+  Parser parser = Parser::initCLI(source_code);
+  const auto tree = parser.parse();
+  const auto t1 = high_resolution_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    const shared_ptr<Context> ctx = make_shared<Context>("<perf>");
+    Interpreter::set_shared_ctx(ctx);
+    Interpreter::visit(*tree);
+  }
+  const auto t2 = high_resolution_clock::now();
+  return measurements_t{get_milliseconds(t1, t2) / iterations, 0};
+}
+
+measurements_t measure_vm_executions(const string& source_code, const int iterations) {
+  Parser parser = Parser::initCLI(source_code);
+  const Chunk chunk = BytecodeCompiler::compile(parser.parse());
+  const auto t1 = high_resolution_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    const shared_ptr<Context> ctx = make_shared<Context>("<perf>");
+    VirtualMachine::run(chunk, ctx);
+  }
+  const auto t2 = high_resolution_clock::now();
+  return measurements_t{get_milliseconds(t1, t2) / iterations, 0};
+}
+
+measurements_t measure_register_vm_executions(const string& source_code, const int iterations) {
+  Parser parser = Parser::initCLI(source_code);
+  const RegisterChunk chunk = RegisterCompiler::compile(parser.parse());
+  const auto t1 = high_resolution_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    const shared_ptr<Context> ctx = make_shared<Context>("<perf>");
+    RegisterVirtualMachine::run(chunk, ctx);
+  }
+  const auto t2 = high_resolution_clock::now();
+  return measurements_t{get_milliseconds(t1, t2) / iterations, 0};
+}
+
+constexpr const char* batch_expression = "price * quantity - discount";
+
+/// @brief Measures how many rows per second the batch evaluation processes.
+double measure_batch_rows_per_second(const int rows) {
+  vector<double> prices(rows);
+  vector<int64_t> quantities(rows);
+  vector<double> discounts(rows);
+  for (int i = 0; i < rows; ++i) {
+    prices[i] = (i % 100) * 0.5;
+    quantities[i] = i % 7;
+    discounts[i] = i % 3;
+  }
+  BatchEvaluator evaluator(batch_expression);
+  evaluator.bind("price", make_shared<Column>(Column::from_doubles(move(prices))));
+  evaluator.bind("quantity", make_shared<Column>(Column::from_integers(move(quantities))));
+  evaluator.bind("discount", make_shared<Column>(Column::from_doubles(move(discounts))));
+  const auto t1 = high_resolution_clock::now();
+  const Column result = evaluator.eval();
+  const auto t2 = high_resolution_clock::now();
+  return result.size() / (get_milliseconds(t1, t2) / 1000);
+}
+
+/// @brief Measures how many rows per second a Program processes, when evaluated once per row.
+double measure_program_rows_per_second(const int rows) {
+  Program prog = bk::compile(batch_expression);
+  const auto t1 = high_resolution_clock::now();
+  for (int i = 0; i < rows; ++i) {
+    prog.bind("price", (i % 100) * 0.5);
+    prog.bind("quantity", i % 7);
+    prog.bind("discount", static_cast<double>(i % 3));
+    prog.eval();
+  }
+  const auto t2 = high_resolution_clock::now();
+  return rows / (get_milliseconds(t1, t2) / 1000);
+}
+
+/// @brief Measures the cost of detecting overflows in the integer operations.
+/// The unchecked multiplication goes through unsigned integers, so that overflowing isn't undefined behavior.
+/// @return The time in ms of the unchecked loop (first) and of the checked loop (second).
+pair<double, double> measure_checked_arithmetic(const int n) {
+  vector<int64_t> a(n);
+  vector<int64_t> b(n);
+  vector<int64_t> out(n);
+  for (int i = 0; i < n; ++i) {
+    a[i] = i * 7919;
+    b[i] = (i % 1000) - 500;
+  }
+  const auto t1 = high_resolution_clock::now();
+  for (int i = 0; i < n; ++i) {
+    out[i] = static_cast<int64_t>(static_cast<uint64_t>(a[i]) * static_cast<uint64_t>(b[i]) + static_cast<uint64_t>(b[i]));
+  }
+  const auto t2 = high_resolution_clock::now();
+  bool overflow = false;
+  for (int i = 0; i < n; ++i) {
+    int64_t product;
+    overflow |= __builtin_mul_overflow(a[i], b[i], &product);
+    overflow |= __builtin_add_overflow(product, b[i], &out[i]);
+  }
+  const auto t3 = high_resolution_clock::now();
+  if (overflow) cout << "Unexpected overflow" << endl;
+  return { get_milliseconds(t1, t2), get_milliseconds(t2, t3) };
+}
+
+/// @brief Measures the reads of a string variable of 1 MB, through the symbol table and through the interpreter.
+/// Reading a variable copies its value, which only shares the characters of the string.
+/// @return The time in ms of the reads from the symbol table (first) and from the interpreter (second).
+pair<double, double> measure_string_variable_reads(const int n) {
+  const shared_ptr<Context> ctx = make_shared<Context>("<perf>");
+  ctx->get_symbol_table()->set("s", make_unique<StringValue>(string(1 << 20, 'a')), false);
+  size_t total_length = 0;
+  const auto t1 = high_resolution_clock::now();
+  for (int i = 0; i < n; ++i) {
+    total_length += static_cast<const StringValue&>(*ctx->get_symbol_table()->get("s")).get_actual_value().length();
+  }
+  const auto t2 = high_resolution_clock::now();
+  const unique_ptr<ListNode> tree = Parser::initCLI("s").parse();
+  Interpreter::set_shared_ctx(ctx);
+  for (int i = 0; i < n; ++i) {
+    const RuntimeResult result = Interpreter::visit(*tree);
+    total_length += static_cast<const ListValue*>(result.get_value())->get_elements().size();
+  }
+  const auto t3 = high_resolution_clock::now();
+  if (total_length != static_cast<size_t>(n) * ((1 << 20) + 1)) cout << "Unexpected length" << endl;
+  return { get_milliseconds(t1, t2), get_milliseconds(t2, t3) };
+}
+
+/// @brief Measures `n` appends of a piece to a string (`s = s + piece`),
+/// with the ropes of StringValue and with flat strings copied by each concatenation.
+/// @return The time in ms of the flat appends (first) and of the rope appends, including the final flattening (second).
+pair<double, double> measure_string_appends(const int n) {
+  const string piece = "0123456789";
+  const auto t1 = high_resolution_clock::now();
+  string flat;
+  for (int i = 0; i < n; ++i) {
+    flat = flat + piece;
+  }
+  const auto t2 = high_resolution_clock::now();
+  unique_ptr<StringValue> rope = make_unique<StringValue>();
+  const StringValue piece_value(piece);
+  for (int i = 0; i < n; ++i) {
+    rope = unique_ptr<StringValue>(*rope + piece_value);
+  }
+  const size_t length = rope->get_actual_value().length();
+  const auto t3 = high_resolution_clock::now();
+  if (length != flat.length()) cout << "Unexpected length" << endl;
+  return { get_milliseconds(t1, t2), get_milliseconds(t2, t3) };
+}
+
+/// @brief Measures `n` concatenations of 10 values (a string followed by integers and strings, like `'a' + 1 + 'b' + ...`),
+/// evaluated pair by pair and all at once (see ConcatNode).
+/// @return The time in ms of the pairwise concatenations (first) and of the single concatenations (second).
+pair<double, double> measure_concatenation_chains(const int n) {
+  vector<unique_ptr<Value>> values;
+  values.push_back(make_unique<StringValue>("The answer is "));
+  for (int i = 0; i < 9; ++i) {
+    if (i % 2 == 0) values.push_back(make_unique<IntegerValue>(42 + i));
+    else values.push_back(make_unique<StringValue>(", or maybe "));
+  }
+  vector<const Value*> parts;
+  for (const auto& value : values) parts.push_back(value.get());
+  size_t pairwise_length = 0;
+  size_t single_length = 0;
+  const auto t1 = high_resolution_clock::now();
+  for (int i = 0; i < n; ++i) {
+    unique_ptr<StringValue> result = unique_ptr<StringValue>(static_cast<const StringValue&>(*values[0]) + *values[1]);
+    for (size_t j = 2; j < values.size(); ++j) {
+      result = unique_ptr<StringValue>(*result + *values[j]);
+    }
+    pairwise_length += result->get_actual_value().length();
+  }
+  const auto t2 = high_resolution_clock::now();
+  for (int i = 0; i < n; ++i) {
+    const unique_ptr<StringValue> result = unique_ptr<StringValue>(StringValue::concatenate(parts));
+    single_length += result->get_actual_value().length();
+  }
+  const auto t3 = high_resolution_clock::now();
+  if (pairwise_length != single_length) cout << "Unexpected length" << endl;
+  return { get_milliseconds(t1, t2), get_milliseconds(t2, t3) };
+}
+
+/// @brief Measures the memory taken by a list of `n` integers, unboxed and with a handle per element.
+/// @return The number of bytes per element of the unboxed list (first) and of the handles (second).
+pair<double, double> measure_list_memory(const int64_t n) {
+  const size_t memory1 = get_current_memory_usage();
+  vector<int64_t> integers(n);
+  for (int64_t i = 0; i < n; ++i) integers[i] = i;
+  const unique_ptr<ListValue> unboxed(ListValue::from_integers(move(integers)));
+  const size_t memory2 = get_current_memory_usage();
+  list_of_values_ptr handles;
+  handles.reserve(n);
+  for (int64_t i = 0; i < n; ++i) handles.push_back(make_shared<IntegerValue>(i));
+  const size_t memory3 = get_current_memory_usage();
+  const ListValue list_value(move(handles));
+  if (list_value.get_kind() != ListKind::INTEGERS || list_value.size() != unboxed->size()) cout << "Unexpected list" << endl;
+  return { static_cast<double>(memory2 - memory1) / n, static_cast<double>(memory3 - memory2) / n };
+}
+
+/// @brief Measures `iterations` times `sum(list * 2 + list)` on a list of `n` doubles,
+/// once element by element (like an interpreted loop would do) and once with the kernels of ListOperations.
+/// @return The time in ms of the per-element interpretation (first) and of the kernels (second).
+pair<double, double> measure_list_processing(const int64_t n, const int iterations) {
+  const shared_ptr<Context> ctx = make_shared<Context>("<perf>");
+  const Position pos = Position::getDefaultPos();
+  vector<double> doubles(n);
+  for (int64_t i = 0; i < n; ++i) doubles[i] = static_cast<double>(i % 1000) * 0.5;
+  const unique_ptr<ListValue> list(ListValue::from_doubles(move(doubles)));
+  const list_of_values_view elements = list->get_elements(); // boxed once, outside of the measurements
+  const IntegerValue two(2);
+  double per_element_total = 0;
+  double kernels_total = 0;
+  const auto t1 = high_resolution_clock::now();
+  for (int iteration = 0; iteration < iterations; ++iteration) {
+    unique_ptr<Value> total = make_unique<IntegerValue>(0);
+    for (const auto& element : elements) {
+      const unique_ptr<Value> doubled = Interpreter::interpret_binary_operation(NodeType::MULTIPLY, *element, two, pos, pos, ctx);
+      const unique_ptr<Value> added = Interpreter::interpret_binary_operation(NodeType::ADD, *doubled, *element, pos, pos, ctx);
+      total = Interpreter::interpret_binary_operation(NodeType::ADD, *total, *added, pos, pos, ctx);
+    }
+    per_element_total += static_cast<const DoubleValue&>(*total).get_actual_value();
+  }
+  const auto t2 = high_resolution_clock::now();
+  for (int iteration = 0; iteration < iterations; ++iteration) {
+    const unique_ptr<ListValue> doubled(ListOperations::multiply(*list, two));
+    const unique_ptr<ListValue> added(ListOperations::add(*doubled, *list));
+    const unique_ptr<Value> total(ListOperations::sum(*added));
+    kernels_total += static_cast<const DoubleValue&>(*total).get_actual_value();
+  }
+  const auto t3 = high_resolution_clock::now();
+  if (abs(per_element_total - kernels_total) > 1e-6 * abs(per_element_total)) cout << "Unexpected sum" << endl;
+  return { get_milliseconds(t1, t2), get_milliseconds(t2, t3) };
+}
+
+/// @brief Measures paging through a list of `n` integers, by pages of `page_size` elements,
+/// once by copying each page (like the lists did before the slices) and once with the slices (`list[a:b]`).
+/// Only the first element of each page is read, so that the measurements are the costs of taking the pages.
+/// @return The time in ms of the copies (first) and of the slices (second).
+pair<double, double> measure_list_slicing(const int64_t n, const int64_t page_size) {
+  const shared_ptr<Context> ctx = make_shared<Context>("<perf>");
+  const Position pos = Position::getDefaultPos();
+  vector<int64_t> integers(n);
+  iota(integers.begin(), integers.end(), 0);
+  const unique_ptr<ListValue> list(ListValue::from_integers(move(integers)));
+  int64_t copies_total = 0;
+  int64_t slices_total = 0;
+  const auto t1 = high_resolution_clock::now();
+  for (int64_t start = 0; start < n; start += page_size) {
+    const span<const int64_t> elements = list->get_integers().subspan(start, min(page_size, n - start));
+    const unique_ptr<ListValue> page(ListValue::from_integers(vector<int64_t>(elements.begin(), elements.end())));
+    copies_total += static_cast<const IntegerValue&>(*Interpreter::interpret_list_access(*page, IntegerValue(0), pos, pos, ctx)).get_actual_value();
+  }
+  const auto t2 = high_resolution_clock::now();
+  for (int64_t start = 0; start < n; start += page_size) {
+    const unique_ptr<Value> page = Interpreter::interpret_list_slice(*list, IntegerValue(start), IntegerValue(start + page_size), pos, pos, ctx);
+    slices_total += static_cast<const IntegerValue&>(*Interpreter::interpret_list_access(*page, IntegerValue(0), pos, pos, ctx)).get_actual_value();
+  }
+  const auto t3 = high_resolution_clock::now();
+  if (copies_total != slices_total) cout << "Unexpected element" << endl;
+  return { get_milliseconds(t1, t2), get_milliseconds(t2, t3) };
+}
+
+/// @brief Measures `updates` times `a[i] = a[i] + 1` at pseudo-random indices, `a` being a variable holding a list of `n` integers,
+/// once by copying all the elements for each update (like the lists did before the persistent vectors)
+/// and once with the interpreter, whose updates only copy a path of the trie.
+/// @return The time in ms of the copies (first) and of the persistent updates (second).
+pair<double, double> measure_list_updates(const int64_t n, const int updates) {
+  const shared_ptr<Context> ctx = make_shared<Context>("<perf>");
+  const Position pos = Position::getDefaultPos();
+  vector<int64_t> integers(n);
+  iota(integers.begin(), integers.end(), 0);
+  const IntegerValue one(1);
+  ctx->get_symbol_table()->set("a", unique_ptr<Value>(ListValue::from_integers(integers)), false);
+  ctx->get_symbol_table()->set("b", unique_ptr<Value>(ListValue::from_integers(move(integers))), false);
+  uint64_t seed = 42;
+  const auto t1 = high_resolution_clock::now();
+  for (int update = 0; update < updates; ++update) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    const int64_t i = static_cast<int64_t>((seed >> 33) % n);
+    const unique_ptr<Value> list = ctx->get_symbol_table()->get("a");
+    const unique_ptr<Value> element(static_cast<const ListValue&>(*list).get_element(i));
+    const unique_ptr<Value> incremented = Interpreter::interpret_binary_operation(NodeType::ADD, *element, one, pos, pos, ctx);
+    const span<const int64_t> elements = static_cast<const ListValue&>(*list).get_integers();
+    vector<int64_t> copy(elements.begin(), elements.end());
+    copy[i] = static_cast<const IntegerValue&>(*incremented).get_actual_value();
+    ctx->get_symbol_table()->modify("a", unique_ptr<Value>(ListValue::from_integers(move(copy))));
+  }
+  const auto t2 = high_resolution_clock::now();
+  seed = 42;
+  for (int update = 0; update < updates; ++update) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    const IntegerValue i(static_cast<int64_t>((seed >> 33) % n));
+    const unique_ptr<Value> element = Interpreter::interpret_list_access(*ctx->get_symbol_table()->get("b"), i, pos, pos, ctx);
+    const unique_ptr<Value> incremented = Interpreter::interpret_binary_operation(NodeType::ADD, *element, one, pos, pos, ctx);
+    Interpreter::assign_list_element("b", i, *incremented, pos, pos, ctx);
+  }
+  const auto t3 = high_resolution_clock::now();
+  if (ctx->get_symbol_table()->get("a")->to_string() != ctx->get_symbol_table()->get("b")->to_string()) cout << "Unexpected list" << endl;
+  return { get_milliseconds(t1, t2), get_milliseconds(t2, t3) };
+}
+
+/// @brief Measures `lookups` lookups of random keys (all of them existing) in a dictionary of `n` entries,
+/// once in a `std::unordered_map` and once in a DictionaryValue (a Swiss table).
+/// Both hash the key of each lookup.
+/// @return The time in ms of the `std::unordered_map` (first) and of the dictionary (second).
+pair<double, double> measure_dictionary_lookups(const int n, const int lookups) {
+  vector<string> keys;
+  vector<pair<string, shared_ptr<const Value>>> entries;
+  unordered_map<string, shared_ptr<const Value>> map;
+  for (int i = 0; i < n; ++i) {
+    keys.push_back("variable_" + to_string(i));
+    const shared_ptr<const Value> value = make_shared<IntegerValue>(i);
+    entries.emplace_back(keys.back(), value);
+    map.emplace(keys.back(), value);
+  }
+  const DictionaryValue dictionary(move(entries));
+  vector<const string*> random_keys;
+  uint64_t seed = 42;
+  for (int i = 0; i < lookups; ++i) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    random_keys.push_back(&keys[(seed >> 33) % n]);
+  }
+  int64_t map_total = 0;
+  int64_t dictionary_total = 0;
+  const auto t1 = high_resolution_clock::now();
+  for (const string* key : random_keys) {
+    map_total += static_cast<const IntegerValue&>(*map.find(*key)->second).get_actual_value();
+  }
+  const auto t2 = high_resolution_clock::now();
+  for (const string* key : random_keys) {
+    dictionary_total += static_cast<const IntegerValue*>(dictionary.get(*key))->get_actual_value();
+  }
+  const auto t3 = high_resolution_clock::now();
+  if (map_total != dictionary_total) cout << "Unexpected total" << endl;
+  return { get_milliseconds(t1, t2), get_milliseconds(t2, t3) };
+}
+
+/// @brief Measures filling a dictionary variable with `n` keys (`d[key] = i`),
+/// once by copying the entries for each new key (like the dictionaries did before modifying their storage in place)
+/// and once with the interpreter, which inserts the keys in place.
+/// @return The time in ms of the copies (first) and of the insertions in place (second).
+pair<double, double> measure_dictionary_fills(const int n) {
+  const shared_ptr<Context> ctx = make_shared<Context>("<perf>");
+  const Position pos = Position::getDefaultPos();
+  ctx->get_symbol_table()->set("a", make_unique<DictionaryValue>(), false);
+  ctx->get_symbol_table()->set("b", make_unique<DictionaryValue>(), false);
+  vector<StringValue> keys;
+  for (int i = 0; i < n; ++i) keys.emplace_back("key_" + to_string(i));
+  const auto t1 = high_resolution_clock::now();
+  for (int i = 0; i < n; ++i) {
+    const unique_ptr<Value> dictionary = ctx->get_symbol_table()->get("a");
+    ctx->get_symbol_table()->modify("a", unique_ptr<Value>(static_cast<const DictionaryValue&>(*dictionary).with_entry(keys[i].get_actual_value(), IntegerValue(i))));
+  }
+  const auto t2 = high_resolution_clock::now();
+  for (int i = 0; i < n; ++i) {
+    Interpreter::assign_list_element("b", keys[i], IntegerValue(i), pos, pos, ctx);
+  }
+  const auto t3 = high_resolution_clock::now();
+  if (ctx->get_symbol_table()->get("a")->to_string() != ctx->get_symbol_table()->get("b")->to_string()) cout << "Unexpected dictionary" << endl;
+  return { get_milliseconds(t1, t2), get_milliseconds(t2, t3) };
+}
+
+/// @brief Measures `accesses` reads of random global variables among `n` ones,
+/// once in a red-black tree of heap-allocated entries (checking the existence of the variable before reading it, like the former symbol table),
+/// and once in the SymbolTable (a flat hash table).
+/// @return The time in ms of the red-black tree (first) and of the SymbolTable (second).
+pair<double, double> measure_global_accesses(const int n, const int accesses) {
+  vector<string> names;
+  map<string, unique_ptr<SymbolTableEntry>> tree;
+  SymbolTable table;
+  for (int i = 0; i < n; ++i) {
+    names.push_back("global_" + to_string(i));
+    tree[names.back()] = make_unique<SymbolTableEntry>(make_unique<IntegerValue>(i), false);
+    table.set(names.back(), make_unique<IntegerValue>(i), false);
+  }
+  vector<const string*> random_names;
+  uint64_t seed = 42;
+  for (int i = 0; i < accesses; ++i) {
+    seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+    random_names.push_back(&names[(seed >> 33) % n]);
+  }
+  int64_t tree_total = 0;
+  int64_t table_total = 0;
+  const auto t1 = high_resolution_clock::now();
+  for (const string* name : random_names) {
+    if (tree.contains(*name)) {
+      const unique_ptr<Value> value(tree[*name]->get_copy());
+      tree_total += static_cast<const IntegerValue&>(*value).get_actual_value();
+    }
+  }
+  const auto t2 = high_resolution_clock::now();
+  for (const string* name : random_names) {
+    if (table.exists_globally(*name)) {
+      table_total += static_cast<const IntegerValue&>(*table.get(*name)).get_actual_value();
+    }
+  }
+  const auto t3 = high_resolution_clock::now();
+  if (tree_total != table_total) cout << "Unexpected total" << endl;
+  return { get_milliseconds(t1, t2), get_milliseconds(t2, t3) };
+}
+
+/// @brief Measures a repetition of "ab" `n` times, by appending the pattern `n` times and with StringValue (by doubling).
+/// @return The time in ms of the appends (first) and of the doubling repetition (second).
+pair<double, double> measure_string_repetition(const int64_t n) {
+  const auto t1 = high_resolution_clock::now();
+  string appended;
+  appended.reserve(2 * n);
+  for (int64_t i = 0; i < n; ++i) appended.append("ab");
+  const auto t2 = high_resolution_clock::now();
+  const unique_ptr<StringValue> repetition(StringValue("ab") * IntegerValue(n));
+  const auto t3 = high_resolution_clock::now();
+  if (repetition->get_actual_value() != appended) cout << "Unexpected repetition" << endl;
+  return { get_milliseconds(t1, t2), get_milliseconds(t2, t3) };
+}
+
+/// @brief Measures `n` evaluations of the same string by the interpreter:
+/// with an interpolation, with a chain of `+` (folded into the same ConcatNode),
+/// and with nested `+` (which still produce an intermediate string at each step).
+/// @return The time in ms of the interpolations, of the chains, and of the nested concatenations.
+tuple<double, double, double> measure_string_interpolations(const int n) {
+  const shared_ptr<Context> ctx = make_shared<Context>("<perf>");
+  ctx->get_symbol_table()->set("age", make_unique<IntegerValue>(24), false);
+  ctx->get_symbol_table()->set("name", make_unique<StringValue>("Thomas"), false);
+  ctx->get_symbol_table()->set("city", make_unique<StringValue>("Paris"), false);
+  Interpreter::set_shared_ctx(ctx);
+  const string sources[] = {
+    R"("I'm $name, I'm $age years old and I live in $city.")",
+    R"("I'm " + name + ", I'm " + age + " years old and I live in " + city + ".")",
+    R"("I'm " + (name + (", I'm " + (age + (" years old and I live in " + (city + "."))))))",
+  };
+  double times[3];
+  string results[3];
+  for (int k = 0; k < 3; ++k) {
+    const unique_ptr<ListNode> tree = Parser::initCLI(sources[k]).parse();
+    const auto t1 = high_resolution_clock::now();
+    for (int i = 0; i < n; ++i) {
+      const RuntimeResult result = Interpreter::visit(*tree);
+      if (i == 0) results[k] = static_cast<const ListValue*>(result.get_value())->get_elements().front()->to_string();
+    }
+    times[k] = get_milliseconds(t1, high_resolution_clock::now());
+  }
+  if (results[0] != results[1] || results[1] != results[2]) cout << "Unexpected interpolation" << endl;
+  return { times[0], times[1], times[2] };
+}
+
+/// @brief Measures the time in ms of `n` evaluations of a Program (used to compare the powers).
+double measure_program_evaluations(const string& source_code, const int n) {
+  Program prog = bk::compile(source_code);
+  const auto t1 = high_resolution_clock::now();
+  for (int i = 0; i < n; ++i) prog.eval();
+  const auto t2 = high_resolution_clock::now();
+  return get_milliseconds(t1, t2);
+}
+
+/// @brief Measures the computation of a huge power (with Karatsuba's multiplications) and its decimal conversion.
+/// @return The time in ms of the power (first) and of the conversion (second).
+pair<double, double> measure_huge_power(const uint64_t exponent, size_t* digits) {
+  const auto t1 = high_resolution_clock::now();
+  const BigInteger power = BigInteger(3).pow(exponent);
+  const auto t2 = high_resolution_clock::now();
+  *digits = power.to_string().size();
+  const auto t3 = high_resolution_clock::now();
+  return { get_milliseconds(t1, t2), get_milliseconds(t2, t3) };
+}
+
+// "1+2" produces 4 nodes: the ListNode of the program, the AddNode and two IntegerNodes.
+constexpr int nodes_of_allocation_sample = 4;
+
+/// @brief Counts the allocations made by the tree walker to execute "1+2" (the parsing is excluded).
+size_t count_tree_walker_allocations() {
+  const shared_ptr<Context> ctx = make_shared<Context>("<perf>");
+  Parser parser = Parser::initCLI("1+2");
+  auto tree = parser.parse();
+  Interpreter::set_shared_ctx(ctx);
+  const size_t before = number_of_allocations;
+  Interpreter::visit(move(tree));
+  return number_of_allocations - before;
+}
+
 string markdown_table_line(const string& name, const measurements_t& results) {
   const double kbi = results.memory / 1024;
   return "|" + name + "(CLI, total)|" + double_to_string(results.time) + " ms|" + double_to_string(results.memory) + " bytes, " + double_to_string(kbi) + " kbi|";
@@ -161,10 +701,70 @@ int main() {
   const measurements_t lexer_measurements = measure_lexer(source_code, &number_of_tokens);
   const measurements_t parser_measurements = measure_parser(source_code);
   const measurements_t interpreter_measurements = measure_interpreter(source_code);
+  const measurements_t vm_measurements = measure_vm(source_code);
+
+  constexpr int iterations = 1000;
+  const measurements_t tree_walker_executions = measure_tree_walker_executions(source_code, iterations);
+  const measurements_t vm_executions = measure_vm_executions(source_code, iterations);
+  const measurements_t register_vm_executions = measure_register_vm_executions(source_code, iterations);
+
+  const size_t tree_walker_allocations = count_tree_walker_allocations();
+
+  const double batch_rows_per_second = measure_batch_rows_per_second(1000000);
+  const double program_rows_per_second = measure_program_rows_per_second(100000);
+  const auto [unchecked_arithmetic, checked_arithmetic] = measure_checked_arithmetic(10000000);
+  const double double_powers = measure_program_evaluations("3.0 ** 39", 100000);
+  const double native_powers = measure_program_evaluations("3 ** 39", 100000);
+  const double big_powers = measure_program_evaluations("554 ** 23", 100000);
+  const auto [symbol_table_reads, interpreter_reads] = measure_string_variable_reads(10000);
+  const auto [flat_appends, rope_appends] = measure_string_appends(50000);
+  const auto [pairwise_concatenations, single_concatenations] = measure_concatenation_chains(100000);
+  const auto [interpolations, concatenation_chains, nested_concatenations] = measure_string_interpolations(100000);
+  const auto [appended_repetition, doubling_repetition] = measure_string_repetition(10000000);
+  const auto [unboxed_list_bytes, boxed_list_bytes] = measure_list_memory(1000000);
+  const auto [per_element_list_processing, kernels_list_processing] = measure_list_processing(1000000, 10);
+  const auto [copied_pages, sliced_pages] = measure_list_slicing(10000000, 100000);
+  const auto [copied_updates, persistent_updates] = measure_list_updates(1000000, 1000);
+  const auto [unordered_map_lookups, dictionary_lookups] = measure_dictionary_lookups(10000, 10000000);
+  const auto [copied_dictionary_fill, in_place_dictionary_fill] = measure_dictionary_fills(2000);
+  const auto [tree_global_accesses, table_global_accesses] = measure_global_accesses(10000, 10000000);
+  size_t huge_power_digits = 0;
+  const auto [huge_power, huge_power_conversion] = measure_huge_power(1000000, &huge_power_digits);
+
+  // After thousands of executions, the number of slabs must stay small:
+  // the values of an execution reuse the blocks freed by the previous one.
+  const pool_stats_t pool_stats = ValuePool::get_stats();
+
+  // The sample doesn't contain any jump,
+  // so the number of instructions in the bytecode is also the number of executed instructions.
+  const size_t stack_instructions = BytecodeCompiler::compile(Parser::initCLI(source_code).parse()).code.size();
+  const size_t register_instructions = RegisterCompiler::compile(Parser::initCLI(source_code).parse()).code.size();
 
   show_results("Lexer", lexer_measurements);
   show_results("Parser", parser_measurements); // sometimes the memory usage of the lexer and the parser are exactly the same, and I've no idea why
   show_results("Interpreter", interpreter_measurements);
+  show_results("VM", vm_measurements);
+  cout << "Average execution over " << iterations << " runs (parsing excluded): tree walker " << double_to_string(tree_walker_executions.time) << " ms, VM " << double_to_string(vm_executions.time) << " ms, register VM " << double_to_string(register_vm_executions.time) << " ms" << endl;
+  cout << "Instructions: " << stack_instructions << " for the VM, " << register_instructions << " for the register VM" << endl;
+  cout << "The tree walker made " << tree_walker_allocations << " allocations to execute \"1+2\" (" << double_to_string(static_cast<double>(tree_walker_allocations) / nodes_of_allocation_sample) << " per node)" << endl;
+  cout << "An IntegerValue takes " << sizeof(IntegerValue) << " bytes" << endl;
+  cout << "\"" << batch_expression << "\": " << double_to_string(batch_rows_per_second) << " rows/s in a batch, " << double_to_string(program_rows_per_second) << " rows/s row by row" << endl;
+  cout << "10M integer multiply-adds: " << double_to_string(unchecked_arithmetic) << " ms unchecked, " << double_to_string(checked_arithmetic) << " ms with overflow detection" << endl;
+  cout << "100k powers: " << double_to_string(double_powers) << " ms for 3.0**39 (double), " << double_to_string(native_powers) << " ms for 3**39 (by squaring), " << double_to_string(big_powers) << " ms for 554**23 (big integer)" << endl;
+  cout << "3**1000000: computed in " << double_to_string(huge_power) << " ms, " << huge_power_digits << " digits printed in " << double_to_string(huge_power_conversion) << " ms" << endl;
+  cout << "10k reads of a 1 MB string variable: " << double_to_string(symbol_table_reads) << " ms from the symbol table, " << double_to_string(interpreter_reads) << " ms through the interpreter" << endl;
+  cout << "50k appends to a string: " << double_to_string(flat_appends) << " ms with flat copies, " << double_to_string(rope_appends) << " ms with a rope" << endl;
+  cout << "100k concatenations of 10 values: " << double_to_string(pairwise_concatenations) << " ms pair by pair, " << double_to_string(single_concatenations) << " ms at once" << endl;
+  cout << "100k interpolated strings: " << double_to_string(interpolations) << " ms with \"$variables\", " << double_to_string(concatenation_chains) << " ms with a chain of +, " << double_to_string(nested_concatenations) << " ms with nested +" << endl;
+  cout << "\"ab\" * 10000000: " << double_to_string(appended_repetition) << " ms by appending the pattern, " << double_to_string(doubling_repetition) << " ms by doubling" << endl;
+  cout << "A list of 1M integers: " << double_to_string(unboxed_list_bytes) << " bytes per element unboxed, " << double_to_string(boxed_list_bytes) << " bytes per element with handles" << endl;
+  cout << "10 times sum(list * 2 + list) on 1M doubles: " << double_to_string(per_element_list_processing) << " ms element by element, " << double_to_string(kernels_list_processing) << " ms with the list kernels (" << (ListOperations::uses_avx2() ? "AVX2" : "scalar") << ")" << endl;
+  cout << "Paging through 10M integers by pages of 100k: " << double_to_string(copied_pages) << " ms by copying the pages, " << double_to_string(sliced_pages) << " ms with slices" << endl;
+  cout << "1000 times a[i] = a[i] + 1 on a list of 1M integers: " << double_to_string(copied_updates) << " ms by copying the list, " << double_to_string(persistent_updates) << " ms with a persistent list" << endl;
+  cout << "10M lookups in a dictionary of 10k keys: " << double_to_string(unordered_map_lookups) << " ms with std::unordered_map, " << double_to_string(dictionary_lookups) << " ms with the Swiss table" << endl;
+  cout << "Filling a dictionary with 2000 keys: " << double_to_string(copied_dictionary_fill) << " ms by copying the entries, " << double_to_string(in_place_dictionary_fill) << " ms in place" << endl;
+  cout << "10M random reads among 10k global variables: " << double_to_string(tree_global_accesses) << " ms with std::map, " << double_to_string(table_global_accesses) << " ms with the flat symbol table" << endl;
+  cout << "Value pool: " << pool_stats.live_objects << " live values, " << pool_stats.slabs << " slabs of " << ValuePool::SLAB_SIZE << " bytes, hit rate of " << double_to_string(pool_stats.hit_rate() * 100) << "%" << endl;
 
   // Writing a log file with Markdown syntax.
   // I know the way I'm writing the file is kinda terrible,
@@ -179,7 +779,7 @@ int main() {
   
   log_file << "# Performance test of the day" << endl << endl;
   log_file << "The goal of these measurements is to make sure that the time it takes to interpret the same sample does not change as I add features. Let's hope it never goes up!!" << endl << endl;
-  log_file << "Note that the memory usage is measured for macOS only, it will not work properly on another OS." << endl << endl;
+  log_file << "Note that the memory usage is measured with the physical footprint on macOS, and with the resident set size on Linux." << endl << endl;
   log_file << "Exact time of creation: " << day << "/" << month << "/" << year << " (dd/mm/YYYY) at " << hour << ":" << minute << ":" << seconds << " Europe/Paris" << endl << endl;
   log_file << "Due to how the Parser works, it's quite difficult and problematic to try and measure the Lexer, Parser and Interpreter separately. Therefore, I measure the time the Parser took in total (from the beginning, therefore including lexical analysis). The interpreter measurements also include the time it took to analyse and parse the source code." << endl << endl;
   log_file << "|Feature|Time|Memory Usage|" << endl;
@@ -187,6 +787,16 @@ int main() {
   log_file << markdown_table_line("Lexer", lexer_measurements) << endl;
   log_file << markdown_table_line("Parser", parser_measurements) << endl;
   log_file << markdown_table_line("Interpreter", interpreter_measurements) << endl;
+  log_file << markdown_table_line("VM", vm_measurements) << endl << endl;
+  log_file << "|Engine|Average execution (" << iterations << " runs, parsing excluded)|" << endl;
+  log_file << "|------|----|" << endl;
+  log_file << "|Tree walker|" << double_to_string(tree_walker_executions.time) << " ms|" << endl;
+  log_file << "|VM|" << double_to_string(vm_executions.time) << " ms|" << endl;
+  log_file << "|Register VM|" << double_to_string(register_vm_executions.time) << " ms|" << endl << endl;
+  log_file << "The VM executes " << stack_instructions << " instructions and the register VM executes " << register_instructions << " instructions." << endl << endl;
+  log_file << "The tree walker made " << tree_walker_allocations << " allocations to execute `1+2` (" << double_to_string(static_cast<double>(tree_walker_allocations) / nodes_of_allocation_sample) << " per node)." << endl << endl;
+  log_file << "An IntegerValue takes " << sizeof(IntegerValue) << " bytes." << endl << endl;
+  log_file << "The pool of values ends with " << pool_stats.live_objects << " live values in " << pool_stats.slabs << " slabs of " << ValuePool::SLAB_SIZE << " bytes, with a hit rate of " << double_to_string(pool_stats.hit_rate() * 100) << "%." << endl << endl;
   log_file << "The lexer found " << number_of_tokens << " tokens for a source code of " << source_code.length() << " characters (" << source_code.length() * sizeof(char) << " bytes)" << endl << endl;
   log_file << "# Sample" << endl << endl;
   log_file << "This test was done my reading and interpreting this piece of valid code:" << endl << endl;